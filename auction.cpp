@@ -0,0 +1,82 @@
+#include "auction.hpp"
+#include "player.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+int ListPriceBidder::maxBid(const Player&, const AuctionLot& lot) {
+    return lot.listPrice;
+}
+
+int FractionBidder::maxBid(const Player& player, const AuctionLot& lot) {
+    return std::min(lot.listPrice * percent / 100, player.getMoney() - reserve);
+}
+
+int ConsoleBidder::maxBid(const Player& player, const AuctionLot& lot) {
+    out << player.getName() << ", sealed bid for " << lot.name << " (list price $" << lot.listPrice << ", 0 to pass): ";
+    std::string line;
+    if (!std::getline(in, line)) return 0;
+    return std::atoi(line.c_str());
+}
+
+bool ConsoleBidder::raise(const Player& player, const AuctionLot& lot, int price) {
+    out << player.getName() << ", bid $" << price << " for " << lot.name << "? (y/n): ";
+    std::string line;
+    return std::getline(in, line) && !line.empty() && (line[0] == 'y' || line[0] == 'Y');
+}
+
+namespace auction {
+
+Bidder& defaultBidder() {
+    static ListPriceBidder bidder;
+    return bidder;
+}
+
+AuctionResult sealed(const AuctionEntrant* entrants, int count, const AuctionLot& lot) {
+    int opening = std::max(kAuctionIncrement, lot.reserve);
+    int best = 0;
+    int second = 0;
+    AuctionResult result;
+    for (int i = 0; i < count; ++i) {
+        int bid = std::min(entrants[i].bidder->maxBid(*entrants[i].player, lot), entrants[i].player->getMoney());
+        if (bid < opening) continue;
+        if (bid > best) {
+            second = best;
+            best = bid;
+            result.winner = i;
+        } else {
+            second = std::max(second, bid);
+        }
+    }
+    if (result.winner >= 0) {
+        result.price = second > 0 ? std::min(best, second + kAuctionIncrement) : opening;
+    }
+    return result;
+}
+
+AuctionResult ascending(const AuctionEntrant* entrants, int count, const AuctionLot& lot) {
+    count = std::min(count, 32);
+    uint32_t active = count == 32 ? ~0u : (1u << count) - 1;
+    int opening = std::max(kAuctionIncrement, lot.reserve);
+    AuctionResult result;
+    bool bidding = true;
+    while (bidding) {
+        bidding = false;
+        for (int i = 0; i < count; ++i) {
+            if (!(active & (1u << i)) || i == result.winner) continue;
+            int price = result.winner < 0 ? opening : result.price + kAuctionIncrement;
+            const AuctionEntrant& entrant = entrants[i];
+            if (price <= entrant.player->getMoney() && entrant.bidder->raise(*entrant.player, lot, price)) {
+                result.winner = i;
+                result.price = price;
+                bidding = true;
+            } else {
+                active &= ~(1u << i);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace auction
@@ -0,0 +1,106 @@
+#ifndef AUCTION_HPP
+#define AUCTION_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+class Player;
+
+// What happens to a property the player who landed on it does not buy
+enum class AuctionMode : uint8_t {
+    Off,        // It stays with the bank (the original rules)
+    Sealed,     // One sealed bid per player; the fast path for simulations
+    Ascending   // Open bidding in rounds of kAuctionIncrement; for interactive play
+};
+
+constexpr int kAuctionIncrement = 10;   // Opening bid and the step between two bids
+
+// The property up for auction
+struct AuctionLot {
+    const std::string& name;
+    int listPrice;
+    int reserve = 0;   // Lowest price the lot sells at; bids below it do not count
+};
+
+// A bidding strategy. Bids above the player's cash are never taken, so strategies need not check.
+class Bidder {
+public:
+    virtual ~Bidder() = default;
+
+    // The most this player pays for the lot; below kAuctionIncrement (or the lot's reserve) means no
+    // bid. Used by sealed auctions.
+    virtual int maxBid(const Player& player, const AuctionLot& lot) = 0;
+
+    // Whether the player bids `price` in an ascending auction. Defaults to staying in up to maxBid.
+    virtual bool raise(const Player& player, const AuctionLot& lot, int price) {
+        return price <= maxBid(player, lot);
+    }
+};
+
+// Bids up to the list price. The default for every player: it matches the engines' "buy whatever is
+// affordable" policy, and the lockstep engine plays exactly this strategy.
+class ListPriceBidder : public Bidder {
+public:
+    int maxBid(const Player& player, const AuctionLot& lot) override;
+};
+
+// Bids up to a percentage of the list price, and only while `reserve` cash is left over afterwards
+class FractionBidder : public Bidder {
+private:
+    int percent;
+    int reserve;
+
+public:
+    FractionBidder(int percent, int reserve = 0) : percent(percent), reserve(reserve) {}
+    int maxBid(const Player& player, const AuctionLot& lot) override;
+};
+
+// Never bids
+class PassBidder : public Bidder {
+public:
+    int maxBid(const Player&, const AuctionLot&) override { return 0; }
+};
+
+// Asks a person: a number for sealed bids, yes or no for each raise in ascending auctions
+class ConsoleBidder : public Bidder {
+private:
+    std::istream& in;
+    std::ostream& out;
+
+public:
+    ConsoleBidder(std::istream& in, std::ostream& out) : in(in), out(out) {}
+    int maxBid(const Player& player, const AuctionLot& lot) override;
+    bool raise(const Player& player, const AuctionLot& lot, int price) override;
+};
+
+// One player in an auction, with the strategy they bid with
+struct AuctionEntrant {
+    Player* player;
+    Bidder* bidder;
+};
+
+// Index of the winning entrant (-1: nobody bid) and the price they pay
+struct AuctionResult {
+    int winner = -1;
+    int price = 0;
+};
+
+namespace auction {
+
+// The bidder players without one of their own use (a ListPriceBidder)
+Bidder& defaultBidder();
+
+// Everyone bids once. The highest bid wins, ties going to the earlier entrant, at the second-highest
+// bid plus one increment (capped at the winning bid), or the opening bid when nobody else bid. That
+// is the price open bidding would reach when everyone bids their maxBid. The opening bid is
+// kAuctionIncrement or the lot's reserve, whichever is higher.
+AuctionResult sealed(const AuctionEntrant* entrants, int count, const AuctionLot& lot);
+
+// Entrants take turns in order: each raises by kAuctionIncrement or drops out, until one is left.
+// Bidding opens at the same price as sealed(). At most 32 entrants.
+AuctionResult ascending(const AuctionEntrant* entrants, int count, const AuctionLot& lot);
+
+} // namespace auction
+
+#endif // AUCTION_HPP
@@ -0,0 +1,58 @@
+#ifndef BANK_INVENTORY_HPP
+#define BANK_INVENTORY_HPP
+
+#include <atomic>
+
+// The houses and hotels the bank has left. Each board holds one, so every game has its own stock.
+// Taking stock is a compare-and-swap, so a build can never take the bank below zero even when
+// another thread (a server worker, a bot) is building or selling on the same game at the same time.
+// Every check is O(1).
+class BankInventory {
+private:
+    std::atomic<int> houses;
+    std::atomic<int> hotels;
+
+    static bool take(std::atomic<int>& stock, int count) {
+        int left = stock.load(std::memory_order_relaxed);
+        do {
+            if (left < count) return false;
+        } while (!stock.compare_exchange_weak(left, left - count, std::memory_order_relaxed));
+        return true;
+    }
+
+public:
+    static constexpr int kHouses = 32;
+    static constexpr int kHotels = 12;
+
+    explicit BankInventory(int houses = kHouses, int hotels = kHotels) : houses(houses), hotels(hotels) {}
+
+    int housesLeft() const { return houses.load(std::memory_order_relaxed); }
+    int hotelsLeft() const { return hotels.load(std::memory_order_relaxed); }
+
+    // Take `count` houses, all or none
+    bool takeHouses(int count) { return take(houses, count); }
+    bool takeHotel() { return take(hotels, 1); }
+
+    // Take up to `count` houses; returns how many were taken
+    int takeHousesUpTo(int count) {
+        int left = houses.load(std::memory_order_relaxed);
+        int taken;
+        do {
+            taken = left < count ? (left > 0 ? left : 0) : count;
+        } while (taken > 0 && !houses.compare_exchange_weak(left, left - taken, std::memory_order_relaxed));
+        return taken;
+    }
+
+    // Put buildings back (negative counts take them without a check, for restoring saved games)
+    void restock(int houseCount, int hotelCount) {
+        houses.fetch_add(houseCount, std::memory_order_relaxed);
+        hotels.fetch_add(hotelCount, std::memory_order_relaxed);
+    }
+
+    void reset(int houseCount = kHouses, int hotelCount = kHotels) {
+        houses.store(houseCount, std::memory_order_relaxed);
+        hotels.store(hotelCount, std::memory_order_relaxed);
+    }
+};
+
+#endif // BANK_INVENTORY_HPP
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "batchRunner.hpp"
+#include "resultStore.hpp"
+#include "ruleSweep.hpp"
+
+namespace {
+BatchRunner* activeRunner = nullptr;
+
+void onSignal(int) {
+    if (activeRunner) activeRunner->stop();
+}
+
+void printRules(const HouseRules& rules) {
+    std::cout << "start " << rules.startingMoney << " go " << rules.goSalary << " tax " << rules.taxPercent << "% jail "
+              << rules.jailFee << " rent " << rules.rentPercent << "%" << (rules.auctions ? " auctions" : "")
+              << (rules.mortgages ? " mortgages" : "");
+}
+
+// Play every house-rule configuration of the design on the same games and report its effects
+int runSweep(const BatchConfig& batch, const std::vector<SweepAxis>& axes, int randomConfigs) {
+    SweepConfig config;
+    config.firstSeed = batch.firstSeed;
+    config.games = batch.totalGames;
+    config.numPlayers = batch.numPlayers;
+    config.maxRolls = batch.maxRolls;
+    config.threads = batch.threads;
+
+    HouseRules baseline;
+    std::vector<HouseRules> design = randomConfigs > 0 ? ruleSweep::randomDesign(baseline, axes, randomConfigs, batch.firstSeed)
+                                                       : ruleSweep::gridDesign(baseline, axes);
+    SweepResult reference;
+    std::vector<SweepResult> results = ruleSweep::run(baseline, design, config, &reference);
+
+    std::cout << "baseline: ";
+    printRules(baseline);
+    std::cout << "\n  mean rolls " << reference.rolls.mean() << " (sd " << reference.rolls.stddev() << "), seat 1 wins "
+              << reference.winShare(0) << ", seat spread " << reference.seatSpread() << "\n";
+    for (const SweepResult& result : results) {
+        printRules(result.rules);
+        std::cout << "\n  mean rolls " << result.rolls.mean() << ", change " << result.rollDifference.mean() << " +/- "
+                  << result.rollDifferenceError() << " (d = " << result.effectSize << "), seat 1 wins " << result.winShare(0)
+                  << " (" << result.winShare(0) - reference.winShare(0) << "), seat spread " << result.seatSpread()
+                  << ", winner changed in " << static_cast<double>(result.winnerChanged) / std::max(1LL, config.games)
+                  << " of games\n";
+    }
+    return 0;
+}
+}
+
+// Long Monte Carlo campaigns with checkpoints. Ctrl-C (or a kill) checkpoints after the current
+// chunk; running the same command again with --checkpoint resumes where it stopped.
+// --results writes every game this run plays to a columnar result file (see resultStore.hpp). With
+// --checkpoint, each checkpoint at game N seals the file and goes on in PATH.partN, and a run resumed
+// at game N starts there too, so the parts hold every game a checkpoint counted exactly once.
+// --sweep instead plays --games games under each house-rule configuration and compares them with the
+// standard rules (see ruleSweep.hpp); repeat it per parameter, e.g. --sweep go=100:200:300 --sweep rent=50:100.
+// Configurations form a full grid, or --design N draws N of them as a Latin hypercube.
+// --endgame-after N (scalar engine) ends a two-player game at N rolls, or any N rolls later, once one
+// player wins with at least --endgame-confidence (default 0.99) by the endgame solver's estimate.
+// Usage: ./monopoly_batch [--games N] [--players N] [--max-rolls N] [--seed N] [--engine lockstep|scalar]
+//                         [--chunk N] [--threads N] [--checkpoint PATH] [--every SECONDS] [--results PATH]
+//                         [--sweep NAME=LEVEL:LEVEL...] [--design N] [--endgame-after N] [--endgame-confidence P]
+int main(int argc, char* argv[]) {
+    BatchConfig config;
+    config.totalGames = 1000000;
+    std::string resultsPath;
+    std::vector<std::string> sweeps;
+    int randomConfigs = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--games") == 0) config.totalGames = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--players") == 0) config.numPlayers = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max-rolls") == 0) config.maxRolls = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--seed") == 0) config.firstSeed = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--engine") == 0) {
+            config.engine = std::strcmp(argv[i + 1], "scalar") == 0 ? SimEngine::Scalar : SimEngine::Lockstep;
+        }
+        else if (std::strcmp(argv[i], "--chunk") == 0) config.gamesPerChunk = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--checkpoint") == 0) config.checkpointPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--every") == 0) config.checkpointSeconds = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--threads") == 0) config.threads = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--results") == 0) resultsPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--sweep") == 0) sweeps.push_back(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--design") == 0) randomConfigs = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--endgame-after") == 0) config.endgame.afterRolls = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--endgame-confidence") == 0) config.endgame.confidence = std::atof(argv[i + 1]);
+    }
+
+    try {
+        if (!sweeps.empty()) {
+            std::vector<SweepAxis> axes;
+            for (const std::string& sweep : sweeps) {
+                axes.push_back(ruleSweep::parseAxis(sweep));
+            }
+            return runSweep(config, axes, randomConfigs);
+        }
+
+        BatchRunner runner(config);
+        if (runner.resume()) {
+            std::cout << "Resuming at game " << runner.getCompleted() << " of " << config.totalGames << "\n";
+        }
+
+        // One result buffer per worker thread
+        std::unique_ptr<ResultWriter> results;
+        std::unique_ptr<ResultParts> parts;
+        std::vector<std::unique_ptr<ResultBuffer>> buffers;
+        if (!resultsPath.empty()) {
+            // A resumed run starts a part of its own; the games played before the checkpoint keep theirs
+            results = std::make_unique<ResultWriter>(resultStore::partPath(resultsPath, runner.getCompleted()), 65536,
+                                                     config.numPlayers);
+            parts = std::make_unique<ResultParts>(*results, resultsPath);
+            std::vector<GameSink*> sinks;
+            for (int w = 0; w < config.threads; ++w) {
+                buffers.push_back(results->buffer());
+                sinks.push_back(buffers.back().get());
+            }
+            runner.setSinks(sinks);
+            runner.setCheckpointObserver(parts.get());
+        }
+
+        activeRunner = &runner;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        bool done = runner.run();
+        activeRunner = nullptr;
+        if (results) {
+            for (auto& buffer : buffers) buffer->flush();
+            results->close();
+            std::cout << results->getRowCount() << " game results written to " << resultsPath
+                      << (config.checkpointPath.empty() ? "" : " and its parts") << "\n";
+        }
+
+        const SimStats& stats = runner.getStats();
+        std::cout << (done ? "Finished " : "Stopped after ") << runner.getCompleted() << " of " << config.totalGames << " games\n"
+                  << "mean rolls " << stats.meanRolls() << ", finished "
+                  << (stats.games > 0 ? static_cast<double>(stats.finishedGames) / stats.games : 0.0)
+                  << ", jail landings " << stats.landingFrequency(10) << "\n";
+        for (int seat = 0; seat < config.numPlayers; ++seat) {
+            std::cout << "seat " << seat + 1 << " wins " << stats.wins[seat] << "\n";
+        }
+        if (!done && !config.checkpointPath.empty()) {
+            std::cout << "Progress saved to " << config.checkpointPath << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "monopoly_batch: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
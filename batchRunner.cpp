@@ -0,0 +1,206 @@
+#include "batchRunner.hpp"
+#include "board.hpp"
+#include "gameSave.hpp"
+#include "lockstepSim.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x42504E4D;  // "MNPB"
+
+uint32_t millionths(double chance) {
+    return static_cast<uint32_t>(std::lround(std::min(std::max(chance, 0.0), 1.0) * 1e6));
+}
+
+void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes = 8) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+// Bounds-checked reads over a checkpoint
+struct Reader {
+    const std::vector<uint8_t>& data;
+    size_t offset = 0;
+
+    uint64_t get(int bytes) {
+        if (data.size() - offset < static_cast<size_t>(bytes)) throw std::runtime_error("batch checkpoint: truncated");
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+        offset += bytes;
+        return value;
+    }
+    long long i64() { return static_cast<long long>(get(8)); }
+};
+
+} // namespace
+
+BatchRunner::BatchRunner(const BatchConfig& config) : config(config) {
+    if (config.numPlayers < 2 || config.numPlayers > kMaxSimPlayers || config.gamesPerChunk < 1 || config.threads < 1) {
+        throw std::invalid_argument("batch: players must be 2-" + std::to_string(kMaxSimPlayers) +
+                                    ", chunks at least one game and threads at least one");
+    }
+    if (config.endgame.afterRolls < 0 || (config.endgame.afterRolls > 0 && config.engine != SimEngine::Scalar)) {
+        throw std::invalid_argument("batch: the endgame cutoff needs the scalar engine and a positive roll count");
+    }
+}
+
+void BatchRunner::setSinks(const std::vector<GameSink*>& perWorker) {
+    if (!perWorker.empty() && static_cast<int>(perWorker.size()) != config.threads) {
+        throw std::invalid_argument("batch: need one sink per worker thread");
+    }
+    sinks = perWorker;
+}
+
+// Workers take consecutive slices of the chunk; the totals are sums, so they do not depend on the split
+void BatchRunner::playChunk(long long games) {
+    uint32_t seed = config.firstSeed + static_cast<uint32_t>(completed);
+    std::vector<SimStats> perWorker(config.threads);
+    auto work = [&](int w) {
+        long long begin = games * w / config.threads;
+        long long end = games * (w + 1) / config.threads;
+        if (begin == end) return;
+        GameSink* sink = sinks.empty() ? nullptr : sinks[w];
+        uint32_t first = seed + static_cast<uint32_t>(begin);
+        if (config.engine == SimEngine::Lockstep) {
+            auto board = Board::create();
+            LockstepSimulator simulator(*board, config.numPlayers, config.maxRolls);
+            perWorker[w] = simulator.run(first, static_cast<int>(end - begin), sink);
+        } else {
+            perWorker[w] = runScalarGames(first, static_cast<int>(end - begin), config.numPlayers, config.maxRolls, &tiles, sink,
+                                          &config.endgame);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < config.threads; ++w) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const SimStats& part : perWorker) {
+        stats.merge(part);
+    }
+    completed += games;
+}
+
+bool BatchRunner::run(long long maxGames) {
+    using Clock = std::chrono::steady_clock;
+    auto lastCheckpoint = Clock::now();
+    long long played = 0;
+    stopping.store(false, std::memory_order_relaxed);
+
+    while (completed < config.totalGames && (maxGames < 0 || played < maxGames) &&
+           !stopping.load(std::memory_order_relaxed)) {
+        long long games = std::min<long long>(config.gamesPerChunk, config.totalGames - completed);
+        if (maxGames >= 0) games = std::min(games, maxGames - played);
+        playChunk(games);
+        played += games;
+
+        if (!config.checkpointPath.empty() &&
+            std::chrono::duration<double>(Clock::now() - lastCheckpoint).count() >= config.checkpointSeconds) {
+            checkpoint();
+            lastCheckpoint = Clock::now();
+        }
+    }
+    if (!config.checkpointPath.empty()) {
+        checkpoint();
+    }
+    return completed >= config.totalGames;
+}
+
+void BatchRunner::checkpoint() const {
+    if (observer) observer->beforeCheckpoint(completed);
+    std::vector<uint8_t> out;
+    putLE(out, kMagic, 4);
+    putLE(out, kVersion, 2);
+    putLE(out, static_cast<uint8_t>(config.engine), 1);
+    putLE(out, static_cast<uint64_t>(config.numPlayers), 1);
+    putLE(out, static_cast<uint64_t>(config.maxRolls), 4);
+    putLE(out, config.firstSeed, 4);
+    putLE(out, static_cast<uint64_t>(config.totalGames));
+    putLE(out, static_cast<uint64_t>(config.endgame.afterRolls), 4);
+    putLE(out, millionths(config.endgame.confidence), 4);
+    putLE(out, static_cast<uint64_t>(completed));
+    putLE(out, config.firstSeed + static_cast<uint32_t>(completed), 4);
+    putLE(out, kMaxSimPlayers, 4);
+
+    putLE(out, static_cast<uint64_t>(stats.games));
+    putLE(out, static_cast<uint64_t>(stats.finishedGames));
+    putLE(out, static_cast<uint64_t>(stats.totalRolls));
+    for (long long wins : stats.wins) putLE(out, static_cast<uint64_t>(wins));
+    for (long long landings : stats.landings) putLE(out, static_cast<uint64_t>(landings));
+
+    TileCounts counts = tiles.snapshot();
+    for (int t = 0; t < kBoardTiles; ++t) {
+        putLE(out, static_cast<uint64_t>(counts.landings[t]));
+        putLE(out, static_cast<uint64_t>(counts.purchases[t]));
+        putLE(out, static_cast<uint64_t>(counts.rentCollected[t]));
+        putLE(out, static_cast<uint64_t>(counts.cardDraws[t]));
+    }
+    gameSave::writeFile(out, config.checkpointPath);
+}
+
+bool BatchRunner::resume() {
+    if (config.checkpointPath.empty()) return false;
+    std::ifstream file(config.checkpointPath, std::ios::binary);
+    if (!file) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader in{data};
+    if (in.get(4) != kMagic) throw std::runtime_error("batch checkpoint: not a batch checkpoint");
+    uint64_t version = in.get(2);
+    if (version < kOldestVersion || version > kVersion) throw std::runtime_error("batch checkpoint: unsupported version " + std::to_string(version));
+    bool sameCampaign = in.get(1) == static_cast<uint8_t>(config.engine);
+    sameCampaign = in.get(1) == static_cast<uint64_t>(config.numPlayers) && sameCampaign;
+    sameCampaign = in.get(4) == static_cast<uint64_t>(config.maxRolls) && sameCampaign;
+    sameCampaign = in.get(4) == config.firstSeed && sameCampaign;
+    sameCampaign = in.i64() == config.totalGames && sameCampaign;
+    if (version >= 2) {
+        sameCampaign = in.get(4) == static_cast<uint64_t>(config.endgame.afterRolls) && sameCampaign;
+        bool cutoff = config.endgame.afterRolls > 0;
+        sameCampaign = (in.get(4) == millionths(config.endgame.confidence) || !cutoff) && sameCampaign;
+    } else {
+        sameCampaign = config.endgame.afterRolls == 0 && sameCampaign;
+    }
+    if (!sameCampaign) throw std::runtime_error("batch checkpoint: written by a different campaign");
+
+    long long savedCompleted = in.i64();
+    uint32_t nextSeed = static_cast<uint32_t>(in.get(4));
+    if (savedCompleted < 0 || savedCompleted > config.totalGames ||
+        nextSeed != config.firstSeed + static_cast<uint32_t>(savedCompleted)) {
+        throw std::runtime_error("batch checkpoint: inconsistent progress");
+    }
+    // Checkpoints from builds with fewer seats still load
+    uint64_t seatSlots = in.get(4);
+    if (seatSlots > static_cast<uint64_t>(kMaxSimPlayers)) throw std::runtime_error("batch checkpoint: too many seats");
+
+    SimStats saved;
+    saved.games = in.i64();
+    saved.finishedGames = in.i64();
+    saved.totalRolls = in.i64();
+    for (uint64_t seat = 0; seat < seatSlots; ++seat) saved.wins[seat] = in.i64();
+    for (long long& landings : saved.landings) landings = in.i64();
+
+    TileCounts counts;
+    for (int t = 0; t < kBoardTiles; ++t) {
+        counts.landings[t] = in.i64();
+        counts.purchases[t] = in.i64();
+        counts.rentCollected[t] = in.i64();
+        counts.cardDraws[t] = in.i64();
+    }
+    if (in.offset != data.size()) throw std::runtime_error("batch checkpoint: trailing data");
+
+    completed = savedCompleted;
+    stats = saved;
+    tiles.reset();
+    tiles.add(counts);
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "endgame.hpp"
+#include "simulation.hpp"
+#include "tileStats.hpp"
+
+enum class SimEngine : uint8_t { Scalar, Lockstep };
+
+// A Monte Carlo campaign: games [firstSeed, firstSeed + totalGames)
+struct BatchConfig {
+    SimEngine engine = SimEngine::Lockstep;
+    int numPlayers = 2;
+    int maxRolls = 1000;
+    uint32_t firstSeed = 1;
+    long long totalGames = 0;
+    int gamesPerChunk = 1024;          // Games played between checkpoint checks
+    int threads = 1;                   // Worker threads sharing each chunk
+    std::string checkpointPath;        // No checkpoints when empty
+    double checkpointSeconds = 30.0;   // Minimum time between two checkpoints
+    EndgameCutoff endgame;             // Two-player games may end early once decided; scalar engine only
+};
+
+// Told before each checkpoint is written, once every game it counts has been played and passed to
+// the sinks, so anything those games produced can be made durable first
+class CheckpointObserver {
+public:
+    virtual ~CheckpointObserver() = default;
+    virtual void beforeCheckpoint(long long completed) = 0;
+};
+
+// Plays a campaign in chunks and checkpoints its progress, so a killed run can resume where it
+// stopped. Each game is seeded by its index, so the stream position of every game is known from
+// the count of completed games, and the final statistics match an uninterrupted run exactly.
+//
+// Checkpoint format (little-endian, written through a temporary file and a rename):
+//   u32 magic "MNPB" | u16 version | u8 engine | u8 numPlayers | u32 maxRolls | u32 firstSeed
+//   u64 totalGames | u32 endgame afterRolls | u32 endgame confidence in millionths (version 2 on)
+//   u64 completed | u32 next seed | u32 seat count (kMaxSimPlayers; fewer from older builds)
+//   i64 games | i64 finishedGames | i64 totalRolls | seat count x i64 wins | kBoardTiles x i64 landings
+//   kBoardTiles x (i64 landings | i64 purchases | i64 rentCollected | i64 cardDraws)  tile counters, scalar engine
+class BatchRunner {
+private:
+    BatchConfig config;
+    SimStats stats;
+    TileHeatmap tiles;               // Scalar engine only; the lockstep engine keeps landings in `stats`
+    long long completed = 0;
+    std::vector<GameSink*> sinks;    // One per worker, or none
+    CheckpointObserver* observer = nullptr;
+    std::atomic<bool> stopping{false};
+
+    void playChunk(long long games);
+
+public:
+    static constexpr uint16_t kVersion = 2;
+    static constexpr uint16_t kOldestVersion = 1;   // Version 1 has no endgame cutoff
+
+    explicit BatchRunner(const BatchConfig& config);
+
+    // Pick up from the checkpoint file if there is one; false if there is none. Throws
+    // std::runtime_error if it is unreadable or belongs to a different campaign.
+    bool resume();
+
+    // Play until the campaign is done, stop() is called, or `maxGames` more games were played
+    // (negative: no limit). Checkpoints periodically and on return. True once every game is done.
+    bool run(long long maxGames = -1);
+
+    // Pass every game's summary on: worker w feeds perWorker[w] only, so sinks need no locking.
+    // Needs one sink per thread. Sinks see the games played by this process, not those before a resume.
+    void setSinks(const std::vector<GameSink*>& perWorker);
+
+    // Call `observer` (or nobody, for nullptr) before every checkpoint
+    void setCheckpointObserver(CheckpointObserver* observer) { this->observer = observer; }
+
+    // Write the checkpoint now
+    void checkpoint() const;
+
+    // Ask run() to return after the current chunk; safe from a signal handler
+    void stop() { stopping.store(true, std::memory_order_relaxed); }
+
+    const SimStats& getStats() const { return stats; }
+    TileCounts getTileCounts() const { return tiles.snapshot(); }
+    long long getCompleted() const { return completed; }
+    const BatchConfig& getConfig() const { return config; }
+};
+
+#endif // BATCH_RUNNER_HPP
@@ -0,0 +1,212 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "benchmark.hpp"
+#include "board.hpp"
+#include "cards.hpp"
+#include "cashRaising.hpp"
+#include "dice.hpp"
+#include "endgame.hpp"
+#include "game.hpp"
+#include "gameSave.hpp"
+#include "gameState.hpp"
+#include "lockstepSim.hpp"
+#include "player.hpp"
+#include "propertyRoi.hpp"
+#include "simulation.hpp"
+#include "trade.hpp"
+
+// Microbenchmarks for the engine hot paths.
+// Usage: ./monopoly_bench [--reps N] [--warmup N] [--filter TEXT] [--json FILE] [--label TEXT]
+int main(int argc, char* argv[]) {
+    int repetitions = 15;
+    int warmup = 3;
+    std::string filter;
+    std::string jsonPath;
+    std::string label = "local";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--reps") == 0) repetitions = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--warmup") == 0) warmup = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--filter") == 0) filter = argv[i + 1];
+        else if (std::strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--label") == 0) label = argv[i + 1];
+    }
+
+    BenchmarkRunner runner(warmup, repetitions, filter);
+    {
+        QuietOutput quiet;  // Game narration would dominate the timings
+
+        Dice dice(1);
+        runner.run("Dice::roll", 1000000, [&](long long) {
+            auto roll = dice.roll();
+            doNotOptimize(roll);
+        });
+
+        // One street per build level: 0-4 houses and a hotel
+        std::vector<std::shared_ptr<StreetTile>> streets;
+        for (int level = 0; level <= 5; ++level) {
+            auto street = std::make_shared<StreetTile>("Street", "Blue", 400, 50);
+            for (int h = 0; h < level && h < 4; ++h) street->buildHouse({street.get()});
+            if (level == 5) street->buildHotel({street.get()});
+            streets.push_back(street);
+        }
+        runner.run("StreetTile::calculateRent", 1000000, [&](long long i) {
+            int rent = streets[i % streets.size()]->calculateRent();
+            doNotOptimize(rent);
+        });
+
+        auto board = Board::create();
+        const std::string groups[] = {"Brown", "Light Blue", "Pink", "Orange", "Red", "Yellow", "Green", "Blue"};
+        runner.run("Board::getColorGroupProperties", 100000, [&](long long i) {
+            auto group = board->getColorGroupProperties(groups[i % 8]);
+            doNotOptimize(group.size());
+        });
+
+        const std::string names[] = {"Mediterranean Ave", "Illinois Ave", "Boardwalk", "Not A Street"};
+        runner.run("Board::findPropertyByName", 100000, [&](long long i) {
+            auto tile = board->findPropertyByName(names[i % 4]);
+            doNotOptimize(tile.get());
+        });
+
+        std::vector<std::shared_ptr<Tile>> forSale;
+        for (int t = 0; t < board->getTileCount(); ++t) {
+            auto tile = board->getTile(t);
+            if (tile->getTileType() != "Special") forSale.push_back(tile);
+        }
+        std::shared_ptr<Player> buyer;
+        runner.run("Player::buyProperty", 10000,
+            [&](long long i) { buyer->buyProperty(forSale[i % forSale.size()]); },
+            [&] { buyer = std::make_shared<Player>("Buyer", 1 << 30); });
+
+        // Cards run against a game on its own board; the player owns a built-up colour group
+        auto cardPlayer = std::make_shared<Player>("Card Player", 1 << 30);
+        auto opponent = std::make_shared<Player>("Opponent", 1 << 30);
+        Game game({cardPlayer, opponent}, Board::create());
+        auto orange = game.getBoard().getColorGroupProperties("Orange");
+        for (StreetTile* street : orange) {
+            cardPlayer->buyProperty(game.getBoard().findPropertyByName(street->getName()));
+        }
+        for (int h = 0; h < 3; ++h) {
+            for (StreetTile* street : orange) street->buildHouse(orange);
+        }
+
+        GeneralRepairsCard repairs;
+        runner.run("card:GeneralRepairs", 100000, [&](long long) { repairs.execute(cardPlayer, game); });
+
+        AdvanceToGoCard advanceToGo;
+        runner.run("card:AdvanceToGo", 100000, [&](long long) { advanceToGo.execute(cardPlayer, game); });
+
+        AdvanceToNearestRailroadCard nearestRailroad;
+        runner.run("card:AdvanceToNearestRailroad", 100000, [&](long long) {
+            cardPlayer->setPosition(22);
+            nearestRailroad.execute(cardPlayer, game);
+        });
+
+        AdvanceToNearestUtilityCard nearestUtility;
+        runner.run("card:AdvanceToNearestUtility", 100000, [&](long long) {
+            cardPlayer->setPosition(36);
+            nearestUtility.execute(cardPlayer, game);
+        });
+
+        // One house up and back down on the built-up group: the bank's stock is checked both ways
+        runner.run("Game::buildHouse + sellBuilding", 100000, [&](long long) {
+            game.buildHouse(*orange[0]);
+            cardPlayer->adjustMoney(orange[0]->sellBuilding(orange));
+        });
+
+        // Saving and restoring a four-player game 300 turns in
+        std::vector<std::shared_ptr<Player>> savedSeats;
+        for (int i = 0; i < 4; ++i) savedSeats.push_back(std::make_shared<Player>("Seat " + std::to_string(i + 1)));
+        Game savedGame(savedSeats, Board::create());
+        savedGame.seed(3);
+        for (int turn = 0; turn < 300 && savedGame.getPlayers().size() > 1; ++turn) savedGame.playTurn();
+        std::vector<uint8_t> saved;
+        runner.run("gameSave::save", 100000, [&](long long) {
+            saved.clear();
+            gameSave::save(savedGame, saved);
+            doNotOptimize(saved.data());
+        });
+        runner.run("gameSave::load", 2000, [&](long long) {
+            auto loaded = gameSave::load(saved.data(), saved.size());
+            doNotOptimize(loaded.get());
+        });
+
+        // Trade search on the same mid-game position
+        LandingModel landingModel(savedGame.getBoard(), savedGame.getChanceDeck(), savedGame.getCommunityChestDeck());
+        TradeEvaluator evaluator(landingModel);
+        evaluator.load(savedGame);
+        TradeOffer swap;
+        swap.fromSeat = 0;
+        swap.toSeat = 1;
+        runner.run("TradeEvaluator::score", 1000000, [&](long long i) {
+            swap.takeTiles = 1ULL << (i % kBoardTiles);
+            doNotOptimize(evaluator.score(swap).incomeChange[0]);
+        });
+        runner.run("TradeEvaluator::bestOffer", 10000, [&](long long) {
+            doNotOptimize(evaluator.bestOffer(0, 1, 50).takeTiles);
+        });
+
+        // Street payback table: built once per board, then looked up from the build phase
+        runner.run("PropertyRoi build", 20000, [&](long long) {
+            PropertyRoi roi(savedGame.getBoard(), landingModel);
+            doNotOptimize(roi.at(39, 5).breakEven);
+        });
+        const PropertyRoi& roi = savedGame.getPropertyRoi();
+        runner.run("PropertyRoi::nextBuildRounds", 1000000, [&](long long i) {
+            doNotOptimize(roi.nextBuildRounds(static_cast<int>(i % kBoardTiles), static_cast<int>(i % 5), 3));
+        });
+
+        // Two-player endgame from the same position, with the batch cutoff's options
+        GameState endgameState = GameState::capture(savedGame);
+        for (int seat = 2; seat < endgameState.seatCount; ++seat) endgameState.seats[seat].flags |= SeatState::Bankrupt;
+        EndgameSolver endgameSolver(savedGame.getBoard(), EndgameCutoff().options);
+        runner.run("EndgameSolver::solveModel", 20, [&](long long) {
+            doNotOptimize(endgameSolver.solveModel(endgameState).win[0]);
+        });
+        runner.run("EndgameSolver::rollOut", 20, [&](long long) {
+            doNotOptimize(endgameSolver.rollOut(endgameState).win[0]);
+        });
+
+        // Mortgage planning over every property of the board, for a large and a small debt
+        int mortgageValues[kBoardTiles];
+        int mortgageRents[kBoardTiles];
+        int mortgageCount = 0;
+        for (int t = 0; t < kBoardTiles; ++t) {
+            auto tile = savedGame.getTile(t);
+            int price = Player::purchasePrice(tile);
+            if (price == 0) continue;
+            mortgageValues[mortgageCount] = price / 2;
+            mortgageRents[mortgageCount] = price / 10;
+            mortgageCount++;
+        }
+        runner.run("cheapestMortgages:$1000", 10000, [&](long long i) {
+            doNotOptimize(cheapestMortgages(mortgageValues, mortgageRents, mortgageCount, 1000 + static_cast<int>(i % 5)));
+        });
+        runner.run("cheapestMortgages:$150", 100000, [&](long long i) {
+            doNotOptimize(cheapestMortgages(mortgageValues, mortgageRents, mortgageCount, 150 + static_cast<int>(i % 5)));
+        });
+
+        // Full games, two players, capped at 1000 rolls
+        runner.run("fullGame:scalar (per game)", 20, [&](long long i) {
+            GameSummary summary = runScalarGame(static_cast<uint32_t>(i + 1), 2, 1000);
+            doNotOptimize(summary.rolls);
+        });
+
+        auto simBoard = Board::create();
+        LockstepSimulator simulator(*simBoard, 2, 1000);
+        runner.run("fullGame:lockstep (per 64 games)", 5, [&](long long i) {
+            SimStats stats = simulator.run(static_cast<uint32_t>(i * 64 + 1), 64);
+            doNotOptimize(stats.totalRolls);
+        });
+    }
+
+    runner.writeTable(std::cout);
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        runner.writeJson(json, label);
+        std::cout << "Results written to " << jsonPath << "\n";
+    }
+    return 0;
+}
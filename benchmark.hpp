@@ -0,0 +1,133 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Keeps the compiler from optimising away a value computed inside a benchmark
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Timing statistics of one benchmark, in nanoseconds per operation
+struct BenchmarkResult {
+    std::string name;
+    long long iterations = 0;   // Operations per repetition
+    int repetitions = 0;        // Timed repetitions (warmup excluded)
+    double minNs = 0;
+    double medianNs = 0;
+    double meanNs = 0;
+    double maxNs = 0;
+};
+
+// Runs each benchmark as warmup repetitions followed by timed repetitions of a fixed number of
+// operations, and reports per-operation statistics over the timed repetitions
+class BenchmarkRunner {
+private:
+    int warmupRepetitions;
+    int repetitions;
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+
+    // Nearest-rank percentile of sorted samples
+    static double percentile(const std::vector<double>& sorted, double fraction) {
+        size_t rank = static_cast<size_t>(fraction * sorted.size() + 0.999999);
+        rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+        return sorted[rank - 1];
+    }
+
+    // A string as the contents of a JSON string literal
+    static std::string jsonEscape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                escaped += "\\u00";
+                escaped += hex[(c >> 4) & 0xf];
+                escaped += hex[c & 0xf];
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+public:
+    BenchmarkRunner(int warmupRepetitions, int repetitions, const std::string& filter = "")
+        : warmupRepetitions(warmupRepetitions), repetitions(std::max(repetitions, 1)), filter(filter) {}
+
+    // Time `body(i)` over `iterations` calls per repetition
+    template <typename Body>
+    void run(const std::string& name, long long iterations, Body body) {
+        run(name, iterations, body, [] {});
+    }
+
+    // Same, with `setup` run untimed before each repetition
+    template <typename Body, typename Setup>
+    void run(const std::string& name, long long iterations, Body body, Setup setup) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+        std::vector<double> samples;
+        for (int rep = 0; rep < warmupRepetitions + repetitions; ++rep) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            for (long long i = 0; i < iterations; ++i) {
+                body(i);
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (rep >= warmupRepetitions) {
+                samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / iterations);
+            }
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.repetitions = repetitions;
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        result.medianNs = percentile(samples, 0.5);
+        for (double sample : samples) {
+            result.meanNs += sample / samples.size();
+        }
+        results.push_back(result);
+    }
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+    // Aligned table for people
+    void writeTable(std::ostream& out) const {
+        out << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "median_ns"
+            << std::setw(14) << "max_ns" << std::setw(14) << "min_ns" << "\n";
+        for (const auto& result : results) {
+            out << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << result.medianNs << std::setw(14) << result.maxNs << std::setw(14) << result.minNs << "\n";
+        }
+        out << std::defaultfloat;
+    }
+
+    // JSON for tracking across releases (schema version 2; version 1 also had a p99, which was the max)
+    void writeJson(std::ostream& out, const std::string& label) const {
+        out << "{\n  \"schema\": 2,\n  \"label\": \"" << jsonEscape(label) << "\",\n  \"unit\": \"ns/op\",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            out << "    {\"name\": \"" << jsonEscape(result.name) << "\", \"iterations\": " << result.iterations
+                << ", \"repetitions\": " << result.repetitions << ", \"min\": " << result.minNs
+                << ", \"median\": " << result.medianNs << ", \"mean\": " << result.meanNs
+                << ", \"max\": " << result.maxNs << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+};
+
+#endif // BENCHMARK_HPP
@@ -6,52 +6,88 @@
 
 Board::Board() {
     // Initialize all 40 tiles on the board
-    addTile(std::make_shared<StartTile>("Go"), {750, 741});                      // 0
-    addTile(std::make_shared<StreetTile>("Mediterranean Ave", "Brown", 60, 2), {655, 741});  // 1
-    addTile(std::make_shared<CommunityChestTile>("Community Chest"), {600, 741}); // 2
-    addTile(std::make_shared<StreetTile>("Baltic Ave", "Brown", 60, 4), {540, 741});    // 3
-    addTile(std::make_shared<TaxTile>("Income Tax"), {475, 741});                // 4
-    addTile(std::make_shared<RailroadTile>("Reading Railroad"), {405, 741});     // 5
-    addTile(std::make_shared<StreetTile>("Oriental Ave", "Light Blue", 100, 6), {330, 741}); // 6
-    addTile(std::make_shared<ChanceTile>("Chance"), {250, 741});                 // 7
-    addTile(std::make_shared<StreetTile>("Vermont Ave", "Light Blue", 100, 6), {200, 741}); // 8
-    addTile(std::make_shared<StreetTile>("Connecticut Ave", "Light Blue", 120, 8), {140, 741}); // 9
+    placeTile(std::make_shared<StartTile>("Go"), {750, 741});                      // 0
+    placeTile(std::make_shared<StreetTile>("Mediterranean Ave", "Brown", 60, 2), {655, 741});  // 1
+    placeTile(std::make_shared<CommunityChestTile>("Community Chest"), {600, 741}); // 2
+    placeTile(std::make_shared<StreetTile>("Baltic Ave", "Brown", 60, 4), {540, 741});    // 3
+    placeTile(std::make_shared<TaxTile>("Income Tax"), {475, 741});                // 4
+    placeTile(std::make_shared<RailroadTile>("Reading Railroad"), {405, 741});     // 5
+    placeTile(std::make_shared<StreetTile>("Oriental Ave", "Light Blue", 100, 6), {330, 741}); // 6
+    placeTile(std::make_shared<ChanceTile>("Chance"), {250, 741});                 // 7
+    placeTile(std::make_shared<StreetTile>("Vermont Ave", "Light Blue", 100, 6), {200, 741}); // 8
+    placeTile(std::make_shared<StreetTile>("Connecticut Ave", "Light Blue", 120, 8), {140, 741}); // 9
 
     // Left column (bottom to top)
-    addTile(std::make_shared<JailTile>("Jail"), {50, 741});                      // 10
-    addTile(std::make_shared<StreetTile>("St. Charles Place", "Pink", 140, 10), {50, 655}); // 11
-    addTile(std::make_shared<UtilityTile>("Electric Company"), {50, 600});       // 12
-    addTile(std::make_shared<StreetTile>("States Ave", "Pink", 140, 10), {50, 540}); // 13
-    addTile(std::make_shared<StreetTile>("Virginia Ave", "Pink", 160, 12), {50, 475}); // 14
-    addTile(std::make_shared<RailroadTile>("Pennsylvania Railroad"), {50, 405}); // 15
-    addTile(std::make_shared<StreetTile>("St. James Place", "Orange", 180, 14), {50, 330}); // 16
-    addTile(std::make_shared<CommunityChestTile>("Community Chest"), {50, 250}); // 17
-    addTile(std::make_shared<StreetTile>("Tennessee Ave", "Orange", 180, 14), {50, 200}); // 18
-    addTile(std::make_shared<StreetTile>("New York Ave", "Orange", 200, 16), {50, 140}); // 19
+    placeTile(std::make_shared<JailTile>("Jail"), {50, 741});                      // 10
+    placeTile(std::make_shared<StreetTile>("St. Charles Place", "Pink", 140, 10), {50, 655}); // 11
+    placeTile(std::make_shared<UtilityTile>("Electric Company"), {50, 600});       // 12
+    placeTile(std::make_shared<StreetTile>("States Ave", "Pink", 140, 10), {50, 540}); // 13
+    placeTile(std::make_shared<StreetTile>("Virginia Ave", "Pink", 160, 12), {50, 475}); // 14
+    placeTile(std::make_shared<RailroadTile>("Pennsylvania Railroad"), {50, 405}); // 15
+    placeTile(std::make_shared<StreetTile>("St. James Place", "Orange", 180, 14), {50, 330}); // 16
+    placeTile(std::make_shared<CommunityChestTile>("Community Chest"), {50, 250}); // 17
+    placeTile(std::make_shared<StreetTile>("Tennessee Ave", "Orange", 180, 14), {50, 200}); // 18
+    placeTile(std::make_shared<StreetTile>("New York Ave", "Orange", 200, 16), {50, 140}); // 19
 
     // Top row (left to right)
-    addTile(std::make_shared<FreeParkingTile>("Free Parking"), {50, 50});        // 20
-    addTile(std::make_shared<StreetTile>("Kentucky Ave", "Red", 220, 18), {140, 50}); // 21
-    addTile(std::make_shared<ChanceTile>("Chance"), {200, 50});                  // 22
-    addTile(std::make_shared<StreetTile>("Indiana Ave", "Red", 220, 18), {250, 50}); // 23
-    addTile(std::make_shared<StreetTile>("Illinois Ave", "Red", 240, 20), {330, 50}); // 24
-    addTile(std::make_shared<RailroadTile>("B&O Railroad"), {405, 50});          // 25
-    addTile(std::make_shared<StreetTile>("Atlantic Ave", "Yellow", 260, 22), {475, 50}); // 26
-    addTile(std::make_shared<StreetTile>("Ventnor Ave", "Yellow", 260, 22), {540, 50}); // 27
-    addTile(std::make_shared<UtilityTile>("Water Works"), {600, 50});            // 28
-    addTile(std::make_shared<StreetTile>("Marvin Gardens", "Yellow", 280, 24), {655, 50}); // 29
+    placeTile(std::make_shared<FreeParkingTile>("Free Parking"), {50, 50});        // 20
+    placeTile(std::make_shared<StreetTile>("Kentucky Ave", "Red", 220, 18), {140, 50}); // 21
+    placeTile(std::make_shared<ChanceTile>("Chance"), {200, 50});                  // 22
+    placeTile(std::make_shared<StreetTile>("Indiana Ave", "Red", 220, 18), {250, 50}); // 23
+    placeTile(std::make_shared<StreetTile>("Illinois Ave", "Red", 240, 20), {330, 50}); // 24
+    placeTile(std::make_shared<RailroadTile>("B&O Railroad"), {405, 50});          // 25
+    placeTile(std::make_shared<StreetTile>("Atlantic Ave", "Yellow", 260, 22), {475, 50}); // 26
+    placeTile(std::make_shared<StreetTile>("Ventnor Ave", "Yellow", 260, 22), {540, 50}); // 27
+    placeTile(std::make_shared<UtilityTile>("Water Works"), {600, 50});            // 28
+    placeTile(std::make_shared<StreetTile>("Marvin Gardens", "Yellow", 280, 24), {655, 50}); // 29
 
     // Right column (top to bottom)
-    addTile(std::make_shared<GoToJailTile>("Go to Jail"), {750, 50});            // 30
-    addTile(std::make_shared<StreetTile>("Pacific Ave", "Green", 300, 26), {750, 140}); // 31
-    addTile(std::make_shared<StreetTile>("North Carolina Ave", "Green", 300, 26), {750, 200}); // 32
-    addTile(std::make_shared<CommunityChestTile>("Community Chest"), {750, 250}); // 33
-    addTile(std::make_shared<StreetTile>("Pennsylvania Ave", "Green", 320, 28), {750, 330}); // 34
-    addTile(std::make_shared<RailroadTile>("Short Line"), {750, 405});           // 35
-    addTile(std::make_shared<ChanceTile>("Chance"), {750, 475});                 // 36
-    addTile(std::make_shared<StreetTile>("Park Place", "Blue", 350, 35), {750, 540}); // 37
-    addTile(std::make_shared<TaxTile>("Luxury Tax"), {750, 600});                // 38
-    addTile(std::make_shared<StreetTile>("Boardwalk", "Blue", 400, 50), {750, 655}); // 39
+    placeTile(std::make_shared<GoToJailTile>("Go to Jail"), {750, 50});            // 30
+    placeTile(std::make_shared<StreetTile>("Pacific Ave", "Green", 300, 26), {750, 140}); // 31
+    placeTile(std::make_shared<StreetTile>("North Carolina Ave", "Green", 300, 26), {750, 200}); // 32
+    placeTile(std::make_shared<CommunityChestTile>("Community Chest"), {750, 250}); // 33
+    placeTile(std::make_shared<StreetTile>("Pennsylvania Ave", "Green", 320, 28), {750, 330}); // 34
+    placeTile(std::make_shared<RailroadTile>("Short Line"), {750, 405});           // 35
+    placeTile(std::make_shared<ChanceTile>("Chance"), {750, 475});                 // 36
+    placeTile(std::make_shared<StreetTile>("Park Place", "Blue", 350, 35), {750, 540}); // 37
+    placeTile(std::make_shared<TaxTile>("Luxury Tax"), {750, 600});                // 38
+    placeTile(std::make_shared<StreetTile>("Boardwalk", "Blue", 400, 50), {750, 655}); // 39
+
+    buildLookupTables();
+}
+
+void Board::buildLookupTables() {
+    int tileCount = getTileCount();
+    tileKinds.assign(tileCount, TileKind::Other);
+    for (int t = 0; t < tileCount; ++t) {
+        const auto& tile = tiles[t];
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(tile)) {
+            tileKinds[t] = TileKind::Street;
+            street->setBank(&bank);  // Streets build from this board's bank
+        } else if (std::dynamic_pointer_cast<RailroadTile>(tile)) tileKinds[t] = TileKind::Railroad;
+        else if (std::dynamic_pointer_cast<UtilityTile>(tile)) tileKinds[t] = TileKind::Utility;
+        else if (std::dynamic_pointer_cast<TaxTile>(tile)) tileKinds[t] = TileKind::Tax;
+        else if (std::dynamic_pointer_cast<ChanceTile>(tile)) tileKinds[t] = TileKind::Chance;
+        else if (std::dynamic_pointer_cast<CommunityChestTile>(tile)) tileKinds[t] = TileKind::CommunityChest;
+        else if (std::dynamic_pointer_cast<StartTile>(tile)) tileKinds[t] = TileKind::Go;
+        else if (std::dynamic_pointer_cast<JailTile>(tile)) tileKinds[t] = TileKind::Jail;
+        else if (std::dynamic_pointer_cast<GoToJailTile>(tile)) tileKinds[t] = TileKind::GoToJail;
+        else if (std::dynamic_pointer_cast<FreeParkingTile>(tile)) tileKinds[t] = TileKind::FreeParking;
+    }
+
+    // The first tile of each kind met walking forward from every position
+    nextTiles.assign(tileCount, {});
+    for (int position = 0; position < tileCount; ++position) {
+        for (int step = 1; step < tileCount; ++step) {
+            int i = (position + step) % tileCount;
+            NextTile& next = nextTiles[position][static_cast<int>(tileKinds[i])];
+            if (next.index < 0) {
+                next.index = static_cast<int8_t>(i);
+                next.distance = static_cast<int8_t>(step);
+                next.passesGo = i < position;
+            }
+        }
+    }
 }
 
 std::vector<StreetTile*> Board::getColorGroupProperties(const std::string& colorGroup) const {
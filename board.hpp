@@ -2,6 +2,7 @@
 #define BOARD_HPP
 
 #include <vector>
+#include <array>
 #include <memory>
 #include <iostream>
 #include <SFML/Graphics.hpp>
@@ -9,10 +10,31 @@
 #include "streetTile.hpp"
 
 
+// The next tile of some kind ahead of a position
+struct NextTile {
+    int8_t index = -1;       // Board position, -1 if the board has no tile of that kind
+    int8_t distance = 0;     // Steps forward to reach it
+    bool passesGo = false;   // Whether the move wraps past Go
+};
+
 class Board {
 private:
     std::vector<std::shared_ptr<Tile>> tiles;
     std::vector<sf::Vector2f> tilePositions;  // Stores graphical positions for each tile
+    std::vector<TileKind> tileKinds;          // Kind of each tile
+    std::vector<std::array<NextTile, kTileKindCount>> nextTiles;  // Per position and kind, rebuilt when tiles change
+    BankInventory bank;                       // Houses and hotels for the streets of this board
+
+    // Append a tile without rebuilding the lookup tables (constructor)
+    void placeTile(std::shared_ptr<Tile> tile, const sf::Vector2f& position) {
+        if (tiles.size() < 40) {
+            tiles.push_back(tile);
+            tilePositions.push_back(position);  // Add the graphical position
+        }
+    }
+
+    // Classify every tile and find the next tile of each kind from every position
+    void buildLookupTables();
 
     // Private constructor (Singleton pattern)
     Board();
@@ -24,6 +46,11 @@ public:
         return instance;
     }
 
+    // Create an independent standard board (used when many games run side by side)
+    static std::unique_ptr<Board> create() {
+        return std::unique_ptr<Board>(new Board());
+    }
+
 
     // Delete copy constructor and assignment to prevent duplication
     Board(const Board&) = delete;
@@ -32,8 +59,8 @@ public:
     // Add a tile to the board with its graphical position
     void addTile(std::shared_ptr<Tile> tile, const sf::Vector2f& position) {
         if (tiles.size() < 40) {
-            tiles.push_back(tile);
-            tilePositions.push_back(position);  // Add the graphical position
+            placeTile(tile, position);
+            buildLookupTables();
         }
     }
 
@@ -42,6 +69,7 @@ public:
         if (index >= 0 && index < static_cast<int>(tiles.size())) {
             tiles.erase(tiles.begin() + index);
             tilePositions.erase(tilePositions.begin() + index);  // Remove the graphical position
+            buildLookupTables();
             return true;
         }
         return false;
@@ -72,6 +100,27 @@ public:
         return nullptr;
     }
 
+    TileKind getTileKind(int position) const {
+        if (position >= 0 && position < static_cast<int>(tileKinds.size())) {
+            return tileKinds[position];
+        }
+        return TileKind::Other;
+    }
+
+    // Next tile of a kind strictly ahead of a position, wrapping past Go. Built once from the board
+    // definition; used by the advance cards, simulations and strategy lookahead.
+    const NextTile& nextTile(int position, TileKind kind) const {
+        static const NextTile none;
+        if (position >= 0 && position < static_cast<int>(nextTiles.size())) {
+            return nextTiles[position][static_cast<int>(kind)];
+        }
+        return none;
+    }
+
+    // The bank's houses and hotels, shared by every street on the board
+    BankInventory& getBank() { return bank; }
+    const BankInventory& getBank() const { return bank; }
+
     // Get the graphical position of a tile
     sf::Vector2f getTilePosition(int index) const {
         if (index >= 0 && index < static_cast<int>(tilePositions.size())) {
@@ -0,0 +1,73 @@
+#include "cardDeck.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+CardDeck::CardDeck(std::vector<CardSpec> deckCards) : cards(std::move(deckCards)) {
+    if (cards.size() > static_cast<size_t>(kMaxCards)) {
+        throw std::invalid_argument("A card deck holds at most 32 cards");
+    }
+    for (size_t i = 0; i < cards.size(); ++i) {
+        deck.order.push_back(static_cast<uint8_t>(i));
+    }
+    deck.cursor = static_cast<uint32_t>(deck.order.size());  // Empty until the first shuffle
+}
+
+CardDeck CardDeck::standardChance() {
+    return CardDeck({
+        standardCards::AdvanceToGo,
+        standardCards::GoToJail,
+        standardCards::TripToReadingRailroad,
+        standardCards::GeneralRepairs,
+        standardCards::GetOutOfJailFree,
+        standardCards::AdvanceToNearestUtility,
+        standardCards::AdvanceToNearestRailroad,
+    });
+}
+
+CardDeck CardDeck::standardCommunityChest() {
+    return CardDeck({
+        standardCards::AdvanceToGo,
+        standardCards::GeneralRepairs,
+        standardCards::GetOutOfJailFree,
+        standardCards::GeneralRepairs,
+        standardCards::GeneralRepairs,
+    });
+}
+
+void CardDeck::shuffle(RandomStream& rng) {
+    // From a fixed order, so the result depends only on the generator (seeded games replay exactly)
+    for (size_t i = 0; i < deck.order.size(); ++i) {
+        deck.order[i] = static_cast<uint8_t>(i);
+    }
+    std::shuffle(deck.order.begin(), deck.order.end(), rng);
+    deck.cursor = 0;
+}
+
+const CardSpec* CardDeck::draw(RandomStream& rng) {
+    if (heldCount() == size()) return nullptr;
+
+    // Held cards stay in the order but are skipped, so each draw costs O(1) plus one skip per held card
+    while (true) {
+        if (deck.cursor >= deck.order.size()) {
+            shuffle(rng);
+        }
+        int index = deck.order[deck.cursor++];
+        uint32_t bit = 1u << index;
+        if (deck.held & bit) continue;
+
+        if (cards[index].isKeepable()) {
+            deck.held |= bit;
+        }
+        return &cards[index];
+    }
+}
+
+bool CardDeck::returnHeldCard() {
+    if (deck.held == 0) return false;
+    deck.held &= deck.held - 1;  // Clear the lowest held card; it rejoins the deck at the next shuffle
+    return true;
+}
+
+int CardDeck::heldCount() const {
+    return __builtin_popcount(deck.held);
+}
@@ -0,0 +1,51 @@
+#ifndef CARD_DECK_HPP
+#define CARD_DECK_HPP
+
+#include <cstdint>
+#include <vector>
+#include "cards.hpp"
+#include "randomStream.hpp"
+
+// Plain-data position of a deck: enough to save it or fork a game mid-deck
+struct DeckState {
+    std::vector<uint8_t> order;  // Draw order (indices into the deck's cards)
+    uint32_t cursor = 0;         // Next slot of `order` to draw
+    uint32_t held = 0;           // Bit per card currently kept by a player
+};
+
+// A Chance or Community Chest deck shared by every tile of its kind in a game.
+// Cards are drawn from a shuffled order with a cursor and the deck is reshuffled once it runs out.
+// A keepable card (Get Out of Jail Free) stays out of the deck until it is returned.
+class CardDeck {
+private:
+    std::vector<CardSpec> cards;
+    DeckState deck;
+
+public:
+    static constexpr int kMaxCards = 32;  // Held cards are tracked in a 32-bit mask
+
+    CardDeck() = default;
+    explicit CardDeck(std::vector<CardSpec> cards);
+
+    // The decks used on the standard board
+    static CardDeck standardChance();
+    static CardDeck standardCommunityChest();
+
+    // Start a new pass through the deck in random order
+    void shuffle(RandomStream& rng);
+
+    // Next card; null only if every card is held by players
+    const CardSpec* draw(RandomStream& rng);
+
+    // Put a held card back; false if none is held
+    bool returnHeldCard();
+
+    int size() const { return static_cast<int>(cards.size()); }
+    int heldCount() const;
+    const CardSpec& getCard(int index) const { return cards[index]; }
+
+    const DeckState& state() const { return deck; }
+    void restore(const DeckState& state) { deck = state; }
+};
+
+#endif // CARD_DECK_HPP
@@ -1,68 +1,130 @@
 #ifndef CARDS_HPP
 #define CARDS_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
-
+#include "tile.hpp"
 
 class Player;  // Forward declaration of Player
 class Game;    // Forward declaration of Game
 
-// Base Card class
+// What a card does; one case of executeCard each
+enum class CardAction : uint8_t {
+    AdvanceTo,          // Move to `target`, then buy or pay rent there
+    AdvanceToNearest,   // Move to the next tile of kind `target` (a TileKind), then buy or pay rent there
+    Collect,            // Receive `amount` from the bank
+    Pay,                // Pay `amount` to the bank
+    Repairs,            // Pay `amount` per house and `perHotel` per hotel
+    GoToJail,
+    GetOutOfJailFree    // Kept by the player until used
+};
+
+// The deck a card was drawn from; a kept card goes back to it when played
+enum class DeckKind : uint8_t { Chance, CommunityChest };
+constexpr int kDeckKinds = 2;
+
+// Card flag bits
+enum CardFlag : uint8_t {
+    CollectPassingGo = 1,        // Salary when the move wraps past Go
+    BuyWithoutFundsCheck = 2     // An unowned destination is bought even if the player can't afford it
+};
+
+// A card as data. All card effects are run by the single interpreter executeCard.
+struct CardSpec {
+    CardAction action;
+    int8_t target;              // AdvanceTo: tile index; AdvanceToNearest: TileKind
+    int16_t amount;             // Collect/Pay: dollars; Repairs: per house; AdvanceTo*: fixed rent (0 = the tile's rent)
+    int16_t perHotel;           // Repairs: per hotel
+    uint8_t flags;              // CardFlag bits
+    const char* name;           // Profiler scope, e.g. "card:AdvanceToGo"
+    const char* description;
+
+    bool isKeepable() const { return action == CardAction::GetOutOfJailFree; }
+};
+
+// Apply a card's effect to the player. `deck` is where a kept card is returned once it is played.
+void executeCard(const CardSpec& card, const std::shared_ptr<Player>& player, Game& game, DeckKind deck = DeckKind::Chance);
+
+// The cards of the standard decks
+namespace standardCards {
+extern const CardSpec AdvanceToGo;
+extern const CardSpec GoToJail;
+extern const CardSpec GetOutOfJailFree;
+extern const CardSpec TripToReadingRailroad;
+extern const CardSpec AdvanceToNearestUtility;
+extern const CardSpec AdvanceToNearestRailroad;
+extern const CardSpec GeneralRepairs;
+}
+
+// Base Card class. Card objects wrap a CardSpec for callers that hold cards by pointer.
 class Card {
 public:
     virtual std::string getDescription() const = 0;
     virtual void execute(std::shared_ptr<Player> player, Game& game) = 0;
+    // Same, drawn from `deck`
+    virtual void execute(std::shared_ptr<Player> player, Game& game, DeckKind) { execute(player, game); }
+
+    // Kept by the player instead of going back into the deck
+    virtual bool isKeepable() const { return false; }
+
     virtual ~Card() = default;
 };
 
+// A card defined by a descriptor
+class SpecCard : public Card {
+private:
+    const CardSpec& spec;
+
+public:
+    explicit SpecCard(const CardSpec& spec) : spec(spec) {}
+
+    std::string getDescription() const override { return spec.description; }
+    void execute(std::shared_ptr<Player> player, Game& game) override { executeCard(spec, player, game); }
+    void execute(std::shared_ptr<Player> player, Game& game, DeckKind deck) override { executeCard(spec, player, game, deck); }
+    bool isKeepable() const override { return spec.isKeepable(); }
+};
+
 // 1. Advance to Go (Collect $200)
-class AdvanceToGoCard : public Card {
+class AdvanceToGoCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    AdvanceToGoCard() : SpecCard(standardCards::AdvanceToGo) {}
 };
 
 // 2. Go to Jail (Do not pass Go, do not collect $200)
-class GoToJailCard : public Card {
+class GoToJailCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    GoToJailCard() : SpecCard(standardCards::GoToJail) {}
 };
 
 // 3. Get Out of Jail Free
-class GetOutOfJailFreeCard : public Card {
+class GetOutOfJailFreeCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    GetOutOfJailFreeCard() : SpecCard(standardCards::GetOutOfJailFree) {}
 };
 
 // 4. Take a Trip to Reading Railroad
-class TripToReadingRailroadCard : public Card {
+class TripToReadingRailroadCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    TripToReadingRailroadCard() : SpecCard(standardCards::TripToReadingRailroad) {}
 };
 
 // 5. Advance to Nearest Utility
-class AdvanceToNearestUtilityCard : public Card {
+class AdvanceToNearestUtilityCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    AdvanceToNearestUtilityCard() : SpecCard(standardCards::AdvanceToNearestUtility) {}
 };
 
 // 6. Advance to Nearest Railroad
-class AdvanceToNearestRailroadCard : public Card {
+class AdvanceToNearestRailroadCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    AdvanceToNearestRailroadCard() : SpecCard(standardCards::AdvanceToNearestRailroad) {}
 };
 
 // 7. General Repairs Card
-class GeneralRepairsCard : public Card {
+class GeneralRepairsCard : public SpecCard {
 public:
-    std::string getDescription() const override;
-    void execute(std::shared_ptr<Player> player, Game& game) override;
+    GeneralRepairsCard() : SpecCard(standardCards::GeneralRepairs) {}
 };
 
 #endif // CARDS_HPP
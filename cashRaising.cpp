@@ -0,0 +1,42 @@
+#include "cashRaising.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace {
+constexpr int kStep = 5;      // Mortgage values are half of prices in tens
+constexpr int kUnits = 1024;  // Largest need planned exactly, in steps
+}
+
+uint32_t cheapestMortgages(const int* value, const int* rent, int count, int need) {
+    count = std::min(count, 32);
+    if (need <= 0 || count <= 0) return 0;
+    long long total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += value[i];
+    }
+    if (total < need) return 0;
+    uint32_t everything = count == 32 ? ~0u : (1u << count) - 1;
+
+    int target = (need + kStep - 1) / kStep;
+    if (target >= kUnits) return everything;
+
+    // lost[s]: least rent given up to raise s steps (s == target: at least target), chosen[s]: how
+    int lost[kUnits];
+    uint32_t chosen[kUnits];
+    std::fill(lost, lost + target + 1, INT_MAX);
+    lost[0] = 0;
+    chosen[0] = 0;
+    for (int i = 0; i < count; ++i) {
+        int units = value[i] / kStep;  // Rounded down, so a plan never raises less than it claims
+        if (units <= 0) continue;
+        for (int s = target; s >= 0; --s) {
+            if (lost[s] == INT_MAX) continue;
+            int reached = std::min(target, s + units);
+            if (lost[s] + rent[i] < lost[reached]) {
+                lost[reached] = lost[s] + rent[i];
+                chosen[reached] = chosen[s] | (1u << i);
+            }
+        }
+    }
+    return lost[target] == INT_MAX ? everything : chosen[target];
+}
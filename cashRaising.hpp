@@ -0,0 +1,16 @@
+#ifndef CASH_RAISING_HPP
+#define CASH_RAISING_HPP
+
+#include <cstdint>
+
+// Cash a player keeps back when paying off mortgages at the end of a turn
+constexpr int kMortgageReserve = 200;
+
+// Which properties to mortgage to raise at least `need` dollars while giving up the least rent.
+// `value` and `rent` hold each property's mortgage value and the rent it would stop charging; bit i
+// of the result is set for property i. Exact 0/1 covering knapsack over $5 steps up to $5120, so it
+// runs in O(count x need / 5) with no allocation; larger needs mortgage everything. 0 if even every
+// property together falls short. At most 32 properties.
+uint32_t cheapestMortgages(const int* value, const int* rent, int count, int need);
+
+#endif // CASH_RAISING_HPP
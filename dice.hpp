@@ -4,26 +4,36 @@
 #include <random>
 #include <utility>
 #include <memory>
+#include <cstdint>
+#include "randomStream.hpp"
 
 class Dice {
 protected:
     bool mockEnabled = false;           // Flag to enable/disable mock results
     std::pair<int, int> mockResult;     // Holds the mock dice result
+    RandomStream gen;                   // Mersenne Twister RNG, one per Dice so games can be seeded independently
+    std::uniform_int_distribution<> dis{1, 6}; // Dice roll between 1 and 6
 
 public:
+    // Seed from the system's random device
+    Dice() : gen(std::random_device{}()) {}
+
+    // Seed explicitly (reproducible simulations)
+    explicit Dice(uint32_t seed) : gen(seed) {}
+
     // Virtual destructor to allow inheritance
     virtual ~Dice() = default;
 
+    // Position of the random rolls, for saving a game
+    const RandomStream& getStream() const { return gen; }
+    void restoreStream(uint32_t seed, uint64_t draws) { gen.restore(seed, draws); }
+
     // Roll two dice and return the results as a pair
     virtual std::pair<int, int> roll() {
         if (mockEnabled) {
             return mockResult;  // Return the mocked result if mocking is enabled
         }
 
-        static std::random_device rd;  // Seed for random number generator
-        static std::mt19937 gen(rd()); // Mersenne Twister RNG
-        static std::uniform_int_distribution<> dis(1, 6); // Dice roll between 1 and 6
-
         int dice1 = dis(gen);
         int dice2 = dis(gen);
         return {dice1, dice2};
@@ -0,0 +1,379 @@
+#include "endgame.hpp"
+#include "board.hpp"
+#include "jail.hpp"
+#include "railroadTile.hpp"
+#include "randomStream.hpp"
+#include "specialTiles.hpp"
+#include "streetTile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr int KindProperty = 1;
+constexpr int KindUtility = 2;
+constexpr int KindTax = 3;
+constexpr int KindGoToJail = 4;
+constexpr int kSalary = 200;   // Player::collectFromStart, paid again for landing on Go (StartTile)
+
+constexpr int kDicePairs = 36;
+
+// One roll of the mover: where the token ends, the mover's cash change and the other player's.
+// Positions past the last square are jail: the first of them before any missed roll, then one per miss.
+struct Move {
+    int position;
+    int moverGain;   // Salary less tax, rent and the jail fee
+    int otherGain;   // Rent received
+    float chance;    // Of the dice pairs leading here
+};
+
+} // namespace
+
+EndgameSolver::EndgameSolver(const Board& board, const EndgameOptions& options) : options(options) {
+    tiles = std::min(board.getTileCount(), kBoardTiles);
+    for (int t = 0; t < tiles; ++t) {
+        auto tile = board.getTile(t);
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(tile)) {
+            kind[t] = KindProperty;
+            price[t] = street->getBasePrice();
+            baseRent[t] = street->getBaseRent();
+            houseCost[t] = street->houseCost();
+            hotelCost[t] = street->hotelCost();
+        } else if (auto railroad = std::dynamic_pointer_cast<RailroadTile>(tile)) {
+            kind[t] = KindProperty;
+            price[t] = railroad->getPrice();
+            baseRent[t] = railroad->calculateRent();
+        } else if (auto utility = std::dynamic_pointer_cast<UtilityTile>(tile)) {
+            kind[t] = KindUtility;
+            price[t] = utility->getPrice();
+        } else if (auto tax = std::dynamic_pointer_cast<TaxTile>(tile)) {
+            kind[t] = KindTax;
+            price[t] = tax->getTaxAmount();
+        } else if (std::dynamic_pointer_cast<GoToJailTile>(tile)) {
+            kind[t] = KindGoToJail;
+        } else if (std::dynamic_pointer_cast<JailTile>(tile)) {
+            jail = t;
+        }
+    }
+}
+
+EndgameSolver::Landing EndgameSolver::landingFor(const GameState& state, const std::array<int, 2>& seats) const {
+    Landing landing;
+    landing.owner.fill(-1);
+    std::array<int, 2> utilities{};
+    for (int t = 0; t < tiles; ++t) {
+        const TileState& tile = state.tiles[t];
+        int player = tile.owner == seats[0] ? 0 : tile.owner == seats[1] ? 1 : -1;
+        if (player < 0 || tile.mortgaged || (kind[t] != KindProperty && kind[t] != KindUtility)) continue;
+        landing.owner[t] = static_cast<int8_t>(player);
+        if (kind[t] == KindUtility) {
+            utilities[player]++;
+        } else {
+            int level = tile.hotel ? 5 : tile.houses;
+            landing.rent[t] = baseRent[t] << level;  // StreetTile::rentAt
+        }
+    }
+    for (int p = 0; p < 2; ++p) {
+        landing.utilityMultiplier[p] = utilities[p] >= 2 ? 10 : utilities[p] == 1 ? 4 : 0;
+    }
+    return landing;
+}
+
+int EndgameSolver::liquidAssets(const GameState& state, int seat) const {
+    int assets = state.seats[seat].money;
+    if (!options.raisesCash) return assets;
+    for (int t = 0; t < tiles; ++t) {
+        const TileState& tile = state.tiles[t];
+        if (tile.owner != seat) continue;
+        if (!tile.mortgaged) assets += price[t] / 2;
+        assets += (tile.hotel ? hotelCost[t] : tile.houses * houseCost[t]) / 2;
+    }
+    return assets;
+}
+
+namespace {
+
+// Every roll from every position, for each mover
+struct MoveTable {
+    int positions = 0;                // Squares, then the jail states
+    std::vector<Move> byDice[2];      // [position * kDicePairs + (die1 - 1) * 6 + die2 - 1], for rollouts
+    std::vector<Move> outcomes[2];    // Dice pairs with the same result merged, position by position
+    std::vector<int> first[2];        // Outcomes from position p are [first[p], first[p + 1])
+};
+
+// A jailed player rolls for doubles (JailAction::Roll) and follows jail::kSteps; doubles give no
+// extra roll anywhere
+MoveTable buildMoves(int tiles, int jail, const std::array<int, kBoardTiles>& kind, const std::array<int, kBoardTiles>& price,
+                     const std::array<int, kBoardTiles>& rent, const std::array<int8_t, kBoardTiles>& owner,
+                     const std::array<int, 2>& utilityMultiplier) {
+    MoveTable table;
+    table.positions = tiles + kJailAttempts;
+    for (int mover = 0; mover < 2; ++mover) {
+        table.byDice[mover].resize(static_cast<size_t>(table.positions) * kDicePairs);
+        for (int from = 0; from < table.positions; ++from) {
+            table.first[mover].push_back(static_cast<int>(table.outcomes[mover].size()));
+            for (int pair = 0; pair < kDicePairs; ++pair) {
+                int total = pair / 6 + pair % 6 + 2;
+                Move move{from, 0, 0, 1.0f / kDicePairs};
+                int square = from;
+                bool moves = true;
+                if (from >= tiles) {
+                    const JailStep& step = jail::step(JailAction::Roll, from - tiles, pair / 6 == pair % 6);
+                    if (step.paysFee) move.moverGain -= kJailFee;
+                    if (!step.leaves) move.position = std::min(from + 1, table.positions - 1);
+                    square = jail;
+                    moves = step.moves;
+                }
+                if (moves) {
+                    int to = (square + total) % tiles;
+                    if (square + total >= tiles) move.moverGain += kSalary;
+                    if (to == 0) move.moverGain += kSalary;
+                    if (kind[to] == KindGoToJail) {
+                        to = tiles;
+                    } else if (kind[to] == KindTax) {
+                        move.moverGain -= price[to];
+                    } else if (owner[to] == 1 - mover) {
+                        int owed = kind[to] == KindUtility ? utilityMultiplier[1 - mover] * total : rent[to];
+                        move.moverGain -= owed;
+                        move.otherGain = owed;
+                    }
+                    move.position = to;
+                }
+                table.byDice[mover][from * kDicePairs + pair] = move;
+
+                auto same = std::find_if(table.outcomes[mover].begin() + table.first[mover].back(), table.outcomes[mover].end(),
+                                         [&](const Move& other) {
+                                             return other.position == move.position && other.moverGain == move.moverGain &&
+                                                    other.otherGain == move.otherGain;
+                                         });
+                if (same != table.outcomes[mover].end()) {
+                    same->chance += move.chance;
+                } else {
+                    table.outcomes[mover].push_back(move);
+                }
+            }
+        }
+        table.first[mover].push_back(static_cast<int>(table.outcomes[mover].size()));
+    }
+    return table;
+}
+
+// Where a seat starts in the chain; a jailed seat is taken to have missed no rolls yet
+int startPosition(const GameState& state, int seat, int tiles) {
+    const SeatState& at = state.seats[seat];
+    return at.flags & SeatState::InJail ? tiles : at.position % tiles;
+}
+
+// The two seats still in play; false unless there are exactly two
+bool findSeats(const GameState& state, std::array<int, 2>& seats) {
+    int found = 0;
+    for (int seat = 0; seat < state.seatCount && seat < GameState::kMaxSeats; ++seat) {
+        if (state.seats[seat].flags & SeatState::Bankrupt) continue;
+        if (found < 2) seats[found] = seat;
+        found++;
+    }
+    return found == 2;
+}
+
+// Where a cash amount falls among the buckets: the lower one and the share that goes one up
+struct Split {
+    int low;
+    float up;
+};
+
+Split split(double buckets, int count) {
+    if (buckets >= count - 1) return {count - 1, 0.0f};
+    int low = static_cast<int>(buckets);
+    return {low, static_cast<float>(buckets - low)};
+}
+
+} // namespace
+
+EndgameEstimate EndgameSolver::solveModel(const GameState& state) const {
+    EndgameEstimate estimate;
+    estimate.valid = findSeats(state, estimate.seats);
+    if (!estimate.valid) return estimate;
+
+    Landing landing = landingFor(state, estimate.seats);
+    MoveTable table = buildMoves(tiles, jail, kind, price, landing.rent, landing.owner, landing.utilityMultiplier);
+    std::array<int, 2> cash = {liquidAssets(state, estimate.seats[0]), liquidAssets(state, estimate.seats[1])};
+
+    // Bucket b holds b * width dollars; the top bucket leaves room for the richer player to double up
+    const int B = std::max(options.cashBuckets, 2);
+    double width = std::max(1.0, 2.0 * std::max(std::max(cash[0], cash[1]), 1) / (B - 1));
+    const int P = table.positions;
+    const size_t perMover = static_cast<size_t>(P) * P * B * B;
+    auto index = [&](int p0, int p1, int b0, int b1) { return ((static_cast<size_t>(p0) * P + p1) * B + b0) * B + b1; };
+
+    // win: player 0 wins within the horizon; done: someone does. One array per mover.
+    std::vector<float> win[2] = {std::vector<float>(perMover, 0.0f), std::vector<float>(perMover, 0.0f)};
+    std::vector<float> done[2] = {std::vector<float>(perMover, 0.0f), std::vector<float>(perMover, 0.0f)};
+    // Per bucket of the mover and of the other player: the two buckets a payment lands between, as
+    // offsets into the state arrays, and their weights
+    struct Target {
+        size_t low, high;
+        float lowWeight, highWeight;
+    };
+    std::vector<Target> moverTarget(B);
+    std::vector<Target> otherTarget(B);
+    std::vector<char> moverOut(B);
+    auto target = [](Split split, size_t stride) {
+        return Target{split.low * stride, (split.low + (split.up > 0.0f ? 1 : 0)) * stride, 1.0f - split.up, split.up};
+    };
+
+    for (int round = 0; round < options.horizon; ++round) {
+        // Player 1's turns read player 0's values from the round before, then player 0's turns read those
+        for (int mover : {1, 0}) {
+            std::vector<float>& nextWin = win[mover];
+            std::vector<float>& nextDone = done[mover];
+            const std::vector<float>& laterWin = win[1 - mover];
+            const std::vector<float>& laterDone = done[1 - mover];
+            std::fill(nextWin.begin(), nextWin.end(), 0.0f);
+            std::fill(nextDone.begin(), nextDone.end(), 0.0f);
+            float loserWins = mover == 0 ? 0.0f : 1.0f;  // Player 0's win chance when the mover goes out
+            // Strides of the mover's and the other player's cash bucket in index()
+            size_t moverStride = mover == 0 ? B : 1;
+            size_t otherStride = mover == 0 ? 1 : B;
+
+            for (int from = 0; from < P; ++from) {
+                for (int outcome = table.first[mover][from]; outcome < table.first[mover][from + 1]; ++outcome) {
+                    const Move& move = table.outcomes[mover][outcome];
+                    float chance = move.chance;
+                    for (int b = 0; b < B; ++b) {
+                        double moverBuckets = b + move.moverGain / width;
+                        moverOut[b] = moverBuckets < 0.0;
+                        moverTarget[b] = target(split(std::max(moverBuckets, 0.0), B), moverStride);
+                        otherTarget[b] = target(split(b + move.otherGain / width, B), otherStride);
+                    }
+                    for (int other = 0; other < P; ++other) {
+                        size_t hereBase = mover == 0 ? index(from, other, 0, 0) : index(other, from, 0, 0);
+                        size_t thereBase = mover == 0 ? index(move.position, other, 0, 0) : index(other, move.position, 0, 0);
+                        for (int bm = 0; bm < B; ++bm) {
+                            size_t hereRow = hereBase + bm * moverStride;
+                            if (moverOut[bm]) {
+                                for (int bo = 0; bo < B; ++bo) {
+                                    nextWin[hereRow + bo * otherStride] += chance * loserWins;
+                                    nextDone[hereRow + bo * otherStride] += chance;
+                                }
+                                continue;
+                            }
+                            const Target& m = moverTarget[bm];
+                            for (int bo = 0; bo < B; ++bo) {
+                                const Target& o = otherTarget[bo];
+                                size_t ll = thereBase + m.low + o.low;
+                                size_t lh = thereBase + m.low + o.high;
+                                size_t hl = thereBase + m.high + o.low;
+                                size_t hh = thereBase + m.high + o.high;
+                                float w = m.lowWeight * (o.lowWeight * laterWin[ll] + o.highWeight * laterWin[lh]) +
+                                          m.highWeight * (o.lowWeight * laterWin[hl] + o.highWeight * laterWin[hh]);
+                                float d = m.lowWeight * (o.lowWeight * laterDone[ll] + o.highWeight * laterDone[lh]) +
+                                          m.highWeight * (o.lowWeight * laterDone[hl] + o.highWeight * laterDone[hh]);
+                                size_t here = hereRow + bo * otherStride;
+                                nextWin[here] += chance * w;
+                                nextDone[here] += chance * d;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Read the start position, interpolating both players' cash between buckets
+    int mover = state.currentSeat == estimate.seats[1] ? 1 : 0;
+    int p0 = startPosition(state, estimate.seats[0], tiles);
+    int p1 = startPosition(state, estimate.seats[1], tiles);
+    Split s0 = split(cash[0] / width, B);
+    Split s1 = split(cash[1] / width, B);
+    double w = 0.0;
+    double d = 0.0;
+    for (int d0 = 0; d0 < 2; ++d0) {
+        for (int d1 = 0; d1 < 2; ++d1) {
+            double weight = (d0 ? s0.up : 1.0 - s0.up) * (d1 ? s1.up : 1.0 - s1.up);
+            if (weight == 0.0) continue;
+            size_t at = index(p0, p1, std::min(s0.low + d0, B - 1), std::min(s1.low + d1, B - 1));
+            w += weight * win[mover][at];
+            d += weight * done[mover][at];
+        }
+    }
+    estimate.decided = d;
+    if (d > 0.0) {
+        estimate.win[0] = std::min(1.0, w / d);
+    } else {
+        estimate.win[0] = cash[0] + cash[1] > 0 ? static_cast<double>(cash[0]) / (cash[0] + cash[1]) : 0.5;
+    }
+    estimate.win[1] = 1.0 - estimate.win[0];
+    return estimate;
+}
+
+EndgameEstimate EndgameSolver::rollOut(const GameState& state) const {
+    EndgameEstimate estimate;
+    estimate.valid = findSeats(state, estimate.seats);
+    if (!estimate.valid) return estimate;
+    estimate.rolledOut = true;
+
+    Landing landing = landingFor(state, estimate.seats);
+    MoveTable table = buildMoves(tiles, jail, kind, price, landing.rent, landing.owner, landing.utilityMultiplier);
+    std::array<int, 2> startCash = {liquidAssets(state, estimate.seats[0]), liquidAssets(state, estimate.seats[1])};
+    std::array<int, 2> start = {startPosition(state, estimate.seats[0], tiles), startPosition(state, estimate.seats[1], tiles)};
+    int firstMover = state.currentSeat == estimate.seats[1] ? 1 : 0;
+
+    // Worker w plays rollouts w, w + threads, ...; each rollout has its own seed, so the split does not matter
+    int threads = std::max(1, std::min(options.threads, options.rollouts));
+    std::vector<std::array<int, 2>> wins(threads, std::array<int, 2>{});
+    auto work = [&](int w) {
+        for (int r = w; r < options.rollouts; r += threads) {
+            RandomStream rng(options.seed + static_cast<uint32_t>(r) * 0x9E3779B9u);
+            std::array<int, 2> cash = startCash;
+            std::array<int, 2> position = start;
+            int mover = firstMover;
+            for (int turn = 0; turn < 2 * options.rolloutRounds; ++turn) {
+                int pair = static_cast<int>(rng() % 6) * 6;
+                pair += static_cast<int>(rng() % 6);
+                const Move& move = table.byDice[mover][position[mover] * kDicePairs + pair];
+                cash[mover] += move.moverGain;
+                if (cash[mover] < 0) {
+                    wins[w][1 - mover]++;
+                    break;
+                }
+                cash[1 - mover] += move.otherGain;
+                position[mover] = move.position;
+                mover = 1 - mover;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int w = 1; w < threads; ++w) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::array<int, 2> total{};
+    for (const auto& counts : wins) {
+        total[0] += counts[0];
+        total[1] += counts[1];
+    }
+    int decided = total[0] + total[1];
+    estimate.decided = options.rollouts > 0 ? static_cast<double>(decided) / options.rollouts : 0.0;
+    if (decided > 0) {
+        estimate.win[0] = static_cast<double>(total[0]) / decided;
+    } else {
+        int all = startCash[0] + startCash[1];
+        estimate.win[0] = all > 0 ? static_cast<double>(startCash[0]) / all : 0.5;
+    }
+    estimate.win[1] = 1.0 - estimate.win[0];
+    return estimate;
+}
+
+EndgameEstimate EndgameSolver::analyze(const GameState& state) const {
+    EndgameEstimate estimate = solveModel(state);
+    if (estimate.valid && estimate.decided < options.minDecided) {
+        return rollOut(state);
+    }
+    return estimate;
+}
@@ -0,0 +1,82 @@
+#ifndef ENDGAME_HPP
+#define ENDGAME_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "gameState.hpp"
+
+class Board;
+
+struct EndgameOptions {
+    int cashBuckets = 6;          // Cash levels per player in the Markov model
+    int horizon = 48;             // Rounds the model looks ahead (value-iteration sweeps)
+    double minDecided = 0.5;      // Below this chance of the game ending within the horizon, roll out instead
+    int rollouts = 256;           // Games played out by the fallback
+    int rolloutRounds = 5000;     // Rounds before a rollout counts as undecided
+    int threads = 1;              // Rollout worker threads
+    uint32_t seed = 1;
+    bool raisesCash = true;       // Players sell and mortgage before going out; off, they are out when cash runs short
+};
+
+struct EndgameEstimate {
+    bool valid = false;                  // False unless exactly two seats are in play
+    std::array<int, 2> seats{{-1, -1}};  // The two seats, lowest first
+    std::array<double, 2> win{};         // Chance each of them wins, given the game is decided
+    double decided = 0.0;                // Chance the game ends within the horizon (or the rollout cap)
+    bool rolledOut = false;              // The estimate comes from rollouts
+};
+
+// When a simulated game may stop early: once it reaches `afterRolls` with two players left, and again
+// every `afterRolls` rolls after that, the game is played out by rollOut() and the favourite credited
+// with the win when they win at least `confidence` of all rollouts (undecided ones count against).
+struct EndgameCutoff {
+    int afterRolls = 0;          // 0 plays every game out
+    double confidence = 0.99;
+    EndgameOptions options = {4, 24, 0.5, 64, 500, 1, 1};
+};
+
+// Win chances for a game down to two players. Ownership and buildings are taken as fixed; each
+// turn is one roll of two dice from the mover's square, paying the rent of the tile landed on,
+// tax, and collecting $200 past Go. Go To Jail puts the mover in jail, where they roll for doubles
+// by jail::kSteps; a jailed seat starts with no missed rolls. Extra rolls on doubles, cards and
+// building are left out. A player is out when a payment exceeds their liquid assets (cash plus what
+// selling buildings and mortgaging would raise), or their cash when `raisesCash` is off.
+//
+// The model is a Markov chain over (mover, both positions, both players' cash in buckets), truncated
+// to `horizon` rounds and solved by value iteration: the chance of each player winning within the
+// horizon. Payments between bucket levels split the probability between the two nearest buckets,
+// so small rents still move cash on average. When the game is too unlikely to end within the
+// horizon, the analyzer plays the same chain out with exact cash on several threads instead.
+class EndgameSolver {
+private:
+    EndgameOptions options;
+    std::array<int, kBoardTiles> kind{};      // 0 nothing to pay, 1 property, 2 utility, 3 tax, 4 go to jail
+    std::array<int, kBoardTiles> price{};     // Purchase price, or the tax
+    std::array<int, kBoardTiles> baseRent{};  // Rent without buildings (streets, railroads)
+    std::array<int, kBoardTiles> houseCost{};
+    std::array<int, kBoardTiles> hotelCost{};
+    int tiles = kBoardTiles;
+    int jail = 10;
+
+    // What landing on each tile does under a state's ownership
+    struct Landing {
+        std::array<int, kBoardTiles> rent{};         // Owed to the owner
+        std::array<int8_t, kBoardTiles> owner{};     // Index (0 or 1) of the owning player, -1 if none
+        std::array<int, 2> utilityMultiplier{};
+    };
+    Landing landingFor(const GameState& state, const std::array<int, 2>& seats) const;
+    int liquidAssets(const GameState& state, int seat) const;
+
+public:
+    EndgameSolver(const Board& board, const EndgameOptions& options = EndgameOptions());
+
+    // Markov model first, rollouts when it is inconclusive
+    EndgameEstimate analyze(const GameState& state) const;
+
+    // Each method on its own
+    EndgameEstimate solveModel(const GameState& state) const;
+    EndgameEstimate rollOut(const GameState& state) const;
+};
+
+#endif // ENDGAME_HPP
@@ -1,43 +1,60 @@
 #include "game.hpp"
 #include "board.hpp"
+#include "cashRaising.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
 #include <iostream>
 #include <algorithm> 
+#include <cmath>
 #include <sstream>
 
 
 // Play a turn for the current player
 void Game::playTurn() {
+    PROFILE_SCOPE("playTurn");
     if (players.empty()) return; // Safety check in case of no players
 
     if (checkForWinner()) {
         return;  // End the game if there's a winner
     }
 
-    std::shared_ptr<Player> currentPlayer = players[currentPlayerIndex];
+    std::shared_ptr<Player> currentPlayer = seats[currentSeat];
 
     if (currentPlayer->isBankrupt()) {
-        nextPlayer();  // Skip this player if bankrupt
+        checkBankruptcy();  // Out of the game; the turn passes to the next seat in play
         return;
     }
 
     // Roll dice, or use mocked dice if already set
     if (!dice) {
-        dice = std::make_shared<Dice>(); // Reset to random dice if not set externally
+        dice = randomDice; // Reset to random dice if not set externally
     }
     
-    auto diceRoll = dice->roll();
+    std::pair<int, int> diceRoll;
+    {
+        PROFILE_SCOPE("rollDice");
+        diceRoll = dice->roll();
+    }
     int totalSteps = dice->total(diceRoll);
+    rollCount++;
 
     // Log the dice roll result
-    std::cout << "Player " << currentPlayer->getName() << " rolled " << diceRoll.first << " and " << diceRoll.second << std::endl;
+    LOG_INFO("Player " << currentPlayer->getName() << " rolled " << diceRoll.first << " and " << diceRoll.second);
 
     currentPlayer->setLastDiceRoll(totalSteps);
 
+    // A jailed player tries to get out first; only a way out that moves the token goes on from here
+    bool keepsTurn = dice->isDouble(diceRoll);
+    if (currentPlayer->isInJail() && !leaveJail(currentPlayer, keepsTurn, keepsTurn)) {
+        return;
+    }
+
     // Check for doubles
-    if (dice->isDouble(diceRoll)) {
+    if (keepsTurn) {
+        PROFILE_COUNT("doubles");
         doubleCount++;
         if (doubleCount == 3) {
-            std::cout << "Three doubles in a row! Player " << currentPlayer->getName() << " goes to jail." << std::endl;
+            LOG_INFO("Three doubles in a row! Player " << currentPlayer->getName() << " goes to jail.");
             currentPlayer->goToJail();
             doubleCount = 0;
             nextPlayer();
@@ -49,29 +66,40 @@ void Game::playTurn() {
     }
 
     // Move the player and update the position
-    int initialPosition = currentPlayer->getPosition();
-    currentPlayer->move(totalSteps);
-
-    // Check if the player passed the Start tile
-    if (currentPlayer->getPosition() < initialPosition) {
-        std::cout << "Player " << currentPlayer->getName() << " passed Start and collects $200!" << std::endl;
-        currentPlayer->collectFromStart(200);
+    {
+        PROFILE_SCOPE("move");
+        int initialPosition = currentPlayer->getPosition();
+        currentPlayer->move(totalSteps);
+
+        // Check if the player passed the Start tile
+        if (currentPlayer->getPosition() < initialPosition) {
+            PROFILE_COUNT("passedStart");
+            LOG_INFO("Player " << currentPlayer->getName() << " passed Start and collects $200!");
+            currentPlayer->collectFromStart(200);
+        }
     }
 
     // Interact with the tile the player landed on
     auto tile = board.getTile(currentPlayer->getPosition());
+    tileCounts.recordLanding(currentPlayer->getPosition());
     tile->onLand(currentPlayer, *this);
+    currentPlayer->payOffMortgages(kMortgageReserve);  // Spare cash clears mortgages
 
     // Handle bankruptcy after landing on a tile
     if (currentPlayer->isBankrupt()) {
-        std::cout << currentPlayer->getName() << " has gone bankrupt!" << std::endl;
-        checkBankruptcy();
-        if (checkForWinner()) return;
+        endBankruptTurn(currentPlayer);
+        return;
+    }
+
+    // Going to jail ends the turn, doubles or not
+    if (currentPlayer->isInJail()) {
+        keepsTurn = false;
+        doubleCount = 0;
     }
 
     // Handle doubles for extra turn
-    if (dice->isDouble(diceRoll)) {
-        std::cout << "Player " << currentPlayer->getName() << " gets another turn for rolling doubles!" << std::endl;
+    if (keepsTurn) {
+        LOG_INFO("Player " << currentPlayer->getName() << " gets another turn for rolling doubles!");
         dice.reset();  // Reset to random dice after the turn
         playTurn();  // Recursively handle another turn
     } else {
@@ -82,15 +110,210 @@ void Game::playTurn() {
     // Check for game winner at the end of the turn
    
 }
+
+bool Game::leaveJail(const std::shared_ptr<Player>& player, bool isDouble, bool& keepsTurn) {
+    PROFILE_SCOPE("jail");
+    int seat = currentSeat;  // Only the player whose turn it is leaves jail
+    JailPolicy* policy = seat >= 0 && jailPolicies[seat] ? jailPolicies[seat] : &jail::defaultPolicy();
+    JailAction action = policy->choose(*player, player->getJailTurns());
+    if (action == JailAction::UseCard && !player->hasGetOutOfJailFreeCard()) action = JailAction::Roll;
+
+    const JailStep& step = jail::step(action, player->getJailTurns(), isDouble);
+    if (step.usesCard) {
+        useGetOutOfJailCard(player);
+        LOG_INFO(player->getName() << " uses a Get Out of Jail Free card.");
+    }
+    if (step.paysFee) {
+        LOG_INFO(player->getName() << " pays $" << kJailFee << " to leave jail.");
+        if (!player->payDebt(kJailFee, nullptr)) {
+            endBankruptTurn(player);
+            return false;
+        }
+    }
+    if (!step.leaves) {
+        player->serveJailTurn();
+        LOG_INFO(player->getName() << " stays in jail.");
+        doubleCount = 0;
+        dice.reset();
+        nextPlayer();
+        return false;
+    }
+    player->releaseFromJail();
+    keepsTurn = isDouble && step.rollsAgain;
+    return true;
+}
+
+void Game::endBankruptTurn(const std::shared_ptr<Player>& player) {
+    // Leaving the ring already hands the turn to the next seat, so there is no extra turn for doubles
+    // and no nextPlayer
+    PROFILE_SCOPE("bankruptcy");
+    PROFILE_COUNT("bankruptcies");
+    LOG_WARN(player->getName() << " has gone bankrupt!");
+    checkBankruptcy();
+    doubleCount = 0;
+    dice.reset();
+    checkForWinner();
+}
+
 // Proceed to the next player
 void Game::nextPlayer() {
-    currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
+    if (nextSeat[currentSeat] >= 0) currentSeat = nextSeat[currentSeat];
+}
+
+int Game::seatOf(const Player* player) const {
+    auto it = seatIndex.find(player);
+    return it == seatIndex.end() ? -1 : it->second;
+}
+
+void Game::linkSeats() {
+    nextSeat.assign(seats.size(), -1);
+    previousSeat.assign(seats.size(), -1);
+    int count = static_cast<int>(players.size());
+    for (int i = 0; i < count; ++i) {
+        int seat = seatOf(players[i].get());
+        nextSeat[seat] = seatOf(players[(i + 1) % count].get());
+        previousSeat[seat] = seatOf(players[(i + count - 1) % count].get());
+    }
+    currentSeat = count > 0 ? seatOf(players[0].get()) : 0;
+}
+
+void Game::checkBankruptcy() {
+    // `players` stays in seat order, so erasing keeps the turn order of everyone left
+    for (auto it = players.begin(); it != players.end();) {
+        if (!(*it)->isBankrupt()) {
+            ++it;
+            continue;
+        }
+        int seat = seatOf(it->get());
+        int next = nextSeat[seat];
+        int previous = previousSeat[seat];
+        if (next == seat) {
+            next = -1;  // The last one in play
+        } else {
+            nextSeat[previous] = next;
+            previousSeat[next] = previous;
+        }
+        nextSeat[seat] = previousSeat[seat] = -1;
+        if (seat == currentSeat && next >= 0) currentSeat = next;
+        while (useGetOutOfJailCard(*it)) {}
+        it = players.erase(it);
+    }
+}
+
+bool Game::auctionProperty(const std::shared_ptr<Tile>& property, int listPrice, int tileIndex) {
+    if (auctionMode == AuctionMode::Off || players.empty()) return false;
+
+    // Bidding order starts with the player who landed there
+    entrants.clear();
+    int seat = currentSeat;
+    for (size_t i = 0; i < players.size() && seat >= 0; ++i, seat = nextSeat[seat]) {
+        entrants.push_back({seats[seat].get(), bidderFor(seat)});
+    }
+
+    const std::string& name = property->getName();
+    AuctionLot lot{name, listPrice};
+    AuctionResult result = runAuction(lot);
+    if (result.winner < 0) {
+        LOG_INFO("Nobody bid for " << name << "; it stays with the bank.");
+        return false;
+    }
+    Player& winner = *entrants[result.winner].player;
+    winner.buyProperty(property, result.price);
+    tileCounts.recordPurchase(tileIndex);
+    LOG_INFO(winner.getName() << " wins the auction for " << name << " at $" << result.price << "!");
+    return true;
+}
+
+AuctionResult Game::runAuction(const AuctionLot& lot) const {
+    int count = static_cast<int>(entrants.size());
+    return auctionMode == AuctionMode::Ascending ? auction::ascending(entrants.data(), count, lot)
+                                                 : auction::sealed(entrants.data(), count, lot);
+}
+
+namespace {
+
+bool ownsGroup(const Player& player, const std::vector<StreetTile*>& group) {
+    return std::all_of(group.begin(), group.end(), [&](StreetTile* street) { return street->getOwner().get() == &player; });
+}
+
+// What the owner pays for the next building: a house, or a hotel less the four houses it replaces
+int buildingCost(const StreetTile& street, bool hotel) {
+    return hotel ? street.hotelCost() - 4 * street.houseCost() : street.houseCost();
+}
+
+} // namespace
+
+StreetTile* Game::nextBuildingSite(const Player& player, bool hotel) const {
+    for (int t = 0; t < board.getTileCount(); ++t) {
+        if (board.getTileKind(t) != TileKind::Street) continue;
+        auto& street = static_cast<StreetTile&>(*board.getTile(t));
+        int level = street.buildingLevel();
+        if (street.getOwner().get() != &player || (hotel ? level != 4 : level >= 4) || street.isMortgaged() ||
+            player.getMoney() < buildingCost(street, hotel)) {
+            continue;
+        }
+        auto group = board.getColorGroupProperties(street.getColorGroup());
+        bool even = std::all_of(group.begin(), group.end(), [&](StreetTile* other) {
+            return other->buildingLevel() >= level && !other->isMortgaged();
+        });
+        if (even && ownsGroup(player, group)) return &street;
+    }
+    return nullptr;
+}
+
+StreetTile* Game::placeBuilding(StreetTile& street, bool hotel) {
+    std::shared_ptr<Player> owner = street.getOwner();
+    if (!owner) return nullptr;
+    int cost = buildingCost(street, hotel);
+    auto group = board.getColorGroupProperties(street.getColorGroup());
+    if (!ownsGroup(*owner, group) || owner->getMoney() < cost) return nullptr;
+    static const std::string kLotNames[] = {"a house", "a hotel"};
+
+    // Building shortage: when there are more players who could build than the bank has left, they bid
+    // for the next one. The count is only taken when the stock is low, so plenty of stock costs nothing.
+    int left = hotel ? board.getBank().hotelsLeft() : board.getBank().housesLeft();
+    if (left > 0 && left < static_cast<int>(players.size())) {
+        entrants.clear();
+        entrants.push_back({owner.get(), bidderFor(seatOf(owner.get()))});
+        for (const auto& player : players) {
+            if (player != owner && nextBuildingSite(*player, hotel)) entrants.push_back({player.get(), bidderFor(seatOf(player.get()))});
+        }
+        if (static_cast<int>(entrants.size()) > left) {
+            // The bank never sells below its price: the street's building cost is the reserve, and the
+            // winner pays at least the cost on the street they build on
+            AuctionResult result = runAuction(AuctionLot{kLotNames[hotel], cost, cost});
+            if (result.winner < 0) return nullptr;
+            Player& winner = *entrants[result.winner].player;
+            StreetTile* site = &winner == owner.get() ? &street : nextBuildingSite(winner, hotel);
+            if (!site) return nullptr;
+            auto siteGroup = board.getColorGroupProperties(site->getColorGroup());
+            if (!(hotel ? site->buildHotel(siteGroup) : site->buildHouse(siteGroup))) return nullptr;
+            int price = std::max(result.price, buildingCost(*site, hotel));
+            winner.adjustMoney(-price);
+            LOG_INFO(winner.getName() << " wins the auction for " << kLotNames[hotel] << " at $" << price
+                                      << " and builds on " << site->getName() << ".");
+            return site;
+        }
+    }
+
+    if (!(hotel ? street.buildHotel(group) : street.buildHouse(group))) return nullptr;
+    owner->adjustMoney(-cost);
+    LOG_INFO(owner->getName() << " builds " << kLotNames[hotel] << " on " << street.getName() << ".");
+    return &street;
+}
+
+const PropertyRoi& Game::getPropertyRoi() {
+    if (!propertyRoi) {
+        LandingModel model(board, chanceDeck, communityChestDeck);
+        propertyRoi = std::make_unique<PropertyRoi>(board, model);
+    }
+    return *propertyRoi;
 }
 
 // Check if a player has won the game
 bool Game::checkForWinner() {
     if (players.size() == 1) {
-        std::cout << "Player " << players[0]->getName() << " has won the game!" << std::endl;
+        LOG_INFO("Player " << players[0]->getName() << " has won the game!");
         return true;  // Game over, one player left
     }
     return false;  // No winner yet
@@ -111,6 +334,7 @@ void Game::start() {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleHeatmapKey(event);
         }
 
         // Clear the window and draw the board and players
@@ -169,7 +393,7 @@ void Game::drawBoard(sf::RenderWindow &window) {
     // Load the Monopoly image
     sf::Texture monopolyTexture;
     if (!monopolyTexture.loadFromFile("monopoly.jpg")) {
-        std::cout << "Error loading Monopoly image" << std::endl;
+        LOG_ERROR("Error loading Monopoly image");
         return;
     }
 
@@ -193,6 +417,10 @@ void Game::drawBoard(sf::RenderWindow &window) {
         {750, 50}, {750, 140}, {750, 200}, {750, 250}, {750, 330}, {750, 405}, {750, 475}, {750, 540}, {750, 600}, {750, 655}
     };
 
+    if (heatmapVisible) {
+        drawHeatmap(window, tilePositions);
+    }
+
     // Draw each tile's star, representing ownership
     for (int i = 0; i < board.getTileCount(); ++i) {
         auto tile = board.getTile(i);
@@ -209,6 +437,38 @@ void Game::drawBoard(sf::RenderWindow &window) {
 }
 
 
+// Shade every tile from transparent yellow (never) to opaque red (the busiest tile) by the chosen metric
+void Game::drawHeatmap(sf::RenderWindow &window, const std::vector<sf::Vector2f> &tilePositions) {
+    const TileCounts& counts = heatmapCounts ? *heatmapCounts : tileCounts;
+    long long highest = counts.maxValue(heatmapMetric);
+    if (highest == 0) return;
+
+    for (int i = 0; i < board.getTileCount() && i < static_cast<int>(tilePositions.size()); ++i) {
+        double heat = static_cast<double>(counts.value(heatmapMetric, i)) / highest;
+        if (heat <= 0) continue;
+
+        sf::RectangleShape cell(sf::Vector2f(50, 50));
+        cell.setFillColor(sf::Color(255, static_cast<sf::Uint8>(255 * (1 - heat)), 0, static_cast<sf::Uint8>(40 + 150 * heat)));
+        cell.setPosition(tilePositions[i].x - 25, tilePositions[i].y - 25);
+        window.draw(cell);
+    }
+}
+
+// Cycle the heatmap with the H key: landings, purchases, rent, card draws, off
+void Game::handleHeatmapKey(const sf::Event& event) {
+    if (event.type != sf::Event::KeyPressed || event.key.code != sf::Keyboard::H) return;
+
+    if (!heatmapVisible) {
+        showHeatmap(TileMetric::Landings, heatmapCounts);
+    } else if (heatmapMetric == TileMetric::CardDraws) {
+        hideHeatmap();
+    } else {
+        showHeatmap(static_cast<TileMetric>(static_cast<int>(heatmapMetric) + 1), heatmapCounts);
+    }
+    if (heatmapVisible) {
+        LOG_INFO("Heatmap: " << tileMetricName(heatmapMetric));
+    }
+}
 
 sf::Vector2f Game::getTilePosition(int tileIndex, double tileSize, int cornerTileSize) {
     if (tileIndex < 10) {
@@ -238,47 +498,67 @@ void Game::drawPlayers(sf::RenderWindow &window, const std::vector<std::shared_p
         {750, 50}, {750, 140}, {750, 200}, {750, 250}, {750, 330}, {750, 405}, {750, 475}, {750, 540}, {750, 600}, {750, 655}
     };
 
-    // Group players by their tile position
-    std::map<int, std::vector<std::shared_ptr<Player>>> playerGroups;
+    // Tokens sharing a tile are packed into a grid on it, so even a full table of 16 stays on the tile
+    std::vector<int> onTile(tilePositions.size(), 0);
     for (const auto& player : players) {
-        playerGroups[player->location].push_back(player);
-    }
-
-    // Now draw each player on the corresponding tile
-    for (const auto& group : playerGroups) {
-        int tileIndex = group.first;
-        const auto& tilePosition = tilePositions[tileIndex];
-        int offsetCounter = 0;  // To adjust position if there are multiple players on the same tile
-
-        for (const auto& player : group.second) {
-            sf::CircleShape playerCircle(10);
-            playerCircle.setFillColor(player->color);
-            
-            sf::Vector2f adjustedPosition = tilePosition;
-            
-            // Adjust the position based on the tile's row or column
-            if (tileIndex >= 0 && tileIndex <= 9) {  // Bottom row
-                adjustedPosition.y -= 20 * offsetCounter;  // Move players upward on the bottom row
-            } else if (tileIndex >= 10 && tileIndex <= 19) {  // Left column
-                adjustedPosition.x -= 20 * offsetCounter;  // Move players to the left
-            } else if (tileIndex >= 20 && tileIndex <= 29) {  // Top row
-                adjustedPosition.y += 20 * offsetCounter;  // Move players downward on the top row
-            } else if (tileIndex >= 30 && tileIndex <= 39) {  // Right column
-                adjustedPosition.x += 20 * offsetCounter;  // Move players to the right
-            }
+        onTile[player->location]++;
+    }
+    std::vector<int> drawn(tilePositions.size(), 0);
+    for (const auto& player : players) {
+        int tileIndex = player->location;
+        TokenSlot slot = tokenSlot(drawn[tileIndex]++, onTile[tileIndex]);
+        // A lone token sits where it always has, 5px right of and below the tile position
+        sf::Vector2f center(tilePositions[tileIndex].x + 5 + slot.offset.x, tilePositions[tileIndex].y + 5 + slot.offset.y);
+
+        sf::CircleShape playerCircle(slot.radius);
+        playerCircle.setFillColor(player->color);
+        playerCircle.setPosition(center.x - slot.radius, center.y - slot.radius);
+        window.draw(playerCircle);
+    }
+}
 
-            playerCircle.setPosition(adjustedPosition.x - 5, adjustedPosition.y - 5);  // Adjust for center
-            window.draw(playerCircle);
+Game::TokenSlot Game::tokenSlot(int index, int count) {
+    constexpr float kTokenArea = 44.0f;  // Side of the square the tokens share, inside the tile
+    constexpr float kTokenRadius = 10.0f;
+    int columns = 1;
+    while (columns * columns < count) columns++;
+    int rows = count > 0 ? (count + columns - 1) / columns : 1;
+    float cell = std::min(kTokenArea / columns, 2 * kTokenRadius + 2);
+
+    TokenSlot slot;
+    slot.radius = std::min(kTokenRadius, cell / 2 - 1);
+    slot.offset.x = (index % columns - (columns - 1) / 2.0f) * cell;
+    slot.offset.y = (index / columns - (rows - 1) / 2.0f) * cell;
+    return slot;
+}
 
-            offsetCounter++;  // Increase offset for the next player on the same tile
-        }
+sf::Color Game::seatColor(size_t seat) {
+    static const sf::Color kClassic[] = {sf::Color::Red, sf::Color::Blue, sf::Color::Green, sf::Color::Yellow};
+    if (seat < 4) return kClassic[seat];
+
+    // Further seats step the hue by the golden angle, which keeps every new hue far from the ones
+    // before it, and alternate between a bright and a deep shade
+    double hue = std::fmod(30.0 + (seat - 4) * 137.508, 360.0) / 60.0;
+    double value = seat % 2 == 0 ? 0.95 : 0.7;
+    double chroma = value * 0.8;
+    double x = chroma * (1 - std::fabs(std::fmod(hue, 2.0) - 1));
+    double r = 0, g = 0, b = 0;
+    switch (static_cast<int>(hue)) {
+        case 0: r = chroma; g = x; break;
+        case 1: r = x; g = chroma; break;
+        case 2: g = chroma; b = x; break;
+        case 3: g = x; b = chroma; break;
+        case 4: r = x; b = chroma; break;
+        default: r = chroma; b = x; break;
     }
+    double m = value - chroma;
+    return sf::Color(static_cast<sf::Uint8>(255 * (r + m)), static_cast<sf::Uint8>(255 * (g + m)),
+                     static_cast<sf::Uint8>(255 * (b + m)));
 }
 
 
 void Game::initializeBoard() {
 
-    Board& board = Board::getInstance();
     // Bottom row (right to left)
     board.addTile(std::make_shared<StartTile>("Go"), {750, 741});                      // 0
     board.addTile(std::make_shared<StreetTile>("Mediterranean Ave", "Brown", 60, 2), {655, 741});  // 1
@@ -330,6 +610,7 @@ void Game::initializeBoard() {
 
 // Display options for the current player
 void Game::displayPlayerOptions() const {
+    Logger::instance().flush();  // Finish the turn's narration before the menu
     std::cout << "What would you like to do? Enter the corresponding number:\n"
               << "1. Roll Dice\n"
               << "2. View Player Details\n"
@@ -396,6 +677,7 @@ void Game::displayBoard() {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleHeatmapKey(event);
         }
 
         // Clear the window
@@ -427,6 +709,7 @@ void Game::displayPlayerDetails(const std::shared_ptr<Player>& player) const {
 
 // Handle property purchase (either house or hotel) for a player
 void Game::handlePropertyPurchase(const std::shared_ptr<Player>& player, bool isHouse) {
+    Logger::instance().flush();  // Narration so far comes before the prompt we wait on
     std::cout << "Enter the name of the street where you want to " 
               << (isHouse ? "buy a house:" : "buy a hotel:") << std::endl;
     std::string streetName;
@@ -437,18 +720,26 @@ void Game::handlePropertyPurchase(const std::shared_ptr<Player>& player, bool is
         std::cout << "Attempting to " << (isHouse ? "build a house" : "build a hotel") 
                   << " on " << property->getName() << "...\n";
         if (isHouse) {
-            // Ensure player owns all properties in the color group before building
-            if (property->buildHouse(board.getColorGroupProperties(property->getColorGroup()))) {
-                std::cout << "House built successfully on " << property->getName() << "!" << std::endl;
-            } else {
-                std::cout << "Failed to build a house on " << property->getName() << "." << std::endl;
+            int tile = 0;
+            while (tile < board.getTileCount() && board.getTile(tile) != property) ++tile;
+            int opponents = static_cast<int>(players.size()) - 1;
+            double rounds = getPropertyRoi().nextBuildRounds(tile, property->buildingLevel(), opponents);
+            if (rounds < 1e6) {
+                std::cout << "The next building here pays for itself in about " << static_cast<int>(rounds + 0.5)
+                          << " rounds." << std::endl;
             }
+        }
+        // Needs the whole color group; charges the player, or in a shortage the auction's winner
+        StreetTile* site = isHouse ? buildHouse(*property) : buildHotel(*property);
+        Logger::instance().flush();  // The build's own narration first
+        const char* building = isHouse ? "house" : "hotel";
+        if (site == property.get()) {
+            std::cout << (isHouse ? "House" : "Hotel") << " built successfully on " << property->getName() << "!" << std::endl;
+        } else if (site) {
+            std::cout << site->getOwner()->getName() << " won the " << building << " at auction and built on "
+                      << site->getName() << "." << std::endl;
         } else {
-            if (property->buildHotel(board.getColorGroupProperties(property->getColorGroup()))) {
-                std::cout << "Hotel built successfully on " << property->getName() << "!" << std::endl;
-            } else {
-                std::cout << "Failed to build a hotel on " << property->getName() << "." << std::endl;
-            }
+            std::cout << "Failed to build a " << building << " on " << property->getName() << "." << std::endl;
         }
     } else {
         std::cout << "Street not found or not owned by you." << std::endl;
@@ -1,38 +1,115 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include "auction.hpp"
 #include "board.hpp"
 #include "dice.hpp"
+#include "jail.hpp"
 #include "player.hpp"
+#include "propertyRoi.hpp"
 #include "specialTiles.hpp"
+#include "tileStats.hpp"
+#include "cardDeck.hpp"
+#include <random>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <SFML/Graphics.hpp>
 
 class Game {
 private:
+    std::unique_ptr<Board> ownedBoard; // Set when the game runs on its own board instead of the shared one
     Board& board;
     int doubleCount; // To track consecutive doubles
     std::shared_ptr<Dice> dice;  // Use shared_ptr for Dice, allowing MockDice to be injected
+    std::shared_ptr<Dice> randomDice; // Default dice, reused between turns
     std::vector<std::shared_ptr<Player>> players; // Use shared_ptr for players
-    int currentPlayerIndex;
+    std::vector<std::shared_ptr<Player>> seats;   // Every player in seat order, including bankrupt ones
+    std::unordered_map<const Player*, int> seatIndex;  // Seat of each player, for seatOf
+    int currentSeat = 0;                     // Seat whose turn it is
+    std::vector<int> nextSeat;               // Seats still in play form a ring: the next one after each,
+    std::vector<int> previousSeat;           // and the one before; -1 for seats out of the game
     std::pair<int, int> lastDiceRoll;
+    int rollCount = 0;                      // Dice rolls taken so far (doubles count as extra rolls)
+    RandomStream rng;                       // Game randomness other than the dice (card shuffles)
+    CardDeck chanceDeck;                    // Shared by the three Chance tiles
+    CardDeck communityChestDeck;            // Shared by the three Community Chest tiles
+    TileCounts tileCounts;                  // Landings, purchases, rent and card draws per tile
+    bool heatmapVisible = false;
+    TileMetric heatmapMetric = TileMetric::Landings;
+    const TileCounts* heatmapCounts = nullptr; // Counts shown by the heatmap; this game's own when null
+    AuctionMode auctionMode = AuctionMode::Off;
+    std::vector<Bidder*> bidders;            // Per seat; null for the default bidder
+    std::vector<AuctionEntrant> entrants;    // Reused by every auction
+    std::vector<JailPolicy*> jailPolicies;   // Per seat; null for the default policy
+    std::unique_ptr<PropertyRoi> propertyRoi; // Built on first use
+
+    // The strategy a seat bids with (its own, or the default)
+    Bidder* bidderFor(int seat) const { return seat >= 0 && bidders[seat] ? bidders[seat] : &auction::defaultBidder(); }
+
+    // Run an auction among `entrants` under the game's auction mode (sealed when off)
+    AuctionResult runAuction(const AuctionLot& lot) const;
+
+    // The street of the player's where a house (or a hotel) can go next under the building rules,
+    // null if none
+    StreetTile* nextBuildingSite(const Player& player, bool hotel) const;
+
+    // buildHouse and buildHotel
+    StreetTile* placeBuilding(StreetTile& street, bool hotel);
+
+    // A jailed player's turn after the roll: pay, play the card or try for doubles, as their policy
+    // chooses (jail::kSteps). False if the player stays in jail or goes bankrupt paying the fee;
+    // `keepsTurn` is cleared when the way out gives no extra turn.
+    bool leaveJail(const std::shared_ptr<Player>& player, bool isDouble, bool& keepsTurn);
+
+    // The current player went bankrupt: take them out and pass the turn on
+    void endBankruptTurn(const std::shared_ptr<Player>& player);
+
+    // Seat of a player, -1 if not seated here
+    int seatOf(const Player* player) const;
+
+    // Link the seats of `players` into the turn ring
+    void linkSeats();
 
 public:
     // Constructor
    Game(const std::vector<std::shared_ptr<Player>>& playerList)
-    : board(Board::getInstance()), players(playerList), currentPlayerIndex(0), doubleCount(0), dice(std::make_shared<Dice>()) {
-    // Available player colors (add more as needed)
-    std::vector<sf::Color> playerColors = {sf::Color::Red, sf::Color::Blue, sf::Color::Green, sf::Color::Yellow};
+    : Game(playerList, nullptr) {}
+
+    // Constructor for a game played on its own board (simulations running many games at once)
+   Game(const std::vector<std::shared_ptr<Player>>& playerList, std::unique_ptr<Board> ownBoard)
+    : ownedBoard(std::move(ownBoard)), board(ownedBoard ? *ownedBoard : Board::getInstance()), doubleCount(0), dice(std::make_shared<Dice>()), players(playerList), seats(playerList),
+      rng(std::random_device{}()), chanceDeck(CardDeck::standardChance()), communityChestDeck(CardDeck::standardCommunityChest()),
+      bidders(playerList.size(), nullptr), jailPolicies(playerList.size(), nullptr) {
+    randomDice = dice;
+    for (size_t i = 0; i < seats.size(); ++i) {
+        seatIndex.emplace(seats[i].get(), static_cast<int>(i));
+    }
+    linkSeats();
+    entrants.reserve(playerList.size());
+    chanceDeck.shuffle(rng);
+    communityChestDeck.shuffle(rng);
 
-    // Assuming players are initialized as follows:
     for (size_t i = 0; i < players.size(); ++i) {
-        players[i]->setColor(playerColors[i % playerColors.size()]);
+        players[i]->setColor(seatColor(i));
+    }
+
     }
 
+    // Players and the tiles they own point at each other; on a game's own board, break those
+    // cycles so a finished game frees its players and tiles
+    ~Game() {
+        if (ownedBoard) {
+            for (int i = 0; i < ownedBoard->getTileCount(); ++i) {
+                ownedBoard->getTile(i)->setOwner(nullptr);
+            }
+        }
     }
 
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
+
     // Play a turn for the current player
     void playTurn();
 
@@ -51,16 +128,14 @@ public:
     Board& getBoard() {
         return board;
     }
+    const Board& getBoard() const { return board; }
 
-    // Check and remove bankrupt players
-    void checkBankruptcy() {
-        players.erase(std::remove_if(players.begin(), players.end(),
-            [](const std::shared_ptr<Player>& player) { return player->isBankrupt(); }),
-            players.end());
-    }
+    // Take bankrupt players out of the turn order. Unlinking a seat is O(1); when it is the current
+    // seat, the turn passes to the next seat still in play. Jail cards still held go back to their decks.
+    void checkBankruptcy();
 
     std::shared_ptr<Player> getCurrentPlayer() const {
-        return players[currentPlayerIndex];
+        return seats[currentSeat];
     }
 
     std::shared_ptr<Tile> getTile(int index) const {
@@ -68,11 +143,24 @@ public:
     }
     
 
+    // Token colour of a seat: red, blue, green and yellow, then generated hues, distinct for 16 seats
+    static sf::Color seatColor(size_t seat);
+
+    // Where the index-th of `count` tokens on one tile is drawn, relative to where a lone token goes:
+    // a square grid that shrinks the tokens to fit
+    struct TokenSlot {
+        sf::Vector2f offset;
+        float radius = 10.0f;
+    };
+    static TokenSlot tokenSlot(int index, int count);
+
     sf::Vector2f getTilePosition(int tileIndex, double tileSize, int cornerTileSize);
     void displayBoard();
     void drawPlayers(sf::RenderWindow &window, const std::vector<std::shared_ptr<Player>>& players);
     void drawBoard(sf::RenderWindow& window);
     void drawStar(sf::RenderWindow &window, const sf::Vector2f &position, int tileIndex, sf::Color color);
+    void drawHeatmap(sf::RenderWindow &window, const std::vector<sf::Vector2f> &tilePositions);
+    void handleHeatmapKey(const sf::Event& event);
     void initializeBoard();
 
     // Use shared_ptr to set the Dice
@@ -80,6 +168,116 @@ public:
     this->dice = customDice;
     }
 
+    // Reseed the default dice so a game can be replayed exactly
+    void seedDice(uint32_t seed) {
+        randomDice = std::make_shared<Dice>(seed);
+        dice = randomDice;
+    }
+
+    // Reseed the dice and the card shuffles, and reshuffle both decks, so a game can be replayed exactly
+    void seed(uint32_t seed) {
+        seedDice(seed);
+        rng.seed(seed ^ 0x9E3779B9u);  // Keep the card stream distinct from the dice stream
+        chanceDeck.shuffle(rng);
+        communityChestDeck.shuffle(rng);
+    }
+
+    RandomStream& getRandom() { return rng; }
+    const RandomStream& getRandom() const { return rng; }
+    CardDeck& getChanceDeck() { return chanceDeck; }
+    CardDeck& getCommunityChestDeck() { return communityChestDeck; }
+    const CardDeck& getChanceDeck() const { return chanceDeck; }
+    const CardDeck& getCommunityChestDeck() const { return communityChestDeck; }
+
+    // Play a held Get Out of Jail Free card; the card goes back to the deck it came from
+    bool useGetOutOfJailCard(const std::shared_ptr<Player>& player) {
+        if (!player->hasGetOutOfJailFreeCard()) return false;
+        DeckKind from = player->useGetOutOfJailCard();
+        (from == DeckKind::Chance ? chanceDeck : communityChestDeck).returnHeldCard();
+        return true;
+    }
+
+    // How properties a player lands on and does not buy are auctioned (off by default)
+    void setAuctionMode(AuctionMode mode) { auctionMode = mode; }
+    AuctionMode getAuctionMode() const { return auctionMode; }
+
+    // The strategy a seat bids with; null restores the default (auction::defaultBidder). Not owned.
+    void setBidder(int seat, Bidder* bidder) {
+        if (seat >= 0 && seat < static_cast<int>(bidders.size())) bidders[seat] = bidder;
+    }
+
+    // How a seat plays its turns in jail; null restores the default (jail::defaultPolicy). Not owned.
+    void setJailPolicy(int seat, JailPolicy* policy) {
+        if (seat >= 0 && seat < static_cast<int>(jailPolicies.size())) jailPolicies[seat] = policy;
+    }
+
+    // Auction an unowned property among the players still in the game, starting with the current
+    // player. Called from the unowned branch of the property tiles' onLand. True if it was sold.
+    bool auctionProperty(const std::shared_ptr<Tile>& property, int listPrice, int tileIndex);
+
+    // Build a house on a street for its owner, who pays the house cost; the owner needs the whole
+    // color group. In a housing shortage (the bank has fewer houses left than there are players who
+    // could build one) the house is auctioned among those players instead, and goes on the winner's
+    // next street in line. Returns the street the house went up on: `street`, another player's street
+    // when they won the auction, or null if none was built.
+    StreetTile* buildHouse(StreetTile& street) { return placeBuilding(street, false); }
+
+    // Build a hotel on a street for its owner, who pays the hotel cost less the four houses it
+    // replaces. A shortage of hotels is auctioned the same way as one of houses.
+    StreetTile* buildHotel(StreetTile& street) { return placeBuilding(street, true); }
+
+    // Payback of buying and building on each street, from this game's board and decks. Built on the
+    // first call, then every query is a lookup.
+    const PropertyRoi& getPropertyRoi();
+
+    // Players still in the game
+    const std::vector<std::shared_ptr<Player>>& getPlayers() const { return players; }
+
+    // All players in their original seat order; seats never move when someone goes bankrupt
+    const std::vector<std::shared_ptr<Player>>& getSeats() const { return seats; }
+
+    // Seat of the player whose turn it is, -1 once nobody is left
+    int getCurrentSeat() const { return players.empty() ? -1 : currentSeat; }
+
+    int getRollCount() const { return rollCount; }
+    int getDoubleCount() const { return doubleCount; }
+
+    // Place of the current player in getPlayers() (for saves)
+    int getCurrentPlayerIndex() const {
+        auto it = std::find(players.begin(), players.end(), seats[currentSeat]);
+        return it == players.end() ? 0 : static_cast<int>(it - players.begin());
+    }
+
+    // The game's own random dice (not a mock set with setDice)
+    Dice& getRandomDice() { return *randomDice; }
+    const Dice& getRandomDice() const { return *randomDice; }
+
+    // Put back the turn position of a saved game: who is still playing, whose turn it is and
+    // the doubles streak. `inPlay` must be a subset of the seats, in seat order.
+    void restoreProgress(const std::vector<std::shared_ptr<Player>>& inPlay, int playerIndex, int doubles, int rolls,
+                         std::pair<int, int> lastRoll) {
+        players = inPlay;
+        linkSeats();
+        if (playerIndex >= 0 && playerIndex < static_cast<int>(players.size())) currentSeat = seatOf(players[playerIndex].get());
+        doubleCount = doubles;
+        rollCount = rolls;
+        lastDiceRoll = lastRoll;
+        dice.reset();
+    }
+
+    // Per-tile counters, updated by the tiles' onLand and the cards
+    TileCounts& getTileCounts() { return tileCounts; }
+    const TileCounts& getTileCounts() const { return tileCounts; }
+
+    // Shade each tile in drawBoard by a metric. `counts` (e.g. a TileHeatmap snapshot over many
+    // games) must outlive the game; without it the heatmap shows this game's counters.
+    void showHeatmap(TileMetric metric, const TileCounts* counts = nullptr) {
+        heatmapVisible = true;
+        heatmapMetric = metric;
+        heatmapCounts = counts;
+    }
+    void hideHeatmap() { heatmapVisible = false; }
+
     std::shared_ptr<Dice> rollDice() {
     return std::make_shared<Dice>();
     }
@@ -0,0 +1,261 @@
+#include "gameSave.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+void putU16(uint8_t* at, uint16_t value) {
+    at[0] = static_cast<uint8_t>(value);
+    at[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putU32(uint8_t* at, uint32_t value) {
+    for (int i = 0; i < 4; ++i) at[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+void putU64(uint8_t* at, uint64_t value) {
+    for (int i = 0; i < 8; ++i) at[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint16_t getU16(const uint8_t* at) {
+    return static_cast<uint16_t>(at[0] | at[1] << 8);
+}
+
+uint32_t getU32(const uint8_t* at) {
+    return static_cast<uint32_t>(at[0]) | static_cast<uint32_t>(at[1]) << 8 |
+           static_cast<uint32_t>(at[2]) << 16 | static_cast<uint32_t>(at[3]) << 24;
+}
+
+uint64_t getU64(const uint8_t* at) {
+    return static_cast<uint64_t>(getU32(at)) | static_cast<uint64_t>(getU32(at + 4)) << 32;
+}
+
+std::runtime_error badSave(const std::string& what) {
+    return std::runtime_error("saved game: " + what);
+}
+
+void saveDeck(const CardDeck& deck, uint8_t* at) {
+    const DeckState& state = deck.state();
+    at[0] = static_cast<uint8_t>(state.order.size());
+    at[1] = static_cast<uint8_t>(state.cursor);
+    putU32(at + 4, state.held);
+    std::copy(state.order.begin(), state.order.end(), at + 8);
+}
+
+void loadDeck(CardDeck& deck, const uint8_t* at) {
+    DeckState state;
+    int size = at[0];
+    if (size != deck.size() || at[1] > size) throw badSave("deck does not match the board's cards");
+    state.order.assign(at + 8, at + 8 + size);
+    for (uint8_t card : state.order) {
+        if (card >= size) throw badSave("deck order out of range");
+    }
+    state.cursor = at[1];
+    state.held = getU32(at + 4);
+    deck.restore(state);
+}
+
+} // namespace
+
+namespace gameSave {
+
+size_t savedSize(int seatCount, int tileCount) {
+    return kHeaderBytes + seatCount * kSeatBytes + tileCount * kTileBytes + 2 * kDeckBytes;
+}
+
+void save(const Game& game, std::vector<uint8_t>& out) {
+    const auto& seats = game.getSeats();
+    const auto& inPlay = game.getPlayers();
+    const Board& board = game.getBoard();
+    int seatCount = static_cast<int>(seats.size());
+    int tileCount = board.getTileCount();
+    if (seatCount > 255) throw badSave("too many seats");
+
+    size_t start = out.size();
+    size_t total = savedSize(seatCount, tileCount);
+    out.resize(start + total, 0);
+    uint8_t* at = out.data() + start;
+
+    putU32(at, kMagic);
+    putU16(at + 4, kVersion);
+    at[6] = static_cast<uint8_t>(seatCount);
+    at[7] = static_cast<uint8_t>(tileCount);
+    at[8] = static_cast<uint8_t>(game.getCurrentPlayerIndex());
+    at[9] = static_cast<uint8_t>(game.getDoubleCount());
+    at[10] = static_cast<uint8_t>(game.getDiceRoll().first);
+    at[11] = static_cast<uint8_t>(game.getDiceRoll().second);
+    putU32(at + 12, static_cast<uint32_t>(game.getRollCount()));
+    putU32(at + 16, game.getRandomDice().getStream().getSeed());
+    putU32(at + 20, game.getRandom().getSeed());
+    putU64(at + 24, game.getRandomDice().getStream().getDraws());
+    putU64(at + 32, game.getRandom().getDraws());
+    putU32(at + 40, static_cast<uint32_t>(total));
+    at += kHeaderBytes;
+
+    for (const auto& player : seats) {
+        std::string name = player->getName().substr(0, kMaxNameBytes);
+        at[0] = static_cast<uint8_t>(name.size());
+        std::memcpy(at + 1, name.data(), name.size());
+        putU32(at + 24, static_cast<uint32_t>(player->getMoney()));
+        at[28] = static_cast<uint8_t>(player->getLastDiceRoll());
+        at[29] = static_cast<uint8_t>(player->getPosition());
+        at[30] = (std::find(inPlay.begin(), inPlay.end(), player) != inPlay.end() ? InPlay : 0) |
+                 (player->isInJail() ? InJail : 0) |
+                 (player->hasGetOutOfJailFreeCard() ? HoldsJailCard : 0);
+        at[31] = static_cast<uint8_t>(player->getJailTurns());
+        at[32] = static_cast<uint8_t>(player->getNumberOfUtilities());
+        at[33] = player->getJailCards()[0];
+        at[34] = player->getJailCards()[1];
+        at += kSeatBytes;
+    }
+
+    for (int t = 0; t < tileCount; ++t, at += kTileBytes) {
+        auto tile = board.getTile(t);
+        at[3] = 0xFF;
+        auto seat = std::find(seats.begin(), seats.end(), tile->getOwner());
+        if (tile->getOwner() && seat != seats.end()) {
+            at[0] = static_cast<uint8_t>(seat - seats.begin() + 1);
+            const auto& owned = (*seat)->getProperties();
+            auto place = std::find(owned.begin(), owned.end(), tile);
+            if (place != owned.end()) at[3] = static_cast<uint8_t>(place - owned.begin());
+        }
+        if (board.getTileKind(t) == TileKind::Street) {
+            const auto& street = static_cast<const StreetTile&>(*tile);
+            at[1] = static_cast<uint8_t>(street.getHouseCount());
+            at[2] = street.isHotelBuilt() ? TileHotel : 0;
+        }
+        if (tile->isMortgaged()) at[2] |= TileMortgaged;
+    }
+
+    saveDeck(game.getChanceDeck(), at);
+    saveDeck(game.getCommunityChestDeck(), at + kDeckBytes);
+}
+
+std::unique_ptr<Game> load(const uint8_t* data, size_t size) {
+    if (size < kHeaderBytes || getU32(data) != kMagic) throw badSave("not a saved game");
+    uint16_t version = getU16(data + 4);
+    if (version < kOldestVersion || version > kVersion) throw badSave("unsupported version " + std::to_string(version));
+    int seatCount = data[6];
+    int tileCount = data[7];
+    size_t total = getU32(data + 40);
+    if (seatCount == 0 || total != savedSize(seatCount, tileCount) || size < total) throw badSave("truncated");
+
+    auto board = Board::create();
+    if (tileCount != board->getTileCount()) throw badSave("board size does not match");
+
+    // Seats, with the fields that don't depend on properties
+    std::vector<std::shared_ptr<Player>> seats;
+    const uint8_t* seatAt = data + kHeaderBytes;
+    size_t inPlayCount = 0;
+    for (int i = 0; i < seatCount; ++i) {
+        const uint8_t* at = seatAt + i * kSeatBytes;
+        if (at[0] > kMaxNameBytes) throw badSave("seat name too long");
+        seats.push_back(std::make_shared<Player>(std::string(reinterpret_cast<const char*>(at + 1), at[0]), 0));
+        inPlayCount += at[30] & InPlay;
+    }
+    if (data[8] >= std::max<size_t>(inPlayCount, 1)) throw badSave("current player out of range");
+
+    // Buildings first, so each owner's asset totals pick them up as the properties are re-added
+    const uint8_t* tileAt = seatAt + seatCount * kSeatBytes;
+    std::vector<std::vector<std::pair<int, std::shared_ptr<Tile>>>> owned(seatCount);
+    for (int t = 0; t < tileCount; ++t) {
+        const uint8_t* at = tileAt + t * kTileBytes;
+        auto tile = board->getTile(t);
+        bool hotel = at[2] & TileHotel;
+        bool mortgaged = at[2] & TileMortgaged;
+        if (at[2] & ~(TileHotel | TileMortgaged) || at[1] > 4 || (at[1] > 0 && hotel) || (mortgaged && (at[1] || hotel))) {
+            throw badSave("bad buildings on tile " + std::to_string(t));
+        }
+        if (board->getTileKind(t) == TileKind::Street) {
+            static_cast<StreetTile&>(*tile).restoreBuildings(at[1], hotel);
+        } else if (at[1] || hotel) {
+            throw badSave("buildings on a tile that is not a street");
+        }
+        if (mortgaged && at[0] == 0) throw badSave("mortgaged tile without an owner");
+        tile->setMortgaged(mortgaged);
+        if (at[0] == 0) continue;
+        if (at[0] > seatCount) throw badSave("tile owner out of range");
+        tile->setOwner(seats[at[0] - 1]);
+        if (at[3] != 0xFF) owned[at[0] - 1].push_back({at[3], tile});
+    }
+
+    const uint8_t* deckAt = tileAt + tileCount * kTileBytes;
+    std::vector<std::shared_ptr<Player>> inPlay;
+    for (int i = 0; i < seatCount; ++i) {
+        const uint8_t* at = seatAt + i * kSeatBytes;
+        std::sort(owned[i].begin(), owned[i].end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto& entry : owned[i]) {
+            seats[i]->acquireProperty(entry.second);
+        }
+        std::array<uint8_t, kDeckKinds> jailCards{{at[33], at[34]}};
+        if (version < 3 && (at[30] & HoldsJailCard)) {
+            jailCards[getU32(deckAt + 4) != 0 ? 0 : 1] = 1;  // Chance, unless only Community Chest has a card out
+        }
+        seats[i]->restoreState(static_cast<int32_t>(getU32(at + 24)), at[29] % tileCount, at[30] & InJail, at[31],
+                               at[28], at[32], jailCards);
+        if (at[30] & InPlay) inPlay.push_back(seats[i]);
+    }
+
+    auto game = std::make_unique<Game>(seats, std::move(board));
+    game->restoreProgress(inPlay, data[8], data[9], static_cast<int>(getU32(data + 12)), {data[10], data[11]});
+    game->getRandomDice().restoreStream(getU32(data + 16), getU64(data + 24));
+    game->getRandom().restore(getU32(data + 20), getU64(data + 32));
+
+    loadDeck(game->getChanceDeck(), deckAt);
+    loadDeck(game->getCommunityChestDeck(), deckAt + kDeckBytes);
+    return game;
+}
+
+void writeFile(const std::vector<uint8_t>& data, const std::string& path) {
+    std::string temporary = path + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) throw badSave("cannot write " + temporary + ": " + std::strerror(errno));
+    bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = std::fflush(file) == 0 && written;
+    written = ::fsync(::fileno(file)) == 0 && written;
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw badSave("cannot write " + path + ": " + std::strerror(errno));
+    }
+}
+
+void saveFile(const Game& game, const std::string& path) {
+    std::vector<uint8_t> data;
+    save(game, data);
+    writeFile(data, path);
+}
+
+std::unique_ptr<Game> loadFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw badSave("cannot open " + path + ": " + std::strerror(errno));
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        throw badSave("cannot read " + path);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw badSave("cannot map " + path + ": " + std::strerror(errno));
+
+    try {
+        auto game = load(static_cast<const uint8_t*>(mapping), size);
+        ::munmap(mapping, size);
+        return game;
+    } catch (...) {
+        ::munmap(mapping, size);
+        throw;
+    }
+}
+
+} // namespace gameSave
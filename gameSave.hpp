@@ -0,0 +1,67 @@
+#ifndef GAME_SAVE_HPP
+#define GAME_SAVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Game;
+
+// Saved games in a fixed-layout, versioned binary format. Every record has a fixed size and
+// offset, so a save can be read straight out of a memory-mapped file without parsing.
+//
+// Layout (little-endian):
+//   header, kHeaderBytes:
+//     u32 magic "MNPS" | u16 version | u8 seatCount | u8 tileCount
+//     u8 currentPlayerIndex | u8 doubleCount | u8 lastRoll.first | u8 lastRoll.second
+//     u32 rollCount | u32 diceSeed | u32 cardSeed | u64 diceDraws | u64 cardDraws
+//     u32 total size | u32 reserved
+//   seatCount x seat, kSeatBytes:
+//     u8 name length | 23 bytes name | i32 money | u8 lastDiceRoll | u8 position
+//     u8 flags (InPlay, InJail, HoldsJailCard) | u8 jailTurns | u8 utilities
+//     u8 Get Out of Jail Free cards from Chance | u8 from Community Chest | 1 byte reserved
+//     (version 3; older saves only set HoldsJailCard and the card is put down to the deck holding one)
+//   tileCount x tile, kTileBytes:
+//     u8 owner seat + 1 | u8 houses | u8 flags (TileHotel, TileMortgaged) | u8 place in the owner's property list
+//     (0xFF if not listed). Version 1 saves predate mortgages and only use TileHotel.
+//   Chance deck, then Community Chest deck, kDeckBytes each:
+//     u8 size | u8 cursor | u16 reserved | u32 held mask | 32 bytes draw order
+//
+// Random streams are stored as seed and draw count (see RandomStream). Tile statistics and
+// injected mock dice are not part of a save.
+namespace gameSave {
+
+constexpr uint32_t kMagic = 0x53504E4D;  // "MNPS"
+constexpr uint16_t kVersion = 3;
+constexpr uint16_t kOldestVersion = 1;   // Oldest version load() still reads
+constexpr size_t kHeaderBytes = 48;
+constexpr size_t kSeatBytes = 36;
+constexpr size_t kTileBytes = 4;
+constexpr size_t kDeckBytes = 40;
+constexpr size_t kMaxNameBytes = 23;  // Longer names are cut short
+
+enum SeatFlag : uint8_t { InPlay = 1, InJail = 2, HoldsJailCard = 4 };
+enum TileFlag : uint8_t { TileHotel = 1, TileMortgaged = 2 };
+
+// Bytes taken by a save with this many seats and tiles
+size_t savedSize(int seatCount, int tileCount);
+
+// Append the game to `out`
+void save(const Game& game, std::vector<uint8_t>& out);
+
+// Rebuild a saved game on its own standard board. Throws std::runtime_error if the data is
+// truncated, from a version it does not know, or does not fit the board.
+std::unique_ptr<Game> load(const uint8_t* data, size_t size);
+
+// Write to `path` through a temporary file and a rename, so a crash never leaves a half-written save
+void saveFile(const Game& game, const std::string& path);
+void writeFile(const std::vector<uint8_t>& data, const std::string& path);
+
+// Map `path` and load from the mapping
+std::unique_ptr<Game> loadFile(const std::string& path);
+
+} // namespace gameSave
+
+#endif // GAME_SAVE_HPP
@@ -0,0 +1,570 @@
+#include "gameServer.hpp"
+#include "game.hpp"
+#include "gameSave.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using protocol::Op;
+using protocol::ReplyStatus;
+
+namespace {
+
+std::runtime_error socketError(const char* what) {
+    return std::runtime_error(std::string(what) + ": " + std::strerror(errno));
+}
+
+constexpr uint32_t kCheckpointMagic = 0x54504E4D;  // "MNPT"
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void patchU32(std::vector<uint8_t>& out, size_t at, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out[at + i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+// Bounds-checked reads over a checkpoint
+struct CheckpointReader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+
+    uint32_t u32() {
+        if (size - offset < 4) throw std::runtime_error("checkpoint: truncated");
+        const uint8_t* at = data + offset;
+        offset += 4;
+        return static_cast<uint32_t>(at[0]) | static_cast<uint32_t>(at[1]) << 8 |
+               static_cast<uint32_t>(at[2]) << 16 | static_cast<uint32_t>(at[3]) << 24;
+    }
+};
+
+} // namespace
+
+TableHost::TableHost(size_t maxTables) : maxTables(maxTables) {}
+
+TableHost::~TableHost() = default;
+
+TableHost::Table* TableHost::find(uint32_t id) {
+    uint32_t slot = id & ((1u << kSlotBits) - 1);
+    if (slot >= slots.size()) return nullptr;
+    Slot& entry = slots[slot];
+    if (!entry.table || entry.generation != id >> kSlotBits) return nullptr;
+    return entry.table.get();
+}
+
+protocol::Response TableHost::handle(const protocol::Request& request, int client) {
+    protocol::Response response;
+    response.op = request.op;
+    response.table = request.table;
+
+    if (request.op == Op::CreateTable) {
+        return createTable(request);
+    }
+
+    Table* table = find(request.table);
+    if (!table) {
+        response.status = ReplyStatus::UnknownTable;
+        return response;
+    }
+
+    switch (request.op) {
+        case Op::Roll:
+            if (table->game->getPlayers().size() <= 1) {
+                response.status = ReplyStatus::GameOver;
+            } else {
+                table->game->playTurn();
+            }
+            break;
+
+        case Op::Buy:
+            response.status = buy(*table, request);
+            break;
+
+        case Op::Build:
+            response.status = build(*table, request);
+            break;
+
+        case Op::Status:
+            break;
+
+        case Op::Subscribe:
+            response.status = subscribe(*table, request.table, client);
+            break;
+
+        case Op::Unsubscribe:
+            unsubscribe(request.table, client);
+            break;
+
+        case Op::CloseTable: {
+            uint32_t slot = request.table & ((1u << kSlotBits) - 1);
+            slots[slot].table.reset();
+            slots[slot].generation = (slots[slot].generation + 1) & ((1u << (32 - kSlotBits)) - 1);
+            freeSlots.push_back(slot);
+            openTables--;
+            return response;
+        }
+
+        default:
+            response.status = ReplyStatus::BadRequest;
+            return response;
+    }
+
+    bool move = request.op == Op::Roll || request.op == Op::Buy || request.op == Op::Build;
+    if (move && sink && !table->spectators.empty()) {
+        publish(*table, request.table);  // Unwatched tables skip the capture; a new spectator starts from a keyframe
+    }
+    describe(*table, response);
+    return response;
+}
+
+// Send what changed since the last update to every spectator of the table
+void TableHost::publish(Table& table, uint32_t id) {
+    update.clear();
+    if (!table.encoder.encodeTurn(*table.game, update)) return;
+    for (int spectator : table.spectators) {
+        sink->sendUpdate(spectator, id, update.data(), update.size());
+    }
+}
+
+protocol::ReplyStatus TableHost::subscribe(Table& table, uint32_t id, int client) {
+    if (client < 0 || !sink) return ReplyStatus::BadRequest;
+    // Bring the current spectators up to date first, so the keyframe is the state they also hold
+    publish(table, id);
+    update.clear();
+    table.encoder.encodeKeyframe(update);
+    sink->sendUpdate(client, id, update.data(), update.size());
+    if (std::find(table.spectators.begin(), table.spectators.end(), client) == table.spectators.end()) {
+        table.spectators.push_back(client);
+    }
+    return ReplyStatus::Ok;
+}
+
+void TableHost::unsubscribe(uint32_t id, int client) {
+    Table* table = find(id);
+    if (!table) return;
+    auto& spectators = table->spectators;
+    spectators.erase(std::remove(spectators.begin(), spectators.end(), client), spectators.end());
+}
+
+protocol::Response TableHost::createTable(const protocol::Request& request) {
+    protocol::Response response;
+    response.op = Op::CreateTable;
+
+    int numPlayers = request.seat;
+    if (numPlayers < 2 || numPlayers > protocol::kMaxSeats) {
+        response.status = ReplyStatus::BadRequest;
+        return response;
+    }
+    if (openTables >= maxTables) {
+        response.status = ReplyStatus::ServerFull;
+        return response;
+    }
+
+    auto table = std::make_unique<Table>();
+    for (int i = 0; i < numPlayers; ++i) {
+        table->seats.push_back(std::make_shared<Player>("Seat " + std::to_string(i + 1), 1500));
+    }
+    table->game = std::make_unique<Game>(table->seats, Board::create());
+    table->game->seed(request.arg);
+
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[slot].table = std::move(table);
+    openTables++;
+
+    response.table = slot | slots[slot].generation << kSlotBits;
+    describe(*slots[slot].table, response);
+    return response;
+}
+
+protocol::ReplyStatus TableHost::buy(Table& table, const protocol::Request& request) {
+    if (request.seat >= table.seats.size()) return ReplyStatus::BadRequest;
+    auto& player = table.seats[request.seat];
+    if (player->isBankrupt()) return ReplyStatus::NotAllowed;
+
+    int position = player->getPosition();
+    auto tile = table.game->getTile(position);
+    const std::string& type = tile->getTileType();
+    if (tile->isOccupied() || (type != "Street" && type != "Railroad" && type != "Utility")) {
+        return ReplyStatus::NotAllowed;
+    }
+    if (player->getMoney() < Player::purchasePrice(tile)) return ReplyStatus::NotAllowed;
+
+    player->buyProperty(tile);
+    table.game->getTileCounts().recordPurchase(position);
+    return ReplyStatus::Ok;
+}
+
+protocol::ReplyStatus TableHost::build(Table& table, const protocol::Request& request) {
+    if (request.seat >= table.seats.size()) return ReplyStatus::BadRequest;
+    auto& player = table.seats[request.seat];
+    auto street = std::dynamic_pointer_cast<StreetTile>(table.game->getTile(request.tile));
+    if (!street || street->getOwner() != player) return ReplyStatus::NotAllowed;
+
+    // The game checks the color group, the cash and the bank's stock, and charges the owner. In a
+    // shortage another seat may win the building at auction, which leaves this seat's street as it was.
+    bool hotel = request.flags & protocol::BuildHotel;
+    StreetTile* site = hotel ? table.game->buildHotel(*street) : table.game->buildHouse(*street);
+    return site == street.get() ? ReplyStatus::Ok : ReplyStatus::NotAllowed;
+}
+
+void TableHost::describe(const Table& table, protocol::Response& response) const {
+    const Game& game = *table.game;
+    response.rolls = static_cast<uint32_t>(game.getRollCount());
+    response.seatCount = static_cast<uint8_t>(table.seats.size());
+    if (game.getPlayers().size() <= 1 && response.status == ReplyStatus::Ok && response.op == Op::Roll) {
+        response.status = ReplyStatus::GameOver;  // This roll ended the game
+    }
+
+    response.currentSeat = static_cast<uint8_t>(std::max(game.getCurrentSeat(), 0));
+    for (size_t i = 0; i < table.seats.size(); ++i) {
+        const Player& player = *table.seats[i];
+        protocol::SeatState& seat = response.seats[i];
+        seat.money = player.getMoney();
+        seat.position = static_cast<uint8_t>(player.getPosition());
+        seat.flags = (player.isBankrupt() ? protocol::Bankrupt : 0) |
+                     (player.isInJail() ? protocol::InJail : 0) |
+                     (player.hasGetOutOfJailFreeCard() ? protocol::HoldsJailCard : 0);
+        seat.houses = static_cast<uint8_t>(player.getHouseCount());
+        seat.hotels = static_cast<uint8_t>(player.getHotelCount());
+    }
+}
+
+void TableHost::saveTables(std::vector<uint8_t>& out) const {
+    putU32(out, kCheckpointMagic);
+    putU32(out, static_cast<uint32_t>(slots.size()));
+    for (const Slot& slot : slots) {
+        putU32(out, slot.generation);
+    }
+    putU32(out, static_cast<uint32_t>(openTables));
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (!slots[i].table) continue;
+        putU32(out, static_cast<uint32_t>(i));
+        size_t lengthAt = out.size();
+        putU32(out, 0);
+        gameSave::save(*slots[i].table->game, out);
+        patchU32(out, lengthAt, static_cast<uint32_t>(out.size() - lengthAt - 4));
+    }
+}
+
+void TableHost::restoreTables(const uint8_t* data, size_t size) {
+    CheckpointReader in{data, size};
+    if (in.u32() != kCheckpointMagic) throw std::runtime_error("checkpoint: not a table checkpoint");
+    uint32_t slotCount = in.u32();
+    if (slotCount > size / 4 || slotCount > (1u << kSlotBits)) throw std::runtime_error("checkpoint: truncated");
+
+    std::vector<Slot> restored(slotCount);
+    for (Slot& slot : restored) {
+        slot.generation = in.u32();
+    }
+    uint32_t tableCount = in.u32();
+    for (uint32_t t = 0; t < tableCount; ++t) {
+        uint32_t slot = in.u32();
+        uint32_t bytes = in.u32();
+        if (slot >= slotCount || restored[slot].table) throw std::runtime_error("checkpoint: bad table slot");
+        if (bytes > size - in.offset) throw std::runtime_error("checkpoint: truncated");
+
+        auto table = std::make_unique<Table>();
+        table->game = gameSave::load(data + in.offset, bytes);
+        table->seats = table->game->getSeats();
+        restored[slot].table = std::move(table);
+        in.offset += bytes;
+    }
+
+    slots = std::move(restored);
+    freeSlots.clear();
+    for (uint32_t slot = slotCount; slot-- > 0;) {
+        if (!slots[slot].table) freeSlots.push_back(slot);
+    }
+    openTables = tableCount;
+}
+
+GameServer::GameServer(size_t maxTables) : tables(maxTables) {
+    tables.setUpdateSink(this);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) throw socketError("epoll_create1");
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) throw socketError("eventfd");
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+GameServer::~GameServer() {
+    for (auto& connection : connections) {
+        if (connection) ::close(connection->fd);
+    }
+    for (int listener : listeners) {
+        ::close(listener);
+    }
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+    }
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+void GameServer::addListener(int fd) {
+    if (::listen(fd, SOMAXCONN) < 0) {
+        auto error = socketError("listen");
+        ::close(fd);
+        throw error;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    listeners.push_back(fd);
+}
+
+void GameServer::listenUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw socketError("socket");
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        auto error = socketError("bind");
+        ::close(fd);
+        throw error;
+    }
+    addListener(fd);
+    unixPath = path;
+}
+
+uint16_t GameServer::listenTcp(uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw socketError("socket");
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        auto error = socketError("bind");
+        ::close(fd);
+        throw error;
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    addListener(fd);
+    return ntohs(address.sin_port);
+}
+
+void GameServer::run() {
+    while (pollOnce(-1)) {
+    }
+}
+
+bool GameServer::pollOnce(int timeoutMs) {
+    if (stopping.load(std::memory_order_acquire)) return false;
+    QuietOutput quiet;  // Narration from thousands of tables would swamp the log
+
+    epoll_event events[256];
+    int count = ::epoll_wait(epollFd, events, 256, timeoutMs);
+    if (count < 0) {
+        if (errno == EINTR) return !stopping.load(std::memory_order_acquire);
+        throw socketError("epoll_wait");
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int fd = events[i].data.fd;
+        if (fd == wakeFd) {
+            uint64_t value;
+            while (::read(wakeFd, &value, sizeof(value)) > 0) {
+            }
+            continue;
+        }
+        if (std::find(listeners.begin(), listeners.end(), fd) != listeners.end()) {
+            acceptClients(fd);
+            continue;
+        }
+
+        if (fd >= static_cast<int>(connections.size()) || !connections[fd]) continue;
+        Connection& connection = *connections[fd];
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            closeConnection(connection);
+            continue;
+        }
+        if (events[i].events & EPOLLIN) {
+            onReadable(connection);
+        } else if (events[i].events & EPOLLOUT) {
+            serve(connection);  // Replies drained: send the rest and answer requests held back meanwhile
+        }
+    }
+    flushPushed();
+    return !stopping.load(std::memory_order_acquire);
+}
+
+void GameServer::stop() {
+    stopping.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void GameServer::acceptClients(int listener) {
+    while (true) {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;  // EAGAIN: backlog drained; EMFILE and friends: retried on the next event
+        }
+        int noDelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));  // Fails harmlessly on Unix sockets
+
+        if (fd >= static_cast<int>(connections.size())) {
+            connections.resize(fd + 1);
+        }
+        connections[fd] = std::make_unique<Connection>();
+        Connection& connection = *connections[fd];
+        connection.fd = fd;
+        connection.events = EPOLLIN;
+
+        epoll_event event{};
+        event.events = connection.events;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        openConnections++;
+    }
+}
+
+void GameServer::onReadable(Connection& connection) {
+    uint8_t buffer[16384];
+    while (connection.in.size() < kMaxPendingInput) {
+        ssize_t n = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (n == 0) {
+            closeConnection(connection);
+            return;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            closeConnection(connection);
+            return;
+        }
+        connection.in.insert(connection.in.end(), buffer, buffer + n);
+        if (n < static_cast<ssize_t>(sizeof(buffer))) break;
+    }
+    serve(connection);
+}
+
+void GameServer::serve(Connection& connection) {
+    while (true) {
+        // Answer complete requests until the replies back up; a partial request waits for its remaining bytes
+        size_t offset = 0;
+        protocol::Request request;
+        while (connection.out.size() - connection.outStart < kMaxPendingOutput) {
+            size_t used = protocol::decode(connection.in.data() + offset, connection.in.size() - offset, request);
+            if (used == 0) break;
+            offset += used;
+            protocol::Response response = tables.handle(request, connection.fd);
+            protocol::encode(response, connection.out);
+            if (response.status == ReplyStatus::Ok) watch(connection, request);
+        }
+        connection.in.erase(connection.in.begin(), connection.in.begin() + static_cast<std::ptrdiff_t>(offset));
+
+        if (!flushOutput(connection)) return;  // Closed
+        if (!connection.out.empty() || connection.in.size() < protocol::kRequestBytes) break;
+    }
+    updateInterest(connection);
+}
+
+// Remember the tables a connection spectates, to unsubscribe them when it closes
+void GameServer::watch(Connection& connection, const protocol::Request& request) {
+    auto& watching = connection.watching;
+    auto at = std::find(watching.begin(), watching.end(), request.table);
+    if (request.op == Op::Subscribe && at == watching.end()) watching.push_back(request.table);
+    if (request.op == Op::Unsubscribe && at != watching.end()) watching.erase(at);
+}
+
+void GameServer::sendUpdate(int client, uint32_t table, const uint8_t* update, size_t size) {
+    if (client >= static_cast<int>(connections.size()) || !connections[client]) return;
+    Connection& connection = *connections[client];
+    if (connection.out.size() - connection.outStart + protocol::kUpdateHeaderBytes + size > kMaxPendingOutput) {
+        return;  // Dropped; the spectator sees the sequence gap
+    }
+    protocol::encode(table, update, size, connection.out);
+    if (std::find(pushedTo.begin(), pushedTo.end(), client) == pushedTo.end()) pushedTo.push_back(client);
+}
+
+// Send the updates queued for connections other than the one being served
+void GameServer::flushPushed() {
+    for (int fd : pushedTo) {
+        if (fd >= static_cast<int>(connections.size()) || !connections[fd]) continue;
+        Connection& connection = *connections[fd];
+        if (flushOutput(connection)) updateInterest(connection);
+    }
+    pushedTo.clear();
+}
+
+bool GameServer::flushOutput(Connection& connection) {
+    while (connection.outStart < connection.out.size()) {
+        ssize_t n = ::send(connection.fd, connection.out.data() + connection.outStart,
+                           connection.out.size() - connection.outStart, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            closeConnection(connection);
+            return false;
+        }
+        connection.outStart += static_cast<size_t>(n);
+    }
+    if (connection.outStart == connection.out.size()) {
+        connection.out.clear();
+        connection.outStart = 0;
+    }
+    return true;
+}
+
+void GameServer::updateInterest(Connection& connection) {
+    uint32_t events = 0;
+    if (connection.in.size() < kMaxPendingInput && connection.out.size() - connection.outStart < kMaxPendingOutput) {
+        events |= EPOLLIN;
+    }
+    if (connection.outStart < connection.out.size()) events |= EPOLLOUT;
+    if (events == connection.events) return;
+
+    connection.events = events;
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void GameServer::closeConnection(Connection& connection) {
+    int fd = connection.fd;
+    for (uint32_t table : connection.watching) {
+        tables.unsubscribe(table, fd);
+    }
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections[fd].reset();
+    openConnections--;
+}
@@ -0,0 +1,148 @@
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "protocol.hpp"
+#include "stateSync.hpp"
+
+class Game;
+class Player;
+
+// Where a TableHost sends the state updates of the tables a client spectates
+class UpdateSink {
+public:
+    virtual ~UpdateSink() = default;
+    virtual void sendUpdate(int client, uint32_t table, const uint8_t* update, size_t size) = 0;
+};
+
+// The tables hosted by one server and the rules of each request. No sockets here, so
+// requests can be replayed or tested directly.
+class TableHost {
+private:
+    struct Table {
+        std::vector<std::shared_ptr<Player>> seats;  // Every seat, including bankrupt ones
+        std::unique_ptr<Game> game;
+        StateEncoder encoder;                         // What the spectators last saw
+        std::vector<int> spectators;
+    };
+
+    // Ids are slot | generation << kSlotBits, so a closed table's id is never mistaken for its successor
+    struct Slot {
+        uint32_t generation = 0;
+        std::unique_ptr<Table> table;
+    };
+
+    static constexpr int kSlotBits = 20;
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    size_t maxTables;
+    size_t openTables = 0;
+    UpdateSink* sink = nullptr;
+    std::vector<uint8_t> update;  // Scratch for publish()
+
+    Table* find(uint32_t id);
+    void publish(Table& table, uint32_t id);
+    protocol::ReplyStatus subscribe(Table& table, uint32_t id, int client);
+    protocol::Response createTable(const protocol::Request& request);
+    protocol::ReplyStatus buy(Table& table, const protocol::Request& request);
+    protocol::ReplyStatus build(Table& table, const protocol::Request& request);
+    void describe(const Table& table, protocol::Response& response) const;
+
+public:
+    explicit TableHost(size_t maxTables = size_t(1) << kSlotBits);
+    ~TableHost();
+
+    // `client` names the connection for Subscribe and Unsubscribe; other requests ignore it.
+    // Moves send the new state to the table's spectators before returning.
+    protocol::Response handle(const protocol::Request& request, int client = -1);
+
+    // Send spectator updates to `sink` (nobody for nullptr)
+    void setUpdateSink(UpdateSink* sink) { this->sink = sink; }
+
+    // Stop sending `table` to `client`, e.g. once it disconnected
+    void unsubscribe(uint32_t table, int client);
+
+    size_t tableCount() const { return openTables; }
+
+    // Every open table as saved games, with the slot generations so table ids stay valid:
+    //   u32 magic "MNPT" | u32 slotCount | slotCount x u32 generation
+    //   u32 tableCount | tableCount x (u32 slot | u32 bytes | saved game, see gameSave)
+    void saveTables(std::vector<uint8_t>& out) const;
+
+    // Replace every table with those of a checkpoint from saveTables. Throws std::runtime_error
+    // on malformed data, leaving the current tables in place.
+    void restoreTables(const uint8_t* data, size_t size);
+};
+
+// Serves the protocol to many connections from one epoll loop. All tables live on the loop's
+// thread, so games need no locking. Linux only.
+//
+// Spectator updates are queued behind the subscriber's replies. One that would push a slow
+// subscriber past kMaxPendingOutput is dropped; the gap tells its mirror to subscribe again.
+class GameServer : private UpdateSink {
+private:
+    struct Connection {
+        int fd = -1;
+        std::vector<uint8_t> in;
+        std::vector<uint8_t> out;
+        size_t outStart = 0;       // Bytes of `out` already sent
+        uint32_t events = 0;       // Interest registered with epoll
+        std::vector<uint32_t> watching;  // Subscribed tables
+    };
+
+    static constexpr size_t kMaxPendingOutput = 256 * 1024;  // Stop reading a client that doesn't read its replies
+    static constexpr size_t kMaxPendingInput = 64 * 1024;    // Requests buffered before the socket is left to fill
+
+    int epollFd = -1;
+    int wakeFd = -1;                                      // eventfd that interrupts the wait for stop()
+    std::vector<int> listeners;
+    std::string unixPath;                                 // Unlinked again on shutdown
+    std::vector<std::unique_ptr<Connection>> connections; // Indexed by file descriptor
+    size_t openConnections = 0;
+    std::atomic<bool> stopping{false};
+    TableHost tables;
+    std::vector<int> pushedTo;                            // Connections sent updates outside serve()
+
+    void sendUpdate(int client, uint32_t table, const uint8_t* update, size_t size) override;
+    void flushPushed();
+    void addListener(int fd);
+    void acceptClients(int listener);
+    void onReadable(Connection& connection);
+    void serve(Connection& connection);
+    void watch(Connection& connection, const protocol::Request& request);
+    bool flushOutput(Connection& connection);
+    void updateInterest(Connection& connection);
+    void closeConnection(Connection& connection);
+
+public:
+    explicit GameServer(size_t maxTables = size_t(1) << 20);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Accept clients on a Unix socket; a stale socket file at `path` is replaced
+    void listenUnix(const std::string& path);
+
+    // Accept clients on a loopback TCP port; 0 picks a free port. Returns the port.
+    uint16_t listenTcp(uint16_t port);
+
+    // Serve until stop()
+    void run();
+
+    // Wait up to `timeoutMs` for events and handle them; false once stop() was called
+    bool pollOnce(int timeoutMs);
+
+    // Ask run() to return; safe from any thread or a signal handler
+    void stop();
+
+    TableHost& getTables() { return tables; }
+    size_t connectionCount() const { return openConnections; }
+};
+
+#endif // GAME_SERVER_HPP
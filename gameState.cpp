@@ -0,0 +1,38 @@
+#include "gameState.hpp"
+#include "game.hpp"
+
+GameState GameState::capture(const Game& game) {
+    GameState state;
+    state.rolls = static_cast<uint32_t>(game.getRollCount());
+    state.currentSeat = static_cast<int8_t>(game.getCurrentSeat());
+
+    const auto& seats = game.getSeats();
+    state.seatCount = static_cast<uint8_t>(seats.size() < kMaxSeats ? seats.size() : kMaxSeats);
+    for (int i = 0; i < state.seatCount; ++i) {
+        const Player& player = *seats[i];
+        SeatState& seat = state.seats[i];
+        seat.money = player.getMoney();
+        seat.position = static_cast<uint8_t>(player.getPosition());
+        seat.flags = (player.isBankrupt() ? SeatState::Bankrupt : 0) |
+                     (player.isInJail() ? SeatState::InJail : 0) |
+                     (player.hasGetOutOfJailFreeCard() ? SeatState::HoldsJailCard : 0);
+    }
+
+    const Board& board = game.getBoard();
+    for (int t = 0; t < kBoardTiles && t < board.getTileCount(); ++t) {
+        auto tile = board.getTile(t);
+        TileState& entry = state.tiles[t];
+        if (auto owner = tile->getOwner()) {
+            for (int i = 0; i < state.seatCount; ++i) {
+                if (seats[i] == owner) entry.owner = static_cast<int8_t>(i);
+            }
+        }
+        if (board.getTileKind(t) == TileKind::Street) {
+            const auto& street = static_cast<const StreetTile&>(*tile);
+            entry.houses = static_cast<uint8_t>(street.getHouseCount());
+            entry.hotel = street.isHotelBuilt();
+        }
+        entry.mortgaged = tile->isMortgaged();
+    }
+    return state;
+}
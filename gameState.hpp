@@ -0,0 +1,57 @@
+#ifndef GAME_STATE_HPP
+#define GAME_STATE_HPP
+
+#include <array>
+#include <cstdint>
+#include "simulation.hpp"
+
+class Game;
+
+// What a spectator sees of one seat
+struct SeatState {
+    int32_t money = 0;
+    uint8_t position = 0;
+    uint8_t flags = 0;  // SeatFlags bits
+
+    enum SeatFlags : uint8_t { Bankrupt = 1, InJail = 2, HoldsJailCard = 4 };
+
+    bool operator==(const SeatState& other) const {
+        return money == other.money && position == other.position && flags == other.flags;
+    }
+    bool operator!=(const SeatState& other) const { return !(*this == other); }
+};
+
+// Ownership, buildings and mortgage of one tile
+struct TileState {
+    int8_t owner = -1;    // Seat of the owner, -1 if unowned
+    uint8_t houses = 0;
+    bool hotel = false;
+    bool mortgaged = false;
+
+    bool operator==(const TileState& other) const {
+        return owner == other.owner && houses == other.houses && hotel == other.hotel && mortgaged == other.mortgaged;
+    }
+    bool operator!=(const TileState& other) const { return !(*this == other); }
+};
+
+// Plain-data picture of a game between turns: positions, money, ownership and buildings
+struct GameState {
+    static constexpr int kMaxSeats = kMaxSimPlayers;
+
+    uint32_t rolls = 0;
+    int8_t currentSeat = -1;
+    uint8_t seatCount = 0;
+    std::array<SeatState, kMaxSeats> seats{};
+    std::array<TileState, kBoardTiles> tiles{};
+
+    // Read the state of a game; seats past kMaxSeats are left out
+    static GameState capture(const Game& game);
+
+    bool operator==(const GameState& other) const {
+        return rolls == other.rolls && currentSeat == other.currentSeat && seatCount == other.seatCount &&
+               seats == other.seats && tiles == other.tiles;
+    }
+    bool operator!=(const GameState& other) const { return !(*this == other); }
+};
+
+#endif // GAME_STATE_HPP
@@ -0,0 +1,20 @@
+#include "jail.hpp"
+#include "player.hpp"
+
+JailAction CardOrRollPolicy::choose(const Player& player, int) {
+    return player.hasGetOutOfJailFreeCard() ? JailAction::UseCard : JailAction::Roll;
+}
+
+JailAction PayPolicy::choose(const Player& player, int) {
+    if (player.getMoney() - kJailFee >= reserve) return JailAction::Pay;
+    return player.hasGetOutOfJailFreeCard() ? JailAction::UseCard : JailAction::Roll;
+}
+
+namespace jail {
+
+JailPolicy& defaultPolicy() {
+    static CardOrRollPolicy policy;
+    return policy;
+}
+
+} // namespace jail
@@ -0,0 +1,91 @@
+#ifndef JAIL_HPP
+#define JAIL_HPP
+
+#include <cstdint>
+
+class Player;
+
+constexpr int kJailFee = 50;       // Paid to leave jail
+constexpr int kJailAttempts = 3;   // Rolls for doubles before the fee is forced
+
+// What a jailed player does at the start of their turn
+enum class JailAction : uint8_t {
+    Roll,      // Roll for doubles; the third miss pays the fee and moves anyway
+    Pay,       // Pay the fee, then roll and move as usual
+    UseCard    // Play a Get Out of Jail Free card, then roll and move as usual
+};
+
+constexpr int kJailActions = 3;
+
+// The outcome of one turn in jail
+struct JailStep {
+    bool paysFee;      // The fee goes to the bank
+    bool usesCard;     // A held Get Out of Jail Free card goes back to its deck
+    bool leaves;       // Out of jail this turn
+    bool moves;        // The token moves by the roll
+    bool rollsAgain;   // A double keeps the turn, as outside jail
+};
+
+namespace jail {
+
+// Every turn in jail by [action][last attempt][double]. The scalar game, the lockstep engine and the
+// landing model all read this table, so the rules live in one place.
+constexpr JailStep kSteps[kJailActions][2][2] = {
+    // Roll
+    {{{false, false, false, false, false},    // A miss: stay
+      {false, false, true, true, false}},     // Doubles: out and move, no extra turn
+     {{true, false, true, true, false},       // Third miss: pay and move
+      {false, false, true, true, false}}},
+    // Pay
+    {{{true, false, true, true, false}, {true, false, true, true, true}},
+     {{true, false, true, true, false}, {true, false, true, true, true}}},
+    // UseCard
+    {{{false, true, true, true, false}, {false, true, true, true, true}},
+     {{false, true, true, true, false}, {false, true, true, true, true}}},
+};
+
+// The step for a player who has already missed `turnsServed` rolls
+constexpr const JailStep& step(JailAction action, int turnsServed, bool isDouble) {
+    return kSteps[static_cast<int>(action)][turnsServed >= kJailAttempts - 1 ? 1 : 0][isDouble ? 1 : 0];
+}
+
+} // namespace jail
+
+// How a jailed player chooses. Actions the player can't take (a card they don't hold) fall back to Roll.
+class JailPolicy {
+public:
+    virtual ~JailPolicy() = default;
+    virtual JailAction choose(const Player& player, int turnsServed) = 0;
+};
+
+// Plays a held card, otherwise rolls for doubles. The default for every player, and what the lockstep
+// engine plays.
+class CardOrRollPolicy : public JailPolicy {
+public:
+    JailAction choose(const Player& player, int turnsServed) override;
+};
+
+// Always rolls for doubles, keeping any card
+class RollPolicy : public JailPolicy {
+public:
+    JailAction choose(const Player&, int) override { return JailAction::Roll; }
+};
+
+// Pays straight away while at least `reserve` cash is left afterwards; otherwise as CardOrRollPolicy
+class PayPolicy : public JailPolicy {
+private:
+    int reserve;
+
+public:
+    explicit PayPolicy(int reserve = 0) : reserve(reserve) {}
+    JailAction choose(const Player& player, int turnsServed) override;
+};
+
+namespace jail {
+
+// Shared CardOrRollPolicy
+JailPolicy& defaultPolicy();
+
+} // namespace jail
+
+#endif // JAIL_HPP
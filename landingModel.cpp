@@ -0,0 +1,103 @@
+#include "landingModel.hpp"
+#include "board.hpp"
+#include "cardDeck.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr int kStates = kBoardTiles + kJailAttempts;
+constexpr int kJailed = kBoardTiles;  // State of a token just sent to jail
+
+// Where a token on `tile` ends up: a distribution over states, after Go To Jail and any card move
+std::array<double, kStates> resolve(const Board& board, int tile, const CardDeck& chance, const CardDeck& communityChest) {
+    std::array<double, kStates> to{};
+    TileKind kind = board.getTileKind(tile);
+    if (kind == TileKind::GoToJail) {
+        to[kJailed] = 1.0;
+        return to;
+    }
+    const CardDeck* deck = kind == TileKind::Chance ? &chance : kind == TileKind::CommunityChest ? &communityChest : nullptr;
+    if (!deck || deck->size() == 0) {
+        to[tile] = 1.0;
+        return to;
+    }
+
+    double share = 1.0 / deck->size();
+    for (int c = 0; c < deck->size(); ++c) {
+        const CardSpec& card = deck->getCard(c);
+        int target = tile;
+        if (card.action == CardAction::AdvanceTo) {
+            target = card.target;
+        } else if (card.action == CardAction::AdvanceToNearest) {
+            int nearest = board.nextTile(tile, static_cast<TileKind>(card.target)).index;
+            target = nearest >= 0 ? nearest : tile;
+        } else if (card.action == CardAction::GoToJail) {
+            target = kJailed;
+        }
+        to[target >= 0 && target < kStates ? target : tile] += share;
+    }
+    return to;
+}
+
+} // namespace
+
+LandingModel::LandingModel(const Board& board, const CardDeck& chance, const CardDeck& communityChest, JailAction jailAction) {
+    int tiles = board.getTileCount() < kBoardTiles ? board.getTileCount() : kBoardTiles;
+    if (tiles == 0) return;
+    for (int t = 0; t < tiles; ++t) {
+        if (board.getTileKind(t) == TileKind::Jail) jail = t;
+    }
+
+    // Tiles in play, then the jail states
+    std::vector<int> states;
+    for (int t = 0; t < tiles; ++t) states.push_back(t);
+    for (int k = 0; k < kJailAttempts; ++k) states.push_back(kBoardTiles + k);
+
+    std::vector<std::array<double, kStates>> landing(tiles);
+    for (int t = 0; t < tiles; ++t) {
+        landing[t] = resolve(board, t, chance, communityChest);
+    }
+
+    // Transition matrix over the 36 dice pairs: from a tile, move and resolve; from jail, follow jail::kSteps
+    std::vector<std::array<double, kStates>> step(kStates);
+    for (int from : states) {
+        step[from].fill(0.0);
+        for (int a = 1; a <= 6; ++a) {
+            for (int b = 1; b <= 6; ++b) {
+                int start = from;
+                if (from >= kBoardTiles) {
+                    int served = from - kBoardTiles;
+                    if (!jail::step(jailAction, served, a == b).leaves) {
+                        step[from][from + 1 < kStates ? from + 1 : from] += 1.0 / 36.0;
+                        continue;
+                    }
+                    start = jail;
+                }
+                const auto& to = landing[(start + a + b) % tiles];
+                for (int s : states) {
+                    step[from][s] += to[s] / 36.0;
+                }
+            }
+        }
+    }
+
+    // Power iteration from Go until the distribution stops moving
+    std::array<double, kStates> next{};
+    stationary[0] = 1.0;
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        next.fill(0.0);
+        for (int from : states) {
+            if (stationary[from] == 0.0) continue;
+            for (int s : states) {
+                next[s] += stationary[from] * step[from][s];
+            }
+        }
+        double change = 0.0;
+        for (int s : states) {
+            change += std::fabs(next[s] - stationary[s]);
+        }
+        stationary = next;
+        if (change < 1e-12) break;
+    }
+}
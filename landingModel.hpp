@@ -0,0 +1,46 @@
+#ifndef LANDING_MODEL_HPP
+#define LANDING_MODEL_HPP
+
+#include <array>
+#include "jail.hpp"
+#include "simulation.hpp"
+
+class Board;
+class CardDeck;
+
+// Long-run share of rolls that end on each tile: the stationary distribution of the Markov chain
+// "position after one roll". A roll moves by two dice; Go To Jail and the movement cards of the
+// decks (Advance To, Advance To Nearest, Go To Jail) then move the token on. Each card is drawn
+// with equal chance. Time in jail is a state of its own per missed roll, following jail::kSteps
+// for the action a jailed player takes every turn; a roll spent in jail ends on the Jail tile.
+// Three doubles in a row are not modelled.
+class LandingModel {
+private:
+    static constexpr int kStates = kBoardTiles + kJailAttempts;  // Tiles, then in jail by missed rolls
+    std::array<double, kStates> stationary{};
+    int jail = 0;
+
+public:
+    // Built once per board; the decks only supply their cards
+    LandingModel(const Board& board, const CardDeck& chance, const CardDeck& communityChest,
+                 JailAction jailAction = JailAction::Roll);
+
+    // Chance that a roll ends on `tile`
+    double probability(int tile) const {
+        if (tile < 0 || tile >= kBoardTiles) return 0.0;
+        double p = stationary[tile];
+        if (tile == jail) {
+            for (int k = 0; k < kJailAttempts; ++k) p += stationary[kBoardTiles + k];
+        }
+        return p;
+    }
+
+    // Chance that a roll leaves the token in jail (sent there, or a missed roll for doubles)
+    double inJail() const {
+        double p = 0.0;
+        for (int k = 0; k < kJailAttempts; ++k) p += stationary[kBoardTiles + k];
+        return p;
+    }
+};
+
+#endif // LANDING_MODEL_HPP
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "protocol.hpp"
+
+using Clock = std::chrono::steady_clock;
+using protocol::Op;
+using protocol::ReplyStatus;
+
+namespace {
+
+struct InFlight {
+    Op op;
+    int slot;  // Index into the connection's tables
+    Clock::time_point sent;
+};
+
+// One bot connection playing several tables with pipelined requests
+struct BotConnection {
+    protocol::Client client;
+    std::vector<uint32_t> tables;   // 0 while a table is being replaced
+    std::deque<InFlight> inFlight;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    size_t outStart = 0;
+    long long sent = 0;
+    long long received = 0;
+    int nextSlot = 0;
+    bool wantWrite = false;
+};
+
+uint32_t nextSeed = 1;
+
+void queue(BotConnection& bot, const protocol::Request& request, int slot) {
+    protocol::encode(request, bot.out);
+    bot.inFlight.push_back({request.op, slot, Clock::now()});
+}
+
+// Top the connection up to `pipeline` requests in flight, cycling over its tables
+void fill(BotConnection& bot, int pipeline, long long requests) {
+    int slots = static_cast<int>(bot.tables.size());
+    while (static_cast<int>(bot.inFlight.size()) < pipeline && bot.sent < requests) {
+        int slot = -1;
+        for (int tries = 0; tries < slots; ++tries) {
+            int candidate = (bot.nextSlot + tries) % slots;
+            if (bot.tables[candidate] != 0) {
+                slot = candidate;
+                break;
+            }
+        }
+        if (slot < 0) return;  // Every table is being replaced
+        bot.nextSlot = (slot + 1) % slots;
+
+        protocol::Request request;
+        request.table = bot.tables[slot];
+        long long n = bot.sent;
+        request.op = n % 8 == 7 ? Op::Status : n % 16 == 3 ? Op::Buy : Op::Roll;
+        queue(bot, request, slot);
+        bot.sent++;
+    }
+}
+
+bool flush(BotConnection& bot) {
+    while (bot.outStart < bot.out.size()) {
+        ssize_t n = ::send(bot.client.socket(), bot.out.data() + bot.outStart, bot.out.size() - bot.outStart, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        bot.outStart += static_cast<size_t>(n);
+    }
+    if (bot.outStart == bot.out.size()) {
+        bot.out.clear();
+        bot.outStart = 0;
+    }
+    return true;
+}
+
+void setInterest(int epollFd, BotConnection& bot, int index) {
+    bool wantWrite = !bot.out.empty();
+    if (wantWrite == bot.wantWrite) return;
+    bot.wantWrite = wantWrite;
+    epoll_event event{};
+    event.events = wantWrite ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    event.data.u32 = static_cast<uint32_t>(index);
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, bot.client.socket(), &event);
+}
+
+} // namespace
+
+// Load test for monopoly_server: many connections, each playing several tables with pipelined requests.
+// Usage: ./monopoly_loadclient [--unix PATH | --port N] [--connections N] [--tables N] [--requests N] [--pipeline N]
+int main(int argc, char* argv[]) {
+    std::string unixPath = "/tmp/monopoly.sock";
+    int port = -1;
+    int connections = 64;
+    int tablesPerConnection = 16;
+    long long requests = 20000;  // Per connection
+    int pipeline = 8;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--unix") == 0) unixPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--port") == 0) port = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--connections") == 0) connections = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--tables") == 0) tablesPerConnection = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--requests") == 0) requests = std::atoll(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--pipeline") == 0) pipeline = std::atoi(argv[i + 1]);
+    }
+    if (connections < 1 || tablesPerConnection < 1 || pipeline < 1) {
+        std::cerr << "monopoly_loadclient: connections, tables and pipeline must be positive\n";
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<BotConnection>> bots;
+    int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    try {
+        for (int c = 0; c < connections; ++c) {
+            auto bot = std::make_unique<BotConnection>();
+            if (port >= 0) bot->client.connectTcp(static_cast<uint16_t>(port));
+            else bot->client.connectUnix(unixPath);
+
+            for (int t = 0; t < tablesPerConnection; ++t) {
+                protocol::Request create;
+                create.op = Op::CreateTable;
+                create.seat = 4;
+                create.arg = nextSeed++;
+                protocol::Response reply = bot->client.call(create);
+                if (reply.status != ReplyStatus::Ok) {
+                    std::cerr << "monopoly_loadclient: create table: " << protocol::statusName(reply.status) << "\n";
+                    return 1;
+                }
+                bot->tables.push_back(reply.table);
+            }
+
+            int fd = bot->client.socket();
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u32 = static_cast<uint32_t>(bots.size());
+            ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            bots.push_back(std::move(bot));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "monopoly_loadclient: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<uint32_t> latencies;  // Microseconds per request
+    latencies.reserve(static_cast<size_t>(connections) * static_cast<size_t>(requests));
+    long long statusCounts[6] = {};
+    long long gamesFinished = 0;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < bots.size(); ++i) {
+        fill(*bots[i], pipeline, requests);
+        flush(*bots[i]);
+        setInterest(epollFd, *bots[i], static_cast<int>(i));
+    }
+
+    int active = connections;
+    epoll_event events[256];
+    while (active > 0) {
+        int count = ::epoll_wait(epollFd, events, 256, 1000);
+        if (count < 0 && errno != EINTR) {
+            std::cerr << "monopoly_loadclient: epoll_wait: " << std::strerror(errno) << "\n";
+            return 1;
+        }
+        for (int e = 0; e < count; ++e) {
+            int index = static_cast<int>(events[e].data.u32);
+            BotConnection& bot = *bots[index];
+            if (bot.received >= requests && bot.inFlight.empty()) continue;
+
+            if (events[e].events & EPOLLIN) {
+                uint8_t buffer[16384];
+                ssize_t n;
+                while ((n = ::recv(bot.client.socket(), buffer, sizeof(buffer), 0)) > 0) {
+                    bot.in.insert(bot.in.end(), buffer, buffer + n);
+                }
+                if (n == 0) {
+                    std::cerr << "monopoly_loadclient: server closed the connection\n";
+                    return 1;
+                }
+
+                size_t offset = 0;
+                protocol::Response reply;
+                while (size_t used = protocol::decode(bot.in.data() + offset, bot.in.size() - offset, reply)) {
+                    offset += used;
+                    InFlight request = bot.inFlight.front();
+                    bot.inFlight.pop_front();
+                    latencies.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - request.sent).count()));
+                    statusCounts[static_cast<int>(reply.status) % 6]++;
+
+                    if (request.op == Op::CreateTable) {
+                        bot.tables[request.slot] = reply.table;
+                        continue;  // Replacement tables are not part of the measured requests
+                    }
+                    if (request.op == Op::CloseTable) continue;
+                    bot.received++;
+
+                    // Replace a finished game with a fresh table
+                    if (reply.status == ReplyStatus::GameOver && bot.tables[request.slot] == reply.table) {
+                        gamesFinished++;
+                        bot.tables[request.slot] = 0;
+                        protocol::Request close;
+                        close.op = Op::CloseTable;
+                        close.table = reply.table;
+                        queue(bot, close, request.slot);
+                        protocol::Request create;
+                        create.op = Op::CreateTable;
+                        create.seat = 4;
+                        create.arg = nextSeed++;
+                        queue(bot, create, request.slot);
+                    }
+                }
+                bot.in.erase(bot.in.begin(), bot.in.begin() + static_cast<std::ptrdiff_t>(offset));
+
+                if (bot.received >= requests && bot.inFlight.empty()) {
+                    active--;
+                }
+            }
+
+            fill(bot, pipeline, requests);
+            if (!flush(bot)) {
+                std::cerr << "monopoly_loadclient: send failed\n";
+                return 1;
+            }
+            setInterest(epollFd, bot, index);
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    ::close(epollFd);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies.empty() ? 0u : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    long long total = static_cast<long long>(connections) * requests;
+    std::cout << "connections " << connections << ", tables " << connections * tablesPerConnection
+              << ", pipeline " << pipeline << "\n"
+              << "requests    " << total << " in " << seconds << " s (" << total / seconds << " req/s)\n"
+              << "latency us  p50 " << percentile(0.5) << "  p99 " << percentile(0.99)
+              << "  max " << (latencies.empty() ? 0u : latencies.back()) << "\n"
+              << "games       " << gamesFinished << " finished and replaced\n";
+    for (int s = 1; s < 6; ++s) {
+        if (statusCounts[s] > 0) {
+            std::cout << "replies     " << statusCounts[s] << " " << protocol::statusName(static_cast<ReplyStatus>(s)) << "\n";
+        }
+    }
+    return 0;
+}
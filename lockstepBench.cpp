@@ -0,0 +1,40 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "board.hpp"
+#include "lockstepSim.hpp"
+#include "profiler.hpp"
+#include "simulation.hpp"
+
+// Throughput of the lockstep engine against the scalar Game::playTurn engine.
+// Usage: ./lockstep_bench [games] [players] [maxRolls]
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int players = argc > 2 ? std::atoi(argv[2]) : 2;
+    int maxRolls = argc > 3 ? std::atoi(argv[3]) : 1000;
+    int scalarGames = games / 20 > 0 ? games / 20 : 1;  // The scalar engine is far slower, keep its share short
+
+    using Clock = std::chrono::steady_clock;
+
+    auto scalarStart = Clock::now();
+    SimStats scalar = runScalarGames(1, scalarGames, players, maxRolls);
+    double scalarSeconds = std::chrono::duration<double>(Clock::now() - scalarStart).count();
+
+    auto board = Board::create();
+    LockstepSimulator simulator(*board, players, maxRolls);
+    auto lockstepStart = Clock::now();
+    SimStats lockstep = simulator.run(1, games);
+    double lockstepSeconds = std::chrono::duration<double>(Clock::now() - lockstepStart).count();
+
+    double scalarRate = scalarGames / scalarSeconds;
+    double lockstepRate = games / lockstepSeconds;
+
+    std::cout << "engine     games   games/s      mean rolls  finished  jail landings\n";
+    std::cout << "scalar     " << scalarGames << "  " << scalarRate << "  " << scalar.meanRolls() << "  "
+              << static_cast<double>(scalar.finishedGames) / scalar.games << "  " << scalar.landingFrequency(10) << "\n";
+    std::cout << "lockstep   " << games << "  " << lockstepRate << "  " << lockstep.meanRolls() << "  "
+              << static_cast<double>(lockstep.finishedGames) / lockstep.games << "  " << lockstep.landingFrequency(10) << "\n";
+    std::cout << "speedup    " << lockstepRate / scalarRate << "x (" << kLanes << " lanes)\n";
+    PROFILE_DUMP("lockstep_bench.folded");  // Scalar turns, when built with PROFILE=1
+    return 0;
+}
@@ -0,0 +1,618 @@
+#include "lockstepSim.hpp"
+#include "auction.hpp"
+#include "board.hpp"
+#include "cashRaising.hpp"
+#include "jail.hpp"
+#include "railroadTile.hpp"
+#include "specialTiles.hpp"
+#include <memory>
+
+namespace {
+
+constexpr int32_t kJailPosition = 10;       // Player::goToJail
+constexpr int32_t kReadingRailroad = 5;     // TripToReadingRailroadCard target
+constexpr int32_t kNearestRailroadRent = 100;  // AdvanceToNearestRailroadCard rent
+
+// Packed seat state: position | in jail | jail turns served | holds a jail card
+constexpr int32_t kPositionBits = 0x3F;
+constexpr int32_t kInJailBit = 0x40;
+constexpr int32_t kJailTurnsShift = 7;
+constexpr int32_t kJailTurnsMask = 0x7;
+constexpr int32_t kJailCardBit = 0x400;
+
+// Tile kinds (plain ints so they compare directly against lane vectors)
+constexpr int32_t KindNone = 0;
+constexpr int32_t KindGo = 1;
+constexpr int32_t KindStreet = 2;
+constexpr int32_t KindRailroad = 3;
+constexpr int32_t KindUtility = 4;
+constexpr int32_t KindTax = 5;
+constexpr int32_t KindChance = 6;
+constexpr int32_t KindCommunityChest = 7;
+constexpr int32_t KindJail = 8;
+constexpr int32_t KindGoToJail = 9;
+
+// Card effects
+constexpr int32_t CardNothing = 0;
+constexpr int32_t CardAdvanceToGo = 1;
+constexpr int32_t CardGoToJail = 2;
+constexpr int32_t CardReadingRailroad = 3;
+constexpr int32_t CardNearestUtility = 4;
+constexpr int32_t CardNearestRailroad = 5;
+constexpr int32_t CardJailFree = 6;
+
+// Card order mirrors CardDeck::standardChance and standardCommunityChest. General repairs have no
+// effect under the random policy (no buildings). Lanes draw uniformly with replacement instead of
+// walking a shuffled deck; per draw that is the same distribution, apart from the scalar decks
+// holding out a kept jail card.
+constexpr int32_t kChanceCards[] = {
+    CardAdvanceToGo, CardGoToJail, CardReadingRailroad, CardNothing,
+    CardJailFree, CardNearestUtility, CardNearestRailroad
+};
+constexpr int32_t kCommunityChestCards[] = {
+    CardAdvanceToGo, CardNothing, CardJailFree, CardNothing, CardNothing
+};
+constexpr int32_t kChanceCount = sizeof(kChanceCards) / sizeof(kChanceCards[0]);
+constexpr int32_t kCommunityChestCount = sizeof(kCommunityChestCards) / sizeof(kCommunityChestCards[0]);
+
+inline LaneInt splat(int32_t value) {
+    return LaneInt{} + value;
+}
+
+inline LaneInt select(LaneInt mask, LaneInt a, LaneInt b) {
+    return (mask & a) | (~mask & b);
+}
+
+inline bool any(LaneInt mask) {
+    for (int i = 0; i < kLanes; ++i) {
+        if (mask[i]) return true;
+    }
+    return false;
+}
+
+// murmur3 finalizer, used to turn a game seed into a lane RNG state
+inline uint32_t mix32(uint32_t z) {
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+} // namespace
+
+LockstepSimulator::LockstepSimulator(const Board& board, int numPlayers, int maxRolls, const HouseRules& rules)
+    : rules(rules),
+      utilityRentOne(4 * rules.rentPercent),
+      utilityRentTwo(10 * rules.rentPercent),
+      nearestRailroadRent(kNearestRailroadRent * rules.rentPercent / 100),
+      numPlayers(numPlayers < 2 ? 2 : (numPlayers > kMaxSimPlayers ? kMaxSimPlayers : numPlayers)),
+      maxRolls(maxRolls) {
+    for (int t = 0; t < kBoardTiles && t < board.getTileCount(); ++t) {
+        auto tile = board.getTile(t);
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(tile)) {
+            tileKind[t] = KindStreet;
+            tilePrice[t] = street->getBasePrice();
+            tileRent[t] = street->calculateRent() * rules.rentPercent / 100;
+        } else if (auto railroad = std::dynamic_pointer_cast<RailroadTile>(tile)) {
+            tileKind[t] = KindRailroad;
+            tilePrice[t] = railroad->getPrice();
+            tileRent[t] = railroad->calculateRent() * rules.rentPercent / 100;
+        } else if (auto utility = std::dynamic_pointer_cast<UtilityTile>(tile)) {
+            tileKind[t] = KindUtility;
+            tilePrice[t] = utility->getPrice();
+        } else if (auto tax = std::dynamic_pointer_cast<TaxTile>(tile)) {
+            tileKind[t] = KindTax;
+            tilePrice[t] = tax->getTaxAmount() * rules.taxPercent / 100;
+        } else if (std::dynamic_pointer_cast<ChanceTile>(tile)) {
+            tileKind[t] = KindChance;
+        } else if (std::dynamic_pointer_cast<CommunityChestTile>(tile)) {
+            tileKind[t] = KindCommunityChest;
+        } else if (std::dynamic_pointer_cast<StartTile>(tile)) {
+            tileKind[t] = KindGo;
+        } else if (std::dynamic_pointer_cast<JailTile>(tile)) {
+            tileKind[t] = KindJail;
+        } else if (std::dynamic_pointer_cast<GoToJailTile>(tile)) {
+            tileKind[t] = KindGoToJail;
+        }
+    }
+
+    // Nearest utility/railroad ahead of each tile, from the board's tables (the same ones the cards use)
+    for (int t = 0; t < kBoardTiles && t < board.getTileCount(); ++t) {
+        const NextTile& utility = board.nextTile(t, TileKind::Utility);
+        const NextTile& railroad = board.nextTile(t, TileKind::Railroad);
+        nextUtility[t] = utility.index >= 0 ? utility.index : t;
+        nextRailroad[t] = railroad.index >= 0 ? railroad.index : t;
+    }
+}
+
+SimStats LockstepSimulator::run(uint32_t firstSeed, int numGames, GameSink* gameSink) {
+    stats = SimStats();
+    sink = gameSink;
+    nextSeed = firstSeed;
+    gamesLeft = numGames;
+    active = splat(0);
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        startGame(lane);
+    }
+    while (any(active)) {
+        step();
+    }
+    return stats;
+}
+
+// Weyl sequence per lane, scrambled with the murmur3 finalizer
+LaneUInt LockstepSimulator::nextRandom() {
+    rng += 0x9E3779B9u;
+    LaneUInt z = rng;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+// Value of a per-seat vector for the given seat in each lane
+LaneInt LockstepSimulator::pick(const LaneInt* perSeat, LaneInt seat) const {
+    LaneInt result = splat(0);
+    for (int p = 0; p < numPlayers; ++p) {
+        result = select(seat == p, perSeat[p], result);
+    }
+    return result;
+}
+
+void LockstepSimulator::addTo(LaneInt* perSeat, LaneInt seat, LaneInt mask, LaneInt delta) {
+    for (int p = 0; p < numPlayers; ++p) {
+        perSeat[p] += mask & (seat == p) & delta;
+    }
+}
+
+void LockstepSimulator::put(LaneInt* perSeat, LaneInt seat, LaneInt mask, LaneInt value) {
+    for (int p = 0; p < numPlayers; ++p) {
+        perSeat[p] = select(mask & (seat == p), value, perSeat[p]);
+    }
+}
+
+// The current seat's fields in and out of the per-seat arrays, once per step. Position and jail
+// state share one packed word, so a step makes two passes over the seats each way.
+void LockstepSimulator::loadSeat() {
+    LaneInt state = pick(seatState, current);
+    seatPosition = state & kPositionBits;
+    seatInJail = (state & kInJailBit) != 0;
+    seatJailTurns = (state >> kJailTurnsShift) & kJailTurnsMask;
+    seatJailCard = (state & kJailCardBit) != 0;
+    seatMoney = pick(money, current);
+}
+
+void LockstepSimulator::storeSeat(LaneInt mask) {
+    LaneInt state = seatPosition | (seatInJail & kInJailBit) | seatJailTurns << kJailTurnsShift | (seatJailCard & kJailCardBit);
+    put(seatState, current, mask, state);
+    put(money, current, mask, seatMoney);
+}
+
+void LockstepSimulator::credit(LaneInt seat, LaneInt mask, LaneInt amount) {
+    LaneInt own = mask & (seat == current);
+    seatMoney += own & amount;
+    addTo(money, seat, mask & ~own, amount);
+}
+
+LaneInt LockstepSimulator::lookup(const std::array<int32_t, kBoardTiles>& table, LaneInt tile) const {
+    LaneInt result;
+    for (int i = 0; i < kLanes; ++i) {
+        result[i] = table[tile[i]];
+    }
+    return result;
+}
+
+LaneInt LockstepSimulator::ownerOf(LaneInt tile) const {
+    LaneInt result;
+    for (int i = 0; i < kLanes; ++i) {
+        result[i] = owner[tile[i]][i];
+    }
+    return result;
+}
+
+LaneInt LockstepSimulator::mortgagedAt(LaneInt tile) const {
+    LaneInt result;
+    for (int i = 0; i < kLanes; ++i) {
+        result[i] = mortgaged[tile[i]][i];
+    }
+    return result;
+}
+
+// One dice roll in every running lane
+void LockstepSimulator::step() {
+    // A lane starting a fresh turn past the roll cap ends without a winner
+    LaneInt capped = active & (doubles == 0) & (rolls >= maxRolls);
+    if (any(capped)) {
+        finishGames(capped, splat(-1));
+    }
+    LaneInt live = active;
+    loadSeat();
+
+    // Two draws per step in every lane, so a game's random stream does not depend on its neighbours
+    LaneUInt r = nextRandom();
+    LaneUInt cardRandom = nextRandom();
+    LaneInt die1 = (LaneInt)((((r & 0xFFFFu) * 6u) >> 16) + 1u);
+    LaneInt die2 = (LaneInt)((((r >> 16) * 6u) >> 16) + 1u);
+    LaneInt total = die1 + die2;
+    LaneInt isDouble = die1 == die2;
+    rolls += live & 1;
+    bankrupt = splat(0);
+    creditor = splat(-1);
+    gameOver = splat(0);
+    winner = splat(-1);
+
+    // Jailed seats play the default jail policy (CardOrRollPolicy) through the shared jail::kSteps table
+    LaneInt keepsTurn = isDouble;
+    LaneInt stays = splat(0);
+    LaneInt jailed = live & seatInJail;
+    if (any(jailed)) {
+        LaneInt usesCard = splat(0);
+        LaneInt paysFee = splat(0);
+        LaneInt turnsServed = seatJailTurns;
+        LaneInt holdsCard = seatJailCard;
+        for (int i = 0; i < kLanes; ++i) {
+            if (!jailed[i]) continue;
+            JailAction action = holdsCard[i] ? JailAction::UseCard : JailAction::Roll;
+            const JailStep& s = jail::step(action, turnsServed[i], isDouble[i]);
+            usesCard[i] = s.usesCard ? -1 : 0;
+            paysFee[i] = s.paysFee ? -1 : 0;
+            stays[i] = s.leaves ? 0 : -1;
+            keepsTurn[i] = isDouble[i] && s.rollsAgain ? -1 : 0;
+        }
+        seatJailCard &= ~usesCard;
+        if (any(paysFee)) stays |= paysFee & ~payBank(paysFee, splat(rules.jailFee));  // Bankrupt ones don't move
+        seatJailTurns = select(stays & ~bankrupt, turnsServed + 1, seatJailTurns);
+        seatInJail &= ~(jailed & ~stays);
+        keepsTurn &= ~stays;
+    }
+
+    // Three doubles in a row: straight to jail without moving
+    doubles = select(live, select(keepsTurn, doubles + 1, splat(0)), doubles);
+    LaneInt speeding = live & (doubles == 3);
+    sendToJail(speeding);
+    doubles = select(speeding, splat(0), doubles);
+    LaneInt moving = live & ~speeding & ~stays;
+
+    // Move, collecting the salary when passing Start
+    LaneInt newPosition = seatPosition + total;
+    LaneInt passedGo = moving & (newPosition >= kBoardTiles);
+    newPosition = select(passedGo, newPosition - kBoardTiles, newPosition);
+    newPosition = select(moving, newPosition, splat(0));
+    seatPosition = select(moving, newPosition, seatPosition);
+    seatMoney += passedGo & rules.goSalary;
+    for (int i = 0; i < kLanes; ++i) {
+        if (moving[i]) landings[newPosition[i]][i]++;
+    }
+
+    // Interact with the tile
+    LaneInt kind = select(moving, lookup(tileKind, newPosition), splat(KindNone));
+
+    seatMoney += (kind == KindGo) & rules.goSalary;
+    LaneInt taxed = kind == KindTax;
+    if (any(taxed)) payBank(taxed, lookup(tilePrice, newPosition));
+    sendToJail(kind == KindGoToJail);
+
+    LaneInt property = (kind == KindStreet) | (kind == KindRailroad) | (kind == KindUtility);
+    if (any(property)) {
+        settleProperty(property, newPosition, total, splat(0), splat(-1));
+    }
+
+    LaneInt cards = (kind == KindChance) | (kind == KindCommunityChest);
+    if (any(cards)) {
+        drawCard(cards, newPosition, total, cardRandom);
+    }
+
+    // Spare cash goes into paying off mortgages (Player::payOffMortgages); only set under HouseRules::mortgages
+    LaneInt paysOff = moving & ~bankrupt & (mortgageCount > 0) & (seatMoney > kMortgageReserve);
+    if (any(paysOff)) {
+        payOffMortgages(paysOff);
+    }
+
+    // A player left with no money and no property is out, as Player::isBankrupt decides
+    LaneInt broke = moving & (seatMoney <= 0) & (pick(propertyCount, current) == 0);
+    bankrupt |= broke;
+    if (any(bankrupt)) {
+        settleBankruptcies(bankrupt);
+    }
+
+    // Doubles keep the turn unless it ended in jail; otherwise hand over to the next seat still in the game
+    LaneInt handOver = live & (~keepsTurn | speeding | bankrupt | seatInJail);
+    storeSeat(live);
+    doubles = select(handOver, splat(0), doubles);
+    current = select(handOver, nextAliveSeat(current), current);
+
+    if (any(gameOver)) {
+        finishGames(gameOver, winner);
+    }
+}
+
+void LockstepSimulator::sendToJail(LaneInt mask) {
+    seatPosition = select(mask, splat(kJailPosition), seatPosition);
+    seatInJail |= mask;
+    seatJailTurns &= ~mask;
+}
+
+// Buy the tile if unowned and affordable (or unconditionally in `alwaysBuy` lanes), otherwise pay
+// its rent. Lanes with `fixedRent` >= 0 pay that amount instead of the tile's rent.
+void LockstepSimulator::settleProperty(LaneInt mask, LaneInt tile, LaneInt dice, LaneInt alwaysBuy, LaneInt fixedRent) {
+    LaneInt tileOwner = ownerOf(tile);
+    LaneInt price = lookup(tilePrice, tile);
+    LaneInt isUtility = lookup(tileKind, tile) == KindUtility;
+
+    LaneInt buys = mask & (tileOwner < 0) & (alwaysBuy | (seatMoney >= price));
+    if (any(buys)) {
+        seatMoney -= buys & price;
+        addTo(propertyCount, current, buys, splat(1));
+        addTo(utilityCount, current, buys & isUtility, splat(1));
+        for (int i = 0; i < kLanes; ++i) {
+            if (buys[i]) owner[tile[i]][i] = current[i];
+        }
+    }
+
+    if (rules.auctions) {
+        LaneInt declined = mask & (tileOwner < 0) & ~buys;
+        if (any(declined)) auctionTile(declined, tile, price, isUtility);
+    }
+
+    LaneInt owes = mask & (tileOwner >= 0) & (tileOwner != current) & ~mortgagedAt(tile);
+    if (any(owes)) {
+        LaneInt utilitiesOwned = pick(utilityCount, tileOwner);
+        LaneInt multiplier = select(utilitiesOwned == 1, splat(utilityRentOne),
+                                    select(utilitiesOwned == 2, splat(utilityRentTwo), splat(0)));
+        LaneInt rent = select(isUtility, multiplier * dice / 100, lookup(tileRent, tile));
+        rent = select(fixedRent >= 0, fixedRent, rent);
+        payRent(owes, tileOwner, rent, tile);
+    }
+}
+
+// Sealed-bid auction of a declined tile among the seats still playing, every seat bidding up to the
+// list price (auction::sealed with ListPriceBidder, bidding from the current seat on). Seats are
+// visited in seat order, so each reads its own arrays; a tie goes to the seat that bids first.
+void LockstepSimulator::auctionTile(LaneInt mask, LaneInt tile, LaneInt price, LaneInt isUtility) {
+    LaneInt best = splat(0);
+    LaneInt second = splat(0);
+    LaneInt winner = splat(-1);
+    LaneInt winnerTurn = splat(numPlayers);
+    for (int p = 0; p < numPlayers; ++p) {
+        LaneInt turn = p - current;  // Place in the bidding order
+        turn = select(turn < 0, turn + numPlayers, turn);
+        LaneInt cash = select(current == p, seatMoney, money[p]);
+        LaneInt bid = select(cash < price, cash, price) & alive[p];
+        bid = select(bid >= kAuctionIncrement, bid, splat(0));
+        LaneInt higher = (bid > best) | ((bid == best) & (bid > 0) & (turn < winnerTurn));
+        second = select(higher, best, select(bid > second, bid, second));
+        winner = select(higher, splat(p), winner);
+        winnerTurn = select(higher, turn, winnerTurn);
+        best = select(higher, bid, best);
+    }
+
+    LaneInt sold = mask & (winner >= 0);
+    if (!any(sold)) return;
+    LaneInt raised = second + kAuctionIncrement;
+    LaneInt paid = select(second > 0, select(raised < best, raised, best), splat(kAuctionIncrement));
+    credit(winner, sold, -paid);
+    addTo(propertyCount, winner, sold, splat(1));
+    addTo(utilityCount, winner, sold & isUtility, splat(1));
+    for (int i = 0; i < kLanes; ++i) {
+        if (sold[i]) owner[tile[i]][i] = winner[i];
+    }
+}
+
+// Pay rent, mortgaging first when the cash is short (HouseRules::mortgages), or go bankrupt to the owner when even that
+// falls short (Player::payRent)
+void LockstepSimulator::payRent(LaneInt mask, LaneInt toSeat, LaneInt amount, LaneInt tile) {
+    if (rules.mortgages) {
+        LaneInt lacking = mask & (seatMoney < amount);
+        if (any(lacking)) raiseCash(lacking, amount);
+    }
+
+    LaneInt pays = mask & (seatMoney >= amount);
+    seatMoney -= pays & amount;
+    credit(toSeat, pays, amount);
+    addTo(rentEarned, toSeat, pays, amount);
+    for (int i = 0; i < kLanes; ++i) {
+        if (pays[i]) rentCollected[tile[i]][i] += amount[i];
+    }
+
+    LaneInt fails = mask & ~pays;
+    bankrupt |= fails;
+    creditor = select(fails, toSeat, creditor);
+}
+
+// Pay the bank (tax, the jail fee), raising cash first under HouseRules::mortgages, or go bankrupt to
+// the bank (Player::payDebt). Returns the lanes that paid.
+LaneInt LockstepSimulator::payBank(LaneInt mask, LaneInt amount) {
+    if (rules.mortgages) {
+        LaneInt lacking = mask & (seatMoney < amount);
+        if (any(lacking)) raiseCash(lacking, amount);
+    }
+
+    LaneInt pays = mask & (seatMoney >= amount);
+    seatMoney -= pays & amount;
+    bankrupt |= mask & ~pays;  // The creditor stays -1, the bank
+    return pays;
+}
+
+// Player::raiseCash for the current seat of each masked lane. Seats never build under the random
+// policy, so it comes down to the cheapest set of mortgages; lanes whose unmortgaged tiles can't
+// cover the amount are left as they are.
+void LockstepSimulator::raiseCash(LaneInt mask, LaneInt amount) {
+    int tiles[kBoardTiles];
+    int values[kBoardTiles];
+    int rents[kBoardTiles];
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if (!mask[lane]) continue;
+        int seat = current[lane];
+        int cash = seatMoney[lane];
+        int utilityRent = utilityCount[seat][lane] >= 2 ? utilityRentTwo : utilityRentOne;
+        int count = 0;
+        int total = 0;
+        for (int t = 0; t < kBoardTiles; ++t) {
+            if (owner[t][lane] != seat || mortgaged[t][lane]) continue;
+            tiles[count] = t;
+            values[count] = tilePrice[t] / 2;
+            rents[count] = tileKind[t] == KindUtility ? utilityRent * 7 / 100 : tileRent[t];
+            total += values[count];
+            count++;
+        }
+        if (cash + total < amount[lane]) continue;
+
+        uint32_t plan = cheapestMortgages(values, rents, count, amount[lane] - cash);
+        for (int i = 0; i < count; ++i) {
+            if (plan & (1u << i)) {
+                mortgaged[tiles[i]][lane] = -1;
+                seatMoney[lane] += values[i];
+                mortgageCount[lane]++;
+            }
+        }
+    }
+}
+
+void LockstepSimulator::payOffMortgages(LaneInt mask) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if (!mask[lane]) continue;
+        int seat = current[lane];
+        for (int t = 0; t < kBoardTiles; ++t) {
+            if (owner[t][lane] != seat || !mortgaged[t][lane]) continue;
+            int cost = tilePrice[t] / 2 * 11 / 10;
+            if (seatMoney[lane] - cost < kMortgageReserve) continue;
+            seatMoney[lane] -= cost;
+            mortgaged[t][lane] = 0;
+            mortgageCount[lane]--;
+        }
+    }
+}
+
+void LockstepSimulator::drawCard(LaneInt mask, LaneInt tile, LaneInt dice, LaneUInt random) {
+    LaneUInt r = random & 0xFFFFu;
+    LaneInt isChance = lookup(tileKind, tile) == KindChance;
+    LaneInt chanceIndex = (LaneInt)((r * static_cast<uint32_t>(kChanceCount)) >> 16);
+    LaneInt chestIndex = (LaneInt)((r * static_cast<uint32_t>(kCommunityChestCount)) >> 16);
+
+    LaneInt effect;
+    for (int i = 0; i < kLanes; ++i) {
+        effect[i] = !mask[i] ? CardNothing
+                  : isChance[i] ? kChanceCards[chanceIndex[i]] : kCommunityChestCards[chestIndex[i]];
+    }
+
+    LaneInt toGo = effect == CardAdvanceToGo;
+    seatPosition &= ~toGo;
+    seatMoney += toGo & rules.goSalary;
+
+    sendToJail(effect == CardGoToJail);
+    seatJailCard |= effect == CardJailFree;
+
+    LaneInt reading = effect == CardReadingRailroad;
+    if (any(reading)) {
+        LaneInt target = splat(kReadingRailroad);
+        seatMoney += reading & (tile > kReadingRailroad) & rules.goSalary;
+        seatPosition = select(reading, target, seatPosition);
+        settleProperty(reading, target, dice, splat(0), splat(-1));
+    }
+
+    // The nearest-utility/railroad cards buy without checking funds and skip rent on your own tile
+    LaneInt utility = effect == CardNearestUtility;
+    if (any(utility)) {
+        LaneInt target = lookup(nextUtility, tile);
+        seatPosition = select(utility, target, seatPosition);
+        settleProperty(utility, target, dice, splat(-1), splat(-1));
+    }
+
+    LaneInt railroad = effect == CardNearestRailroad;
+    if (any(railroad)) {
+        LaneInt target = lookup(nextRailroad, tile);
+        seatPosition = select(railroad, target, seatPosition);
+        settleProperty(railroad, target, dice, splat(-1), splat(nearestRailroadRent));
+    }
+}
+
+// Remove bankrupt seats: their tiles and any cash left go to the creditor (or back to the bank) and a
+// lane with one seat left has a winner
+void LockstepSimulator::settleBankruptcies(LaneInt mask) {
+    LaneInt cash = seatMoney;
+    credit(creditor, mask & (creditor >= 0) & (cash > 0), cash);
+    for (int t = 0; t < kBoardTiles; ++t) {
+        LaneInt transferred = mask & (owner[t] == current);
+        owner[t] = select(transferred, creditor, owner[t]);
+        LaneInt cleared = transferred & (creditor < 0) & mortgaged[t];  // The bank takes tiles back clear
+        mortgaged[t] &= ~cleared;
+        mortgageCount += cleared;  // -1 per cleared lane
+    }
+    seatMoney &= ~mask;
+    put(propertyCount, current, mask, splat(0));
+    put(alive, current, mask, splat(0));
+    aliveCount -= mask & 1;
+
+    // Leave the ring; the turn still passes on through the bankrupt seat's own link
+    LaneInt next = pick(nextSeat, current);
+    LaneInt previous = pick(previousSeat, current);
+    put(nextSeat, previous, mask, next);
+    put(previousSeat, next, mask, previous);
+
+    LaneInt won = mask & (aliveCount == 1);
+    winner = select(won, next, winner);
+    gameOver |= won;
+}
+
+LaneInt LockstepSimulator::nextAliveSeat(LaneInt seat) const {
+    return pick(nextSeat, seat);
+}
+
+void LockstepSimulator::startGame(int lane) {
+    if (gamesLeft == 0) {
+        active[lane] = 0;
+        return;
+    }
+    gamesLeft--;
+    uint32_t seed = nextSeed++;
+    laneSeed[lane] = seed;
+    rng[lane] = mix32(seed ^ 0x5BD1E995u);
+
+    for (int p = 0; p < kMaxSimPlayers; ++p) {
+        seatState[p][lane] = 0;
+        money[p][lane] = p < numPlayers ? rules.startingMoney : 0;
+        alive[p][lane] = p < numPlayers ? -1 : 0;
+        propertyCount[p][lane] = 0;
+        utilityCount[p][lane] = 0;
+        rentEarned[p][lane] = 0;
+        nextSeat[p][lane] = p + 1 < numPlayers ? p + 1 : 0;
+        previousSeat[p][lane] = p > 0 ? p - 1 : numPlayers - 1;
+    }
+    for (int t = 0; t < kBoardTiles; ++t) {
+        owner[t][lane] = -1;
+        mortgaged[t][lane] = 0;
+        landings[t][lane] = 0;
+        rentCollected[t][lane] = 0;
+    }
+    current[lane] = 0;
+    doubles[lane] = 0;
+    rolls[lane] = 0;
+    aliveCount[lane] = numPlayers;
+    mortgageCount[lane] = 0;
+    active[lane] = -1;
+}
+
+// Record the lanes' results and refill them with new games
+void LockstepSimulator::finishGames(LaneInt mask, LaneInt winner) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if (!mask[lane] || !active[lane]) continue;
+
+        GameSummary summary;
+        summary.seed = laneSeed[lane];
+        summary.numPlayers = numPlayers;
+        summary.rolls = rolls[lane];
+        summary.winner = winner[lane];
+        summary.bankruptcies = numPlayers - aliveCount[lane];
+        for (int p = 0; p < numPlayers; ++p) {
+            summary.finalMoney[p] = money[p][lane];
+            summary.rentEarned[p] = rentEarned[p][lane];
+        }
+        for (int t = 0; t < kBoardTiles; ++t) {
+            summary.landings[t] = landings[t][lane];
+            summary.rentCollected[t] = rentCollected[t][lane];
+        }
+        stats.add(summary);
+        if (sink) sink->record(summary);
+
+        startGame(lane);
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef LOCKSTEP_SIM_HPP
+#define LOCKSTEP_SIM_HPP
+
+#include "simulation.hpp"
+#include <array>
+#include <cstdint>
+
+class Board;
+
+constexpr int kLanes = 16;  // Games advanced together, one per vector lane
+
+// One value per lane (GCC/Clang vector extension). Comparisons give -1 (true) or 0 (false) per lane,
+// so comparison results double as lane masks.
+typedef int32_t LaneInt __attribute__((vector_size(kLanes * sizeof(int32_t))));
+typedef uint32_t LaneUInt __attribute__((vector_size(kLanes * sizeof(uint32_t))));
+
+// Plays many random-policy games at once. Every lane of a vector holds a separate game: positions,
+// money, seat state and tile owners live in lane vectors, and each step rolls the dice for all lanes
+// together. Doubles, jail, buying, auctions, rent, mortgages, cards and bankruptcy are applied under lane masks, following
+// the same rules as Game::playTurn so both engines produce the same statistics. A lane whose game
+// ends is refilled with the next game until the requested number of games has been played.
+class LockstepSimulator {
+public:
+    // Tile tables are read from the board definition once, up front, with the house rules applied
+    LockstepSimulator(const Board& board, int numPlayers, int maxRolls, const HouseRules& rules = HouseRules());
+
+    // Play games [firstSeed, firstSeed + numGames) and aggregate their results; each game's summary
+    // is also passed to `sink` when given
+    SimStats run(uint32_t firstSeed, int numGames, GameSink* sink = nullptr);
+
+private:
+    // Board tables (same for every lane)
+    std::array<int32_t, kBoardTiles> tileKind{};
+    std::array<int32_t, kBoardTiles> tilePrice{};     // Purchase price, or the tax amount on tax tiles
+    std::array<int32_t, kBoardTiles> tileRent{};      // Rent without buildings
+    HouseRules rules;
+    int32_t utilityRentOne;   // Utility rent per pip in percent: one utility owned
+    int32_t utilityRentTwo;   // ... and both owned
+    int32_t nearestRailroadRent;
+    std::array<int32_t, kBoardTiles> nextUtility{};   // Nearest utility ahead of each tile
+    std::array<int32_t, kBoardTiles> nextRailroad{};  // Nearest railroad ahead of each tile
+    int numPlayers;
+    int maxRolls;
+
+    // Per-seat lane state, one array per field
+    LaneInt seatState[kMaxSimPlayers];  // Position, jail flag, jail turns and jail card, packed (loadSeat)
+    LaneInt money[kMaxSimPlayers];
+    LaneInt alive[kMaxSimPlayers];
+    LaneInt propertyCount[kMaxSimPlayers];
+    LaneInt utilityCount[kMaxSimPlayers];
+    LaneInt rentEarned[kMaxSimPlayers];
+    LaneInt nextSeat[kMaxSimPlayers];       // Ring of the seats still in play (Game::nextSeat); a bankrupt
+    LaneInt previousSeat[kMaxSimPlayers];   // seat keeps its link to the next one
+
+    // The current seat's turn state. A step loads it from the per-seat arrays, plays the turn on these
+    // and stores it back, so a turn touches the arrays a fixed number of times.
+    LaneInt seatPosition;
+    LaneInt seatMoney;
+    LaneInt seatInJail;
+    LaneInt seatJailTurns;
+    LaneInt seatJailCard;               // -1 while holding a Get Out of Jail Free card
+
+    // Per-tile lane state
+    LaneInt owner[kBoardTiles];     // Seat owning the tile, -1 for the bank
+    LaneInt mortgaged[kBoardTiles]; // -1 while the tile is mortgaged
+    LaneInt landings[kBoardTiles];
+    LaneInt rentCollected[kBoardTiles];
+
+    // Per-game lane state
+    LaneInt current;
+    LaneInt doubles;
+    LaneInt rolls;
+    LaneInt aliveCount;
+    LaneInt mortgageCount;          // Mortgaged tiles in the game
+    LaneInt active;
+    LaneUInt rng;
+    std::array<uint32_t, kLanes> laneSeed{};
+
+    // Bankruptcies and finished games raised during the current step
+    LaneInt bankrupt;
+    LaneInt creditor;
+    LaneInt gameOver;
+    LaneInt winner;
+
+    // Bookkeeping for run()
+    SimStats stats;
+    GameSink* sink = nullptr;
+    uint32_t nextSeed = 0;
+    int gamesLeft = 0;
+
+    LaneUInt nextRandom();
+    LaneInt pick(const LaneInt* perSeat, LaneInt seat) const;
+    void addTo(LaneInt* perSeat, LaneInt seat, LaneInt mask, LaneInt delta);
+    void put(LaneInt* perSeat, LaneInt seat, LaneInt mask, LaneInt value);
+    void loadSeat();
+    void storeSeat(LaneInt mask);
+    void credit(LaneInt seat, LaneInt mask, LaneInt amount);  // Money to any seat, the current one included
+    LaneInt lookup(const std::array<int32_t, kBoardTiles>& table, LaneInt tile) const;
+    LaneInt ownerOf(LaneInt tile) const;
+    LaneInt mortgagedAt(LaneInt tile) const;
+
+    void step();
+    void sendToJail(LaneInt mask);
+    void settleProperty(LaneInt mask, LaneInt tile, LaneInt dice, LaneInt alwaysBuy, LaneInt fixedRent);
+    void auctionTile(LaneInt mask, LaneInt tile, LaneInt price, LaneInt isUtility);
+    void payRent(LaneInt mask, LaneInt toSeat, LaneInt amount, LaneInt tile);
+    LaneInt payBank(LaneInt mask, LaneInt amount);
+    void raiseCash(LaneInt mask, LaneInt amount);
+    void payOffMortgages(LaneInt mask);
+    void drawCard(LaneInt mask, LaneInt tile, LaneInt dice, LaneUInt random);
+    void settleBankruptcies(LaneInt mask);
+    LaneInt nextAliveSeat(LaneInt seat) const;
+    void startGame(int lane);
+    void finishGames(LaneInt mask, LaneInt winner);
+};
+
+#endif // LOCKSTEP_SIM_HPP
@@ -0,0 +1,203 @@
+#include "logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+thread_local int Logger::quietDepth = 0;
+
+namespace {
+
+// Buffer a LogLine formats into. It starts at one slot and grows for long messages, and each
+// thread keeps its own, so only the first long message of a thread allocates. Output past
+// kMaxMessageBytes is cut off.
+class LineBuffer : public std::streambuf {
+private:
+    std::vector<char> data;
+
+public:
+    LineBuffer() : data(Logger::kMessageBytes) { reset(); }
+
+    void reset() { setp(data.data(), data.data() + data.size()); }
+    const char* text() const { return pbase(); }
+    size_t length() const { return static_cast<size_t>(pptr() - pbase()); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+        if (data.size() >= Logger::kMaxMessageBytes) return traits_type::eof();
+        size_t used = length();
+        data.resize(std::min(data.size() * 2, Logger::kMaxMessageBytes));
+        setp(data.data(), data.data() + data.size());
+        pbump(static_cast<int>(used));
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+        return ch;
+    }
+};
+
+struct ThreadLine {
+    LineBuffer buffer;
+    std::ostream out{&buffer};
+};
+
+ThreadLine& threadLine() {
+    thread_local ThreadLine line;
+    return line;
+}
+
+const char* levelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "[debug] ";
+        case LogLevel::Warn: return "[warn] ";
+        case LogLevel::Error: return "[error] ";
+        default: return "";
+    }
+}
+
+} // namespace
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : slots(new Slot[kSlots]), sink(&std::cout) {
+    for (size_t i = 0; i < kSlots; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    stopping.store(true, std::memory_order_release);
+    wakeup.notify_one();
+    writer.join();  // The writer drains the ring before it exits
+    delete[] slots;
+}
+
+bool Logger::push(LogLevel level, const char* text, size_t length) {
+    length = std::min(length, kMaxMessageBytes);
+    size_t count = length > kMessageBytes ? (length + kMessageBytes - 1) / kMessageBytes : 1;
+
+    // Claim `count` consecutive slots. The writer frees slots in order, so once the last of them is
+    // free all of them are.
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        size_t last = pos + count - 1;
+        size_t sequence = slots[last & (kSlots - 1)].sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - last);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Full: the writer is a lap behind
+            if (!blocking.load(std::memory_order_relaxed)) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            wakeup.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t part = 0; part < count; ++part) {
+        Slot& slot = slots[(pos + part) & (kSlots - 1)];
+        size_t offset = part * kMessageBytes;
+        slot.level = level;
+        slot.length = static_cast<uint16_t>(std::min(length - offset, kMessageBytes));
+        slot.continued = part > 0;
+        slot.more = part + 1 < count;
+        std::memcpy(slot.text, text + offset, slot.length);
+        slot.sequence.store(pos + part + 1, std::memory_order_release);
+    }
+
+    if (writerIdle.load(std::memory_order_acquire)) {
+        wakeup.notify_one();
+    }
+    return true;
+}
+
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    wakeup.notify_one();
+    while (written.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+void Logger::setSink(std::ostream* out) {
+    flush();
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    sink = out;
+}
+
+void Logger::write(const Slot& slot) {
+    if (!sink) return;
+    if (!slot.continued) *sink << levelPrefix(slot.level);
+    sink->write(slot.text, slot.length);
+    if (!slot.more) sink->put('\n');
+}
+
+void Logger::run() {
+    size_t pos = 0;
+    uint64_t reported = 0;   // Drops already noted in the log
+    bool inMessage = false;  // The last slot written left its message unfinished
+    while (true) {
+        // Write everything that is ready, then flush the sink once for the whole batch
+        bool wrote = false;
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            while (true) {
+                Slot& slot = slots[pos & (kSlots - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+                write(slot);
+                inMessage = slot.more;
+                slot.sequence.store(pos + kSlots, std::memory_order_release);
+                ++pos;
+                wrote = true;
+            }
+            // Note drops between whole messages, so readers know the narration has gaps
+            uint64_t drops = droppedCount.load(std::memory_order_relaxed);
+            if (drops != reported && !inMessage) {
+                if (sink) *sink << levelPrefix(LogLevel::Warn) << drops - reported << " log messages dropped (log full)\n";
+                reported = drops;
+                wrote = true;
+            }
+            if (wrote && sink) sink->flush();
+        }
+        if (wrote) {
+            written.store(pos, std::memory_order_release);
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire)) return;
+
+        // Nothing ready: sleep until a producer or flush wakes us (the timeout covers a missed wakeup)
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerIdle.store(true, std::memory_order_release);
+        if (slots[pos & (kSlots - 1)].sequence.load(std::memory_order_acquire) != pos + 1 &&
+            !stopping.load(std::memory_order_acquire)) {
+            wakeup.wait_for(lock, std::chrono::milliseconds(5));
+        }
+        writerIdle.store(false, std::memory_order_relaxed);
+    }
+}
+
+LogLine::LogLine(LogLevel level) : level(level) {
+    ThreadLine& line = threadLine();
+    line.buffer.reset();
+    line.out.clear();
+}
+
+LogLine::~LogLine() {
+    ThreadLine& line = threadLine();
+    Logger::instance().push(level, line.buffer.text(), line.buffer.length());
+}
+
+std::ostream& LogLine::stream() {
+    return threadLine().out;
+}
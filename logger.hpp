@@ -0,0 +1,158 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+// Leveled game log with a background writer.
+//
+//   LOG_INFO(player->getName() << " pays $" << rent);   also LOG_DEBUG, LOG_WARN, LOG_ERROR
+//
+// A message is formatted on the calling thread into slots of a lock-free ring and written to the
+// sink by a background thread, so a turn never waits on the terminal. If the ring is full the
+// message is dropped and counted instead of blocking the game, and the writer notes the drop in the
+// log; setBlocking(true) waits for room instead, for the interactive game. Levels below
+// MONOPOLY_LOG_LEVEL (0 debug, 1 info, 2 warn, 3 error, 4 off; default 1) compile to nothing,
+// arguments included.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#ifndef MONOPOLY_LOG_LEVEL
+#define MONOPOLY_LOG_LEVEL 1
+#endif
+
+enum class LogLevel : uint8_t { Debug = 0, Info = 1, Warn = 2, Error = 3, Off = 4 };
+
+class Logger {
+public:
+    static constexpr size_t kSlots = 1024;        // Ring capacity, a power of two
+    static constexpr size_t kMessageBytes = 240;  // Per slot; a longer message takes consecutive slots
+    static constexpr size_t kMaxMessageBytes = kSlots * kMessageBytes;  // Longer messages are cut here
+
+    // The process-wide log; writes to std::cout until another sink is set
+    static Logger& instance();
+
+    // Whether a message at `level` would be recorded by the calling thread
+    static bool enabled(LogLevel level) {
+        return quietDepth == 0 && level >= instance().level();
+    }
+
+    // Queue a message; false if the ring was full and it was dropped
+    bool push(LogLevel level, const char* text, size_t length);
+
+    // Wait for room when the ring is full instead of dropping the message
+    void setBlocking(bool wait) { blocking.store(wait, std::memory_order_relaxed); }
+
+    // Block until every message queued so far has been written and the sink flushed
+    void flush();
+
+    // Write to `out` from now on (nullptr discards). Queued messages go to the old sink first.
+    void setSink(std::ostream* out);
+
+    // Runtime threshold on top of the compile-time one
+    void setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+    LogLevel level() const { return minLevel.load(std::memory_order_relaxed); }
+
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    friend class QuietOutput;
+
+    // One message, or part of one; `sequence` says whose turn the slot is (producer at pos, writer at pos + 1)
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogLevel level = LogLevel::Info;
+        uint16_t length = 0;
+        bool continued = false;   // Carries on the message of the slot before
+        bool more = false;        // The message carries on in the next slot
+        char text[kMessageBytes];
+    };
+
+    Slot* slots;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> written{0};
+    std::atomic<uint64_t> droppedCount{0};
+    std::atomic<LogLevel> minLevel{LogLevel::Info};
+    std::atomic<bool> blocking{false};
+
+    std::ostream* sink;
+    std::mutex sinkMutex;                  // Held by the writer while it writes a batch
+    std::mutex wakeMutex;
+    std::condition_variable wakeup;
+    std::atomic<bool> writerIdle{false};
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    static thread_local int quietDepth;    // QuietOutput guards active on this thread
+
+    Logger();
+    void run();
+    void write(const Slot& slot);
+};
+
+// Formats one message on the calling thread and queues it when the statement ends
+class LogLine {
+private:
+    LogLevel level;
+
+public:
+    explicit LogLine(LogLevel level);
+    ~LogLine();
+
+    std::ostream& stream();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+};
+
+// Silences the game log on the calling thread for the lifetime of the guard
+class QuietOutput {
+public:
+    QuietOutput() { ++Logger::quietDepth; }
+    ~QuietOutput() { --Logger::quietDepth; }
+
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+};
+
+#define LOG_AT(level, expr)                          \
+    do {                                             \
+        if (::Logger::enabled(level)) {              \
+            ::LogLine logLine(level);                \
+            logLine.stream() << expr;                \
+        }                                            \
+    } while (0)
+
+#if MONOPOLY_LOG_LEVEL <= 0
+#define LOG_DEBUG(expr) LOG_AT(LogLevel::Debug, expr)
+#else
+#define LOG_DEBUG(expr) do {} while (0)
+#endif
+
+#if MONOPOLY_LOG_LEVEL <= 1
+#define LOG_INFO(expr) LOG_AT(LogLevel::Info, expr)
+#else
+#define LOG_INFO(expr) do {} while (0)
+#endif
+
+#if MONOPOLY_LOG_LEVEL <= 2
+#define LOG_WARN(expr) LOG_AT(LogLevel::Warn, expr)
+#else
+#define LOG_WARN(expr) do {} while (0)
+#endif
+
+#if MONOPOLY_LOG_LEVEL <= 3
+#define LOG_ERROR(expr) LOG_AT(LogLevel::Error, expr)
+#else
+#define LOG_ERROR(expr) do {} while (0)
+#endif
+
+#endif // LOGGER_HPP
@@ -2,9 +2,12 @@
 #include <memory>
 #include "game.hpp"
 #include "player.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
 
 int main() {
     std::cout << "Welcome to the Interactive Monopoly Game!\n";
+    Logger::instance().setBlocking(true);  // A player reads every line; never drop narration
 
     // Create players
     auto player1 = std::make_shared<Player>("Alice", 1500);
@@ -22,6 +25,7 @@ int main() {
         auto currentPlayer = game.getCurrentPlayer();
         bool endTurn = false;
 
+        Logger::instance().flush();  // The previous turn's narration comes before the prompt
         std::cout << "\nIt's " << currentPlayer->getName() << "'s turn.\n";
 
         while (!endTurn && !exitFlag) {
@@ -53,5 +57,6 @@ int main() {
     }
 
     std::cout << "Game Over! Thanks for playing.\n";
+    PROFILE_DUMP("monopoly_profile.folded");
     return 0;
 }
@@ -2,55 +2,178 @@
 #include "tile.hpp"
 #include "cards.hpp"
 #include "game.hpp"
-#include <iostream>
+#include "logger.hpp"
+#include "cashRaising.hpp"
 #include <memory>
 
 void Player::offerToBuy(std::shared_ptr<Tile> property) {
     // Check if the property is a StreetTile
     if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
-        std::cout << "Player " << name << ", do you want to buy " << street->getName() 
-                  << "? (Price: $" << street->getBasePrice() << ")\n";
+        LOG_DEBUG("Player " << name << ", do you want to buy " << street->getName() << "? (Price: $" << street->getBasePrice() << ")");
         // Simulate a decision and proceed with the purchase
         if (money >= street->getBasePrice()) {
             buyProperty(property);
-            std::cout << name << " has bought " << street->getName() << "!\n";
+            LOG_INFO(name << " has bought " << street->getName() << "!");
         } else {
-            std::cout << name << " doesn't have enough money to buy " << street->getName() << ".\n";
+            LOG_INFO(name << " doesn't have enough money to buy " << street->getName() << ".");
         }
     }
     // Check if the property is a RailroadTile
     else if (auto railroad = std::dynamic_pointer_cast<RailroadTile>(property)) {
-        std::cout << "Player " << name << ", do you want to buy " << railroad->getName() 
-                  << "? (Price: $" << railroad->getPrice() << ")\n";
+        LOG_DEBUG("Player " << name << ", do you want to buy " << railroad->getName() << "? (Price: $" << railroad->getPrice() << ")");
         // Simulate a decision and proceed with the purchase
         if (money >= railroad->getPrice()) {
             buyProperty(property);
-            std::cout << name << " has bought " << railroad->getName() << "!\n";
+            LOG_INFO(name << " has bought " << railroad->getName() << "!");
         } else {
-            std::cout << name << " doesn't have enough money to buy " << railroad->getName() << ".\n";
+            LOG_INFO(name << " doesn't have enough money to buy " << railroad->getName() << ".");
         }
     }
     // Check if the property is a UtilityTile
     else if (property->getTileType() == "Utility") {
-        std::cout << "Player " << name << ", do you want to buy " << property->getName() 
-                  << "? (Price: $150)\n";
+        LOG_DEBUG("Player " << name << ", do you want to buy " << property->getName() << "? (Price: $150)");
         // Simulate a decision and proceed with the purchase
         if (money >= 150) {
             buyProperty(property);
-            std::cout << name << " has bought " << property->getName() << "!\n";
+            LOG_INFO(name << " has bought " << property->getName() << "!");
         } else {
-            std::cout << name << " doesn't have enough money to buy " << property->getName() << ".\n";
+            LOG_INFO(name << " doesn't have enough money to buy " << property->getName() << ".");
         }
     }
 }
 
 
 void Player::handleChanceCard(std::shared_ptr<Card> card, Game& game) {
-    std::cout << name << " has drawn a Chance card: " << card->getDescription() << "\n";
-    card->execute(shared_from_this(), game);  // Execute the effect of the Chance card
+    LOG_INFO(name << " has drawn a Chance card: " << card->getDescription());
+    card->execute(shared_from_this(), game, DeckKind::Chance);  // Execute the effect of the Chance card
 }
 
 void Player::handleCommunityChestCard(std::shared_ptr<Card> card, Game& game) {
-    std::cout << name << " has drawn a Community Chest card: " << card->getDescription() << "\n";
-    card->execute(shared_from_this(), game);  // Execute the effect of the Community Chest card
+    LOG_INFO(name << " has drawn a Community Chest card: " << card->getDescription());
+    card->execute(shared_from_this(), game, DeckKind::CommunityChest);  // Execute the effect of the Community Chest card
+}
+
+void Player::handleChanceCard(const CardSpec& card, Game& game) {
+    LOG_INFO(name << " has drawn a Chance card: " << card.description);
+    executeCard(card, shared_from_this(), game, DeckKind::Chance);
+}
+
+void Player::handleCommunityChestCard(const CardSpec& card, Game& game) {
+    LOG_INFO(name << " has drawn a Community Chest card: " << card.description);
+    executeCard(card, shared_from_this(), game, DeckKind::CommunityChest);
+}
+
+bool Player::mortgage(const std::shared_ptr<Tile>& property) {
+    if (property->isMortgaged() || !ownsProperty(property)) return false;
+    if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
+        if (street->getHouseCount() > 0 || street->isHotelBuilt()) return false;  // Sell the buildings first
+    }
+    int value = mortgageValue(property);
+    property->setMortgaged(true);
+    money += value;
+    saleValue -= value;
+    LOG_INFO(name << " mortgages " << property->getName() << " for $" << value << ".");
+    return true;
+}
+
+bool Player::unmortgage(const std::shared_ptr<Tile>& property) {
+    int cost = unmortgageCost(property);
+    if (!property->isMortgaged() || !ownsProperty(property) || money < cost) return false;
+    property->setMortgaged(false);
+    money -= cost;
+    saleValue += mortgageValue(property);
+    LOG_INFO(name << " pays off the mortgage on " << property->getName() << " for $" << cost << ".");
+    return true;
+}
+
+bool Player::payDebt(int amount, Player* creditor) {
+    if (amount <= 0) return true;  // Nothing owed (repairs with no buildings)
+    if (money >= amount || (raisesCash && raiseCash(amount))) {
+        money -= amount;
+        if (creditor) creditor->money += amount;
+        return true;
+    }
+    if (creditor) {
+        LOG_WARN(name << " can't pay $" << amount << " to " << creditor->getName() << " and is bankrupt!");
+        declareBankruptcy(*creditor);
+    } else {
+        LOG_WARN(name << " can't pay $" << amount << " to the bank and is bankrupt!");
+        declareBankruptcyToBank();
+    }
+    return false;
+}
+
+void Player::declareBankruptcyToBank() {
+    PROFILE_SCOPE("declareBankruptcy");
+    for (auto& property : ownedProperties) {
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
+            street->restoreBuildings(0, false);  // Back into the bank's stock
+        }
+        property->setMortgaged(false);
+        property->setOwner(nullptr);
+        LOG_INFO(property->getName() << " goes back to the bank.");
+    }
+    settleBankruptcy();
+}
+
+void Player::payOffMortgages(int reserve) {
+    for (const auto& property : ownedProperties) {
+        if (property->isMortgaged() && money - unmortgageCost(property) >= reserve) {
+            unmortgage(property);
+        }
+    }
+}
+
+bool Player::raiseCash(int amount) {
+    if (money >= amount) return true;
+    if (getLiquidAssets() < amount) return false;
+
+    // Buildings first, one at a time from the most built-up street, which keeps the groups even
+    std::vector<StreetTile*> group;
+    while (money < amount) {
+        StreetTile* mostBuilt = nullptr;
+        for (const auto& property : ownedProperties) {
+            auto street = dynamic_cast<StreetTile*>(property.get());
+            if (street && street->buildingLevel() > (mostBuilt ? mostBuilt->buildingLevel() : 0)) mostBuilt = street;
+        }
+        if (!mostBuilt) break;
+
+        // Streets with buildings are only ever in groups the player owns outright
+        group.clear();
+        for (const auto& property : ownedProperties) {
+            auto street = dynamic_cast<StreetTile*>(property.get());
+            if (street && street->getColorGroup() == mostBuilt->getColorGroup()) group.push_back(street);
+        }
+        money += mostBuilt->sellBuilding(group);
+    }
+    if (money >= amount) return true;
+
+    // Then the set of mortgages that gives up the least rent
+    constexpr int kMaxCandidates = 32;
+    Tile* candidates[kMaxCandidates];
+    int values[kMaxCandidates];
+    int rents[kMaxCandidates];
+    int count = 0;
+    for (const auto& property : ownedProperties) {
+        if (property->isMortgaged() || count == kMaxCandidates) continue;
+        int rent = 0;
+        if (auto street = dynamic_cast<StreetTile*>(property.get())) {
+            rent = street->getBaseRent();
+        } else if (auto railroad = dynamic_cast<RailroadTile*>(property.get())) {
+            rent = railroad->calculateRent();
+        } else {
+            rent = (numberOfUtilities >= 2 ? 10 : 4) * 7;  // Utility rent on an average roll
+        }
+        candidates[count] = property.get();
+        values[count] = mortgageValue(property);
+        rents[count] = rent;
+        count++;
+    }
+    uint32_t plan = cheapestMortgages(values, rents, count, amount - money);
+    for (int i = 0; i < count; ++i) {
+        if (plan & (1u << i)) {
+            mortgage(candidates[i]->shared_from_this());
+        }
+    }
+    return money >= amount;
 }
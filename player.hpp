@@ -1,17 +1,22 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include "tile.hpp"
+#include "cards.hpp"
 #include "streetTile.hpp"
 #include "railroadTile.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
 
 // Forward declaration of classes to avoid circular dependencies
 class Card;
+struct CardSpec;
 class Game;
 
 class Player : public std::enable_shared_from_this<Player> {
@@ -24,8 +29,40 @@ private:
     int lastDiceRoll;                        // Last dice roll result
     int numberOfUtilities;  
     int numberOfRailroads;                    // Track number of railroads owned
-    bool hasGetOutOfJailCard;
+    std::array<uint8_t, kDeckKinds> jailCards{};  // Get Out of Jail Free cards held, by the deck they came from
     sf::Color playerColor;
+    int houseCount = 0;                      // Houses standing on owned streets
+    int hotelCount = 0;                      // Hotels standing on owned streets
+    int propertyValue = 0;                   // Purchase prices of owned properties plus the cost of their buildings
+    int rentEarned = 0;                      // Rent collected from other players
+    int saleValue = 0;                       // Cash that selling every building and mortgaging every property would raise
+    bool raisesCash = true;                  // Sell and mortgage to pay rent rather than go bankrupt
+    bool bankrupt = false;                   // Set when a debt could not be covered
+
+    // Out of the game with nothing left
+    void settleBankruptcy() {
+        ownedProperties.clear();
+        houseCount = 0;
+        hotelCount = 0;
+        propertyValue = 0;
+        saleValue = 0;
+        numberOfUtilities = 0;
+        numberOfRailroads = 0;
+        money = 0;
+        bankrupt = true;
+    }
+
+    // Add a newly owned property and its buildings to the asset totals
+    void addAssets(const std::shared_ptr<Tile>& property) {
+        propertyValue += purchasePrice(property);
+        if (!property->isMortgaged()) saleValue += mortgageValue(property);
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
+            houseCount += street->getHouseCount();
+            hotelCount += street->isHotelBuilt() ? 1 : 0;
+            propertyValue += street->buildingValue();
+            saleValue += street->buildingValue() / 2;
+        }
+    }
     
 
 public:
@@ -35,7 +72,7 @@ public:
 
     // Constructor
     Player(const std::string& name, int startingMoney = 1500)
-        : name(name), money(startingMoney), location(0), inJail(false), jailTurns(0), lastDiceRoll(0), numberOfUtilities(0), numberOfRailroads(0), hasGetOutOfJailCard(false) {}
+        : name(name), money(startingMoney), location(0), inJail(false), jailTurns(0), lastDiceRoll(0), numberOfUtilities(0), numberOfRailroads(0) {}
     
     Player(sf::Color c, int startLocation = 0)
         : color(c), location(startLocation) {}
@@ -49,9 +86,9 @@ public:
     // Adjust player's money
     void adjustMoney(int amount) { money += amount; }
 
-    // Check if the player is bankrupt
+    // Check if the player is bankrupt: a debt went unpaid, or nothing is left to play with
     bool isBankrupt() const {
-     return money == 0 && ownedProperties.empty();
+     return bankrupt || (money <= 0 && ownedProperties.empty());
     }
 
 
@@ -95,17 +132,21 @@ public:
         return !(*this == other);
     }
 
+    // Shared handle to this player for tile ownership. Players that are not managed by a
+    // shared_ptr (e.g. stack objects in tests) fall back to a detached copy.
+    std::shared_ptr<Player> selfOrCopy() {
+        if (auto self = weak_from_this().lock()) {
+            return self;
+        }
+        return std::make_shared<Player>(*this);
+    }
+
     // Jail management
     bool isInJail() const { return inJail; }
     void goToJail() { inJail = true; location = 10; jailTurns = 0; }
     void releaseFromJail() { inJail = false; }
-    void handleJailTurn() {
-        jailTurns++;
-        if (jailTurns >= 3) {
-            adjustMoney(-50);  // Pay to leave jail after 3 turns
-            releaseFromJail();
-        }
-    }
+    int getJailTurns() const { return jailTurns; }
+    void serveJailTurn() { jailTurns++; }  // A missed roll for doubles (Game::playTurn)
 
     // Track dice rolls
     void setLastDiceRoll(int roll) { lastDiceRoll = roll; }
@@ -120,84 +161,176 @@ public:
     int getNumberOfUtilities() const { return numberOfUtilities; }
     void incrementUtilitiesOwned() { ++numberOfUtilities; }
 
-    // Buy property and manage ownership
-    void buyProperty(std::shared_ptr<Tile> property) {
-        ownedProperties.push_back(property);
-        property->setOwner(std::make_shared<Player>(*this));  // Transfer ownership
-    
+    // Price of a street, railroad or utility deed
+    static int purchasePrice(const std::shared_ptr<Tile>& property) {
         if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
-            adjustMoney(-street->getBasePrice());
+            return street->getBasePrice();
         } else if (auto railroad = std::dynamic_pointer_cast<RailroadTile>(property)) {
-            adjustMoney(-railroad->getPrice());
+            return railroad->getPrice();
         } else if (property->getTileType() == "Utility") {
-            adjustMoney(-150);  // Assuming utility costs 150
+            return 150;  // Assuming utility costs 150
+        }
+        return 0;
+    }
+
+    // What the bank lends on a property: half its price. Paying the mortgage off costs 10% more.
+    static int mortgageValue(const std::shared_ptr<Tile>& property) { return purchasePrice(property) / 2; }
+    static int unmortgageCost(const std::shared_ptr<Tile>& property) { return mortgageValue(property) * 11 / 10; }
+
+    // Buy property and manage ownership
+    void buyProperty(std::shared_ptr<Tile> property) {
+        ownedProperties.push_back(property);
+        property->setOwner(selfOrCopy());  // Transfer ownership
+        addAssets(property);
+
+        adjustMoney(-purchasePrice(property));
+        if (property->getTileType() == "Utility") {
             incrementUtilitiesOwned();  // Increment the count of utilities owned
         }
     }
 
+    // Buy a property for a price other than its list price (auctions)
+    void buyProperty(std::shared_ptr<Tile> property, int price) {
+        acquireProperty(property);
+        property->setOwner(selfOrCopy());
+        adjustMoney(-price);
+    }
+
+    // Take over a property without paying for it (bankruptcy transfers)
+    void acquireProperty(std::shared_ptr<Tile> property) {
+        ownedProperties.push_back(property);
+        addAssets(property);
+        if (property->getTileType() == "Utility") {
+            incrementUtilitiesOwned();
+        }
+    }
+
+    // Hand a property on without being paid for it here (trades); the caller sets the new owner.
+    // Streets must have no buildings.
+    void releaseProperty(const std::shared_ptr<Tile>& property) {
+        auto it = std::find(ownedProperties.begin(), ownedProperties.end(), property);
+        if (it == ownedProperties.end()) return;
+        ownedProperties.erase(it);
+        propertyValue -= purchasePrice(property);
+        if (!property->isMortgaged()) saleValue -= mortgageValue(property);
+        if (property->getTileType() == "Utility") {
+            --numberOfUtilities;
+        }
+    }
+
+    // Called by a street when a building goes up on it
+    void recordBuildings(int housesAdded, int hotelsAdded, int valueAdded) {
+        houseCount += housesAdded;
+        hotelCount += hotelsAdded;
+        propertyValue += valueAdded;
+        saleValue += valueAdded / 2;  // Buildings sell back to the bank at half their cost
+    }
+
+    // Mortgage an owned property without buildings for its mortgage value; false if it can't be
+    bool mortgage(const std::shared_ptr<Tile>& property);
+
+    // Pay off a mortgage (its value plus 10%); false if not mortgaged, not owned or not affordable
+    bool unmortgage(const std::shared_ptr<Tile>& property);
+
+    // Bring cash up to `amount` by selling buildings (from the most built-up street down), then by
+    // mortgaging the properties whose rent is cheapest to give up (cheapestMortgages). Changes
+    // nothing and returns false when even that would fall short.
+    bool raiseCash(int amount);
+
+    // Off for the random policy of the simulators, which neither builds nor mortgages
+    void setRaisesCash(bool enabled) { raisesCash = enabled; }
+
+    // Pay off mortgages, in the order the properties were acquired, while `reserve` dollars stay in hand
+    void payOffMortgages(int reserve);
+
+    // Put back the per-turn fields of a saved game; properties are re-added with acquireProperty first
+    void restoreState(int savedMoney, int position, bool jailed, int turnsInJail, int diceRoll, int utilities,
+                      const std::array<uint8_t, kDeckKinds>& heldJailCards) {
+        money = savedMoney;
+        location = position;
+        inJail = jailed;
+        jailTurns = turnsInJail;
+        lastDiceRoll = diceRoll;
+        numberOfUtilities = utilities;
+        jailCards = heldJailCards;
+    }
+
     // Offer to buy a property
     void offerToBuy(std::shared_ptr<Tile> property);
 
-    // Pay rent to another player
-    void payRent(Player& owner, int rentAmount) {
-    if (money >= rentAmount) {
-        // Player has enough money to pay rent
-        adjustMoney(-rentAmount);  // Deduct rent from the current player
-        owner.adjustMoney(rentAmount);  // Add rent to the owner
-        std::cout << getName() << " paid $" << rentAmount << " in rent to " << owner.getName() << ".\n";
-    } else {
-        // Player doesn't have enough money, trigger bankruptcy
-        std::cout << getName() << " can't afford the rent of $" << rentAmount << " and is bankrupt!\n";
-        declareBankruptcy(owner);
+    // The one way debts are settled, to another player (`creditor`) or to the bank (null). Short of
+    // cash, the player sells and mortgages first (raiseCash); if even that falls short the player is
+    // bankrupt: everything goes to the creditor, or back to the bank. False on bankruptcy.
+    bool payDebt(int amount, Player* creditor);
+
+    // Pay rent to another player through payDebt; returns false if the player couldn't pay and went
+    // bankrupt instead
+    bool payRent(Player& owner, int rentAmount) {
+    if (payDebt(rentAmount, &owner)) {
+        owner.rentEarned += rentAmount;
+        LOG_INFO(getName() << " paid $" << rentAmount << " in rent to " << owner.getName() << ".");
+        return true;
     }
+    return false;
 }
 
 void declareBankruptcy(Player& owner) {
-    std::cout << getName() << " is bankrupt and must transfer all properties to " << owner.getName() << ".\n";
+    PROFILE_SCOPE("declareBankruptcy");
+    LOG_WARN(getName() << " is bankrupt and must transfer all properties to " << owner.getName() << ".");
     for (auto& property : ownedProperties) {
-        property->setOwner(std::make_shared<Player>(owner));
-        std::cout << owner.getName() << " now owns " << property->getName() << ".\n";
-    }
-    ownedProperties.clear();
-    money = 0;
-}
-
- int getHouseCount() const {
-        int houseCount = 0;
-        for (const auto& property : ownedProperties) {
-            if (auto street = std::dynamic_pointer_cast<StreetTile>(property)) {
-                houseCount += street->getHouseCount();
-            }
+        property->setOwner(owner.selfOrCopy());
+        if (&owner != this) {
+            owner.acquireProperty(property);  // Card rent can be owed to oneself; don't grow the list being walked
         }
-        return houseCount;
+        LOG_INFO(owner.getName() << " now owns " << property->getName() << ".");
     }
-
-    int getHotelCount() const {
-    int hotelCount = 0;
-    for (const auto& property : ownedProperties) {
-        auto street = std::dynamic_pointer_cast<StreetTile>(property);
-        if (street && street->isHotelBuilt()) {
-            hotelCount++;
+    if (&owner != this) {
+        if (money > 0) owner.money += money;  // The creditor takes the cash left too
+        for (int deck = 0; deck < kDeckKinds; ++deck) {
+            owner.jailCards[deck] += jailCards[deck];  // ... and any Get Out of Jail Free cards
+            jailCards[deck] = 0;
         }
     }
-    return hotelCount;
+    settleBankruptcy();
 }
 
-
-    void receiveGetOutOfJailCard() { hasGetOutOfJailCard = true; }
-    bool hasGetOutOfJailFreeCard() const { return hasGetOutOfJailCard; }
-    void useGetOutOfJailCard() { hasGetOutOfJailCard = false; }
+    // Bankrupt to the bank: buildings go back to its stock and properties go back on sale, unmortgaged.
+    // Held Get Out of Jail Free cards go back to their decks when the game takes the player out.
+    void declareBankruptcyToBank();
+
+    // Asset totals, kept current on every purchase, build and transfer
+    int getHouseCount() const { return houseCount; }
+    int getHotelCount() const { return hotelCount; }
+    int getPropertyValue() const { return propertyValue; }
+    int getNetWorth() const { return money + propertyValue; }
+    int getLiquidAssets() const { return money + saleValue; }  // Most cash raiseCash can reach
+    int getRentEarned() const { return rentEarned; }
+
+    // Get Out of Jail Free cards are counted per deck, so each one goes back where it came from
+    void receiveGetOutOfJailCard(DeckKind from = DeckKind::Chance) { ++jailCards[static_cast<int>(from)]; }
+    bool hasGetOutOfJailFreeCard() const { return getOutOfJailCardCount() > 0; }
+    int getOutOfJailCardCount() const { return jailCards[0] + jailCards[1]; }
+    int getOutOfJailCardCount(DeckKind from) const { return jailCards[static_cast<int>(from)]; }
+    const std::array<uint8_t, kDeckKinds>& getJailCards() const { return jailCards; }
+    // Give up one held card, Chance first; returns the deck it came from
+    DeckKind useGetOutOfJailCard() {
+        DeckKind from = jailCards[0] > 0 ? DeckKind::Chance : DeckKind::CommunityChest;
+        if (jailCards[static_cast<int>(from)] > 0) --jailCards[static_cast<int>(from)];
+        return from;
+    }
 
     int getNumberOfRailroads() const { return numberOfRailroads; }
     void incrementRailroadsOwned() { ++numberOfRailroads; }
 
-    // Pay tax
-    void payTax(int taxAmount) {
-        adjustMoney(-taxAmount);  // Deduct tax from player
+    // Pay tax to the bank; false if it made the player bankrupt
+    bool payTax(int taxAmount) {
+        return payDebt(taxAmount, nullptr);
     }
 
     void handleChanceCard(std::shared_ptr<Card> card, Game& game);
     void handleCommunityChestCard(std::shared_ptr<Card> card, Game& game);
+    void handleChanceCard(const CardSpec& card, Game& game);
+    void handleCommunityChestCard(const CardSpec& card, Game& game);
 
     // Display player info
     void displayPlayerInfo() const {
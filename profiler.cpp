@@ -0,0 +1,131 @@
+#include "profiler.hpp"
+
+#ifdef MONOPOLY_PROFILE
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace profiler {
+
+namespace {
+
+// Head of the lock-free list of every thread that has recorded something
+std::atomic<ThreadData*> registry{nullptr};
+
+struct StackTotals {
+    uint64_t calls = 0;
+    uint64_t totalNanos = 0;
+    uint64_t selfNanos = 0;
+};
+
+bool sameName(const char* a, const char* b) {
+    return a == b || std::strcmp(a, b) == 0;
+}
+
+void collect(const ThreadData& data, int index, const std::string& path, std::map<std::string, StackTotals>& stacks) {
+    const Node& node = data.nodes[index];
+    uint64_t childNanos = 0;
+    for (int child : node.children) {
+        const Node& childNode = data.nodes[child];
+        childNanos += childNode.totalNanos;
+        collect(data, child, path.empty() ? childNode.name : path + ";" + childNode.name, stacks);
+    }
+    if (index == 0) return;  // The root is not a real scope
+
+    StackTotals& totals = stacks[path];
+    totals.calls += node.calls;
+    totals.totalNanos += node.totalNanos;
+    totals.selfNanos += node.totalNanos > childNanos ? node.totalNanos - childNanos : 0;
+}
+
+// Merge the call trees of all threads by stack path
+std::map<std::string, StackTotals> mergeStacks() {
+    std::map<std::string, StackTotals> stacks;
+    for (ThreadData* data = registry.load(std::memory_order_acquire); data != nullptr; data = data->next) {
+        collect(*data, 0, "", stacks);
+    }
+    return stacks;
+}
+
+std::map<std::string, uint64_t> mergeCounters() {
+    std::map<std::string, uint64_t> counters;
+    for (ThreadData* data = registry.load(std::memory_order_acquire); data != nullptr; data = data->next) {
+        for (const auto& counter : data->counters) {
+            counters[counter.first] += counter.second;
+        }
+    }
+    return counters;
+}
+
+ThreadData* registerThread() {
+    ThreadData* data = new ThreadData();  // Never freed: reports may run after the thread has exited
+    data->next = registry.load(std::memory_order_relaxed);
+    while (!registry.compare_exchange_weak(data->next, data, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return data;
+}
+
+} // namespace
+
+int ThreadData::enter(const char* name) {
+    for (int child : nodes[current].children) {
+        if (sameName(nodes[child].name, name)) {
+            current = child;
+            return child;
+        }
+    }
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back(name, current);
+    nodes[current].children.push_back(index);
+    current = index;
+    return index;
+}
+
+void ThreadData::count(const char* name) {
+    for (auto& counter : counters) {
+        if (sameName(counter.first, name)) {
+            counter.second++;
+            return;
+        }
+    }
+    counters.emplace_back(name, 1);
+}
+
+ThreadData& threadData() {
+    thread_local ThreadData* data = registerThread();
+    return *data;
+}
+
+void writeFoldedStacks(std::ostream& out) {
+    for (const auto& stack : mergeStacks()) {
+        if (stack.second.selfNanos > 0) {
+            out << stack.first << " " << stack.second.selfNanos << "\n";
+        }
+    }
+}
+
+void writeSummary(std::ostream& out) {
+    out << "calls\ttotal_us\tmean_ns\tstack\n";
+    for (const auto& stack : mergeStacks()) {
+        const StackTotals& totals = stack.second;
+        uint64_t mean = totals.calls > 0 ? totals.totalNanos / totals.calls : 0;
+        out << totals.calls << "\t" << totals.totalNanos / 1000 << "\t" << mean << "\t" << stack.first << "\n";
+    }
+    for (const auto& counter : mergeCounters()) {
+        out << counter.second << "\t-\t-\t#" << counter.first << "\n";
+    }
+}
+
+void dump(const char* path) {
+    std::ofstream file(path);
+    writeFoldedStacks(file);
+    writeSummary(std::cout);
+}
+
+} // namespace profiler
+
+#endif // MONOPOLY_PROFILE
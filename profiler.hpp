@@ -0,0 +1,101 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+// Turn-level profiling, compiled in only when MONOPOLY_PROFILE is defined (make PROFILE=1).
+//
+//   PROFILE_SCOPE("name");   times the enclosing block as a child of the current scope
+//   PROFILE_COUNT("name");   bumps a named event counter
+//   PROFILE_DUMP("file");    writes the folded-stack report to a file and a summary to std::cout
+//
+// Every thread records into its own call tree, so the hot path takes no locks. Reports merge all
+// threads and should be taken once the worker threads are idle. Scope names must be string literals.
+// Without MONOPOLY_PROFILE the macros expand to nothing.
+
+#ifdef MONOPOLY_PROFILE
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace profiler {
+
+// One scope in a thread's call tree
+struct Node {
+    const char* name;
+    int parent;
+    uint64_t calls = 0;
+    uint64_t totalNanos = 0;
+    std::vector<int> children;
+
+    Node(const char* name, int parent) : name(name), parent(parent) {}
+};
+
+// Call tree and counters of one thread; only the owning thread writes to it
+struct ThreadData {
+    std::vector<Node> nodes;                                // nodes[0] is the root
+    std::vector<std::pair<const char*, uint64_t>> counters;
+    int current = 0;
+    ThreadData* next = nullptr;                             // Link in the registry of all threads
+
+    ThreadData() { nodes.emplace_back("root", -1); }
+
+    // Child of the current scope with this name (created on first use); becomes the current scope
+    int enter(const char* name);
+    void count(const char* name);
+};
+
+// The calling thread's data, registered on first use and kept alive for later reports
+ThreadData& threadData();
+
+// Times the enclosing block
+class ScopedTimer {
+private:
+    ThreadData& data;
+    int previous;
+    int node;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(const char* name)
+        : data(threadData()), previous(data.current), node(data.enter(name)), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Node& entry = data.nodes[node];
+        entry.calls++;
+        entry.totalNanos += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        data.current = previous;
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// "a;b;c <self nanoseconds>" per call stack, merged over all threads (flamegraph.pl, speedscope)
+void writeFoldedStacks(std::ostream& out);
+
+// Calls, total and mean time per call stack, followed by the counters
+void writeSummary(std::ostream& out);
+
+// Write the folded stacks to `path` and the summary to std::cout
+void dump(const char* path);
+
+} // namespace profiler
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ::profiler::ScopedTimer PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_COUNT(name) ::profiler::threadData().count(name)
+#define PROFILE_DUMP(path) ::profiler::dump(path)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_COUNT(name) do {} while (0)
+#define PROFILE_DUMP(path) do {} while (0)
+
+#endif // MONOPOLY_PROFILE
+
+#endif // PROFILER_HPP
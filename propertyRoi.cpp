@@ -0,0 +1,41 @@
+#include "propertyRoi.hpp"
+#include "board.hpp"
+#include "streetTile.hpp"
+
+namespace {
+
+double turnsToRepay(int cost, double income) {
+    return income > 0.0 ? cost / income : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+PropertyRoi::PropertyRoi(const Board& board, const LandingModel& model) {
+    for (auto& levels : table) {
+        for (StreetRoi& entry : levels) {
+            entry.breakEven = entry.stepBreakEven = std::numeric_limits<double>::infinity();
+        }
+    }
+    for (int t = 0; t < board.getTileCount() && t < kBoardTiles; ++t) {
+        if (board.getTileKind(t) != TileKind::Street) continue;
+        const auto& street = static_cast<const StreetTile&>(*board.getTile(t));
+        double landing = model.probability(t);
+        for (int level = 0; level < kBuildLevels; ++level) {
+            StreetRoi& entry = table[t][level];
+            entry.income = landing * street.rentAt(level);
+            entry.invested = street.getBasePrice() + street.buildingValueAt(level);
+            entry.breakEven = turnsToRepay(entry.invested, entry.income);
+            if (level == 0) {
+                entry.stepBreakEven = entry.breakEven;  // The purchase itself
+            } else {
+                const StreetRoi& below = table[t][level - 1];
+                entry.stepBreakEven = turnsToRepay(entry.invested - below.invested, entry.income - below.income);
+            }
+        }
+    }
+}
+
+double PropertyRoi::nextBuildRounds(int tile, int level, int opponents) const {
+    if (level < 0 || level + 1 >= kBuildLevels || opponents <= 0) return std::numeric_limits<double>::infinity();
+    return at(tile, level + 1).stepBreakEven / opponents;
+}
@@ -0,0 +1,45 @@
+#ifndef PROPERTY_ROI_HPP
+#define PROPERTY_ROI_HPP
+
+#include <array>
+#include <limits>
+#include "landingModel.hpp"
+
+class Board;
+
+constexpr int kBuildLevels = 6;  // No buildings, one to four houses, a hotel (StreetTile::buildingLevel)
+
+// Return on one street at one building level
+struct StreetRoi {
+    double income = 0.0;            // Expected rent per opponent turn (landing probability x rent)
+    int invested = 0;               // Price plus the buildings standing at this level
+    double breakEven = 0.0;         // Opponent turns for the rent to repay `invested`
+    double stepBreakEven = 0.0;     // Opponent turns for the extra rent to repay the last building
+};
+
+// Payback of buying and building on every street, from the landing model and each street's rent
+// schedule, houseCost and hotelCost. Built once per board; every query is a table lookup. Tiles that
+// are not streets, and levels that earn nothing, never break even (infinite turns).
+class PropertyRoi {
+private:
+    std::array<std::array<StreetRoi, kBuildLevels>, kBoardTiles> table{};
+
+public:
+    PropertyRoi(const Board& board, const LandingModel& model);
+
+    // The entry for a tile at a building level (clamped to 0..5)
+    const StreetRoi& at(int tile, int level) const {
+        level = level < 0 ? 0 : level >= kBuildLevels ? kBuildLevels - 1 : level;
+        return table[tile >= 0 && tile < kBoardTiles ? tile : 0][level];
+    }
+
+    // Rounds of play for the buildings at `level` to pay for themselves against `opponents` players
+    double breakEvenRounds(int tile, int level, int opponents) const {
+        return opponents > 0 ? at(tile, level).breakEven / opponents : std::numeric_limits<double>::infinity();
+    }
+
+    // Rounds for the next building on a street at `level` to pay for itself; infinite at a hotel
+    double nextBuildRounds(int tile, int level, int opponents) const;
+};
+
+#endif // PROPERTY_ROI_HPP
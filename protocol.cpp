@@ -0,0 +1,237 @@
+#include "protocol.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace protocol {
+
+namespace {
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 24));
+}
+
+uint32_t getU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+std::runtime_error socketError(const char* what) {
+    return std::runtime_error(std::string(what) + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+void encode(const Request& request, std::vector<uint8_t>& out) {
+    out.push_back(static_cast<uint8_t>(request.op));
+    out.push_back(request.seat);
+    out.push_back(request.tile);
+    out.push_back(request.flags);
+    putU32(out, request.table);
+    putU32(out, request.arg);
+}
+
+void encode(const Response& response, std::vector<uint8_t>& out) {
+    out.push_back(static_cast<uint8_t>(response.op));
+    out.push_back(static_cast<uint8_t>(response.status));
+    out.push_back(response.currentSeat);
+    out.push_back(response.seatCount);
+    putU32(out, response.table);
+    putU32(out, response.rolls);
+    for (int i = 0; i < response.seatCount; ++i) {
+        const SeatState& seat = response.seats[i];
+        putU32(out, static_cast<uint32_t>(seat.money));
+        out.push_back(seat.position);
+        out.push_back(seat.flags);
+        out.push_back(seat.houses);
+        out.push_back(seat.hotels);
+    }
+}
+
+void encode(uint32_t table, const uint8_t* update, size_t size, std::vector<uint8_t>& out) {
+    out.push_back(static_cast<uint8_t>(Op::Update));
+    out.insert(out.end(), 3, 0);
+    putU32(out, table);
+    putU32(out, static_cast<uint32_t>(size));
+    out.insert(out.end(), update, update + size);
+}
+
+size_t decode(const uint8_t* data, size_t size, Request& request) {
+    if (size < kRequestBytes) return 0;
+    request.op = static_cast<Op>(data[0]);
+    request.seat = data[1];
+    request.tile = data[2];
+    request.flags = data[3];
+    request.table = getU32(data + 4);
+    request.arg = getU32(data + 8);
+    return kRequestBytes;
+}
+
+size_t decode(const uint8_t* data, size_t size, Response& response) {
+    if (size < kResponseHeaderBytes) return 0;
+    int seatCount = data[3] < kMaxSeats ? data[3] : kMaxSeats;
+    size_t length = kResponseHeaderBytes + data[3] * kSeatBytes;
+    if (size < length) return 0;
+
+    response.op = static_cast<Op>(data[0]);
+    response.status = static_cast<ReplyStatus>(data[1]);
+    response.currentSeat = data[2];
+    response.seatCount = static_cast<uint8_t>(seatCount);
+    response.table = getU32(data + 4);
+    response.rolls = getU32(data + 8);
+    for (int i = 0; i < seatCount; ++i) {
+        const uint8_t* record = data + kResponseHeaderBytes + i * kSeatBytes;
+        SeatState& seat = response.seats[i];
+        seat.money = static_cast<int32_t>(getU32(record));
+        seat.position = record[4];
+        seat.flags = record[5];
+        seat.houses = record[6];
+        seat.hotels = record[7];
+    }
+    return length;
+}
+
+size_t decode(const uint8_t* data, size_t size, Update& update) {
+    if (size < kUpdateHeaderBytes) return 0;
+    size_t length = getU32(data + 8);
+    if (size - kUpdateHeaderBytes < length) return 0;
+
+    update.table = getU32(data + 4);
+    update.data.assign(data + kUpdateHeaderBytes, data + kUpdateHeaderBytes + length);
+    return kUpdateHeaderBytes + length;
+}
+
+const char* statusName(ReplyStatus status) {
+    switch (status) {
+        case ReplyStatus::Ok: return "ok";
+        case ReplyStatus::BadRequest: return "bad request";
+        case ReplyStatus::UnknownTable: return "unknown table";
+        case ReplyStatus::NotAllowed: return "not allowed";
+        case ReplyStatus::GameOver: return "game over";
+        case ReplyStatus::ServerFull: return "server full";
+    }
+    return "unknown";
+}
+
+Client::~Client() {
+    close();
+}
+
+void Client::connectUnix(const std::string& path) {
+    close();
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw socketError("socket");
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        auto error = socketError("connect");
+        close();
+        throw error;
+    }
+}
+
+void Client::connectTcp(uint16_t port) {
+    close();
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw socketError("socket");
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        auto error = socketError("connect");
+        close();
+        throw error;
+    }
+    int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+void Client::send(const Request& request) {
+    std::vector<uint8_t> bytes;
+    encode(request, bytes);
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        ssize_t n = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("send");
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+void Client::readMore() {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n == 0) throw std::runtime_error("Server closed the connection");
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("recv");
+        }
+        in.insert(in.end(), buffer, buffer + n);
+        return;
+    }
+}
+
+// Move a complete update at the front of `in` to `updates`
+bool Client::takeUpdate() {
+    if (in.empty() || in[0] != static_cast<uint8_t>(Op::Update)) return false;
+    Update update;
+    size_t used = decode(in.data(), in.size(), update);
+    if (used == 0) return false;
+    in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(used));
+    updates.push_back(std::move(update));
+    return true;
+}
+
+Response Client::receive() {
+    Response response;
+    while (true) {
+        while (takeUpdate()) {
+        }
+        bool update = !in.empty() && in[0] == static_cast<uint8_t>(Op::Update);
+        size_t used = update ? 0 : decode(in.data(), in.size(), response);
+        if (used > 0) {
+            in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(used));
+            return response;
+        }
+        readMore();
+    }
+}
+
+Update Client::receiveUpdate() {
+    while (updates.empty()) {
+        if (!takeUpdate()) readMore();
+    }
+    Update update = std::move(updates.front());
+    updates.pop_front();
+    return update;
+}
+
+void Client::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    in.clear();
+    updates.clear();
+}
+
+} // namespace protocol
@@ -0,0 +1,147 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Binary request/response protocol of the game server (gameServer.hpp).
+//
+// A request is always kRequestBytes long:
+//   op u8 | seat u8 | tile u8 | flags u8 | table u32 | arg u32
+// A response is a fixed header followed by one record per seat:
+//   op u8 | status u8 | currentSeat u8 | seatCount u8 | table u32 | rolls u32
+//   seatCount x (money i32 | position u8 | flags u8 | houses u8 | hotels u8)
+// Integers are little-endian. Responses come back in request order, so clients may pipeline.
+//
+// A connection subscribed to a table also gets that table's state updates (stateSync.hpp), pushed
+// between responses whenever the table changes:
+//   op u8 (Update) | 3 zero bytes | table u32 | length u32 | length bytes of update
+namespace protocol {
+
+constexpr size_t kRequestBytes = 12;
+constexpr size_t kResponseHeaderBytes = 12;
+constexpr size_t kSeatBytes = 8;
+constexpr size_t kUpdateHeaderBytes = 12;
+constexpr int kMaxSeats = 16;
+
+enum class Op : uint8_t {
+    CreateTable = 1,  // seat = number of players (2-16), arg = seed; the new table id comes back in `table`
+    Roll = 2,         // Play the current player's turn
+    Buy = 3,          // `seat` buys the unowned tile it stands on
+    Build = 4,        // `seat` builds on street `tile`; flags & BuildHotel for a hotel instead of a house
+    Status = 5,       // Table state only
+    CloseTable = 6,
+    Subscribe = 7,    // Spectate: a keyframe of the table now, then its updates; again for a fresh keyframe
+    Unsubscribe = 8,
+    Update = 9        // Pushed by the server to subscribers, never a request
+};
+
+enum class ReplyStatus : uint8_t {
+    Ok = 0,
+    BadRequest = 1,    // Unknown op or argument out of range
+    UnknownTable = 2,
+    NotAllowed = 3,    // The move breaks the rules (not for sale, can't afford, uneven build, ...)
+    GameOver = 4,      // Only one player left
+    ServerFull = 5
+};
+
+// Request flag bits
+enum RequestFlag : uint8_t { BuildHotel = 1 };
+
+// Seat flag bits
+enum SeatFlag : uint8_t { Bankrupt = 1, InJail = 2, HoldsJailCard = 4 };
+
+struct Request {
+    Op op = Op::Status;
+    uint8_t seat = 0;
+    uint8_t tile = 0;
+    uint8_t flags = 0;
+    uint32_t table = 0;
+    uint32_t arg = 0;
+};
+
+struct SeatState {
+    int32_t money = 0;
+    uint8_t position = 0;
+    uint8_t flags = 0;  // SeatFlag bits
+    uint8_t houses = 0;
+    uint8_t hotels = 0;
+};
+
+struct Response {
+    Op op = Op::Status;
+    ReplyStatus status = ReplyStatus::Ok;
+    uint8_t currentSeat = 0;
+    uint8_t seatCount = 0;  // 0 when there is no table to report
+    uint32_t table = 0;
+    uint32_t rolls = 0;
+    std::array<SeatState, kMaxSeats> seats{};
+};
+
+// One state update of a subscribed table
+struct Update {
+    uint32_t table = 0;
+    std::vector<uint8_t> data;
+};
+
+// Append the wire form to `out`
+void encode(const Request& request, std::vector<uint8_t>& out);
+void encode(const Response& response, std::vector<uint8_t>& out);
+void encode(uint32_t table, const uint8_t* update, size_t size, std::vector<uint8_t>& out);
+
+// Read one message from the front of `data`; returns the bytes used, or 0 if more are needed.
+// A subscriber's stream mixes updates with responses: data[0] == Op::Update marks an update.
+size_t decode(const uint8_t* data, size_t size, Request& request);
+size_t decode(const uint8_t* data, size_t size, Response& response);
+size_t decode(const uint8_t* data, size_t size, Update& update);
+
+const char* statusName(ReplyStatus status);
+
+// Blocking client for bots and tests. Throws std::runtime_error when the connection fails.
+class Client {
+private:
+    int fd = -1;
+    std::vector<uint8_t> in;
+    std::deque<Update> updates;  // Arrived while waiting for a response
+
+    void readMore();
+    bool takeUpdate();
+
+public:
+    Client() = default;
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    void connectUnix(const std::string& path);
+    void connectTcp(uint16_t port);  // Loopback
+
+    // Send without waiting, so several requests can be in flight
+    void send(const Request& request);
+
+    // Next response in request order; updates arriving first are kept for receiveUpdate()
+    Response receive();
+
+    // Next update of a subscribed table. Receive the responses still owed first.
+    Update receiveUpdate();
+
+    // Whether an update was received along with the responses so far
+    bool hasUpdate() const { return !updates.empty(); }
+
+    Response call(const Request& request) {
+        send(request);
+        return receive();
+    }
+
+    int socket() const { return fd; }
+    void close();
+};
+
+} // namespace protocol
+
+#endif // PROTOCOL_HPP
@@ -1,26 +1,35 @@
 #include "railroadTile.hpp"
 #include "player.hpp"
-#include <iostream>
+#include "game.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
 
 void RailroadTile::onLand(std::shared_ptr<Player> player, Game& game) {
+    PROFILE_SCOPE("onLand:Railroad");
     if (owner == nullptr) {
         // Player can buy the railroad
-        std::cout << player->getName() << ", do you want to buy " << getName() << "? (Price: $" << price << ")\n";
+        LOG_DEBUG(player->getName() << ", do you want to buy " << getName() << "? (Price: $" << price << ")");
         if (player->getMoney() >= price) {
             player->buyProperty(shared_from_this());  // Player buys the railroad
+            game.getTileCounts().recordPurchase(player->getPosition());
             setOwner(player);  // Set the current player as the owner
-            std::cout << player->getName() << " has bought " << getName() << "!\n";
+            LOG_INFO(player->getName() << " has bought " << getName() << "!");
         } else {
-            std::cout << player->getName() << " doesn't have enough money to buy " << getName() << ".\n";
+            LOG_INFO(player->getName() << " doesn't have enough money to buy " << getName() << ".");
+            game.auctionProperty(shared_from_this(), price, player->getPosition());
         }
     } else if (owner == player) {
         // Player landed on their own railroad
-        std::cout << player->getName() << " landed on their own railroad and does not pay rent.\n";
+        LOG_INFO(player->getName() << " landed on their own railroad and does not pay rent.");
+    } else if (mortgaged) {
+        LOG_INFO(getName() << " is mortgaged; no rent is due.");
     } else {
         // Player landed on another player's railroad, pay rent
         int rent = calculateRent();
-        std::cout << player->getName() << " landed on " << owner->getName() << "'s railroad and must pay $" << rent << " in rent.\n";
-        player->payRent(*owner, rent);  // Player pays rent to the owner
+        LOG_INFO(player->getName() << " landed on " << owner->getName() << "'s railroad and must pay $" << rent << " in rent.");
+        if (player->payRent(*owner, rent)) {  // Player pays rent to the owner
+            game.getTileCounts().recordRent(player->getPosition(), rent);
+        }
     }
 }
 
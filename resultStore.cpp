@@ -0,0 +1,384 @@
+#include "resultStore.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+uint64_t getLE(const uint8_t* at, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(at[i]) << (8 * i);
+    return value;
+}
+
+std::runtime_error storeError(const std::string& what) {
+    return std::runtime_error("result store: " + what);
+}
+
+} // namespace
+
+namespace resultStore {
+
+std::vector<Column> columns(int seatColumns) {
+    std::vector<Column> list = {{"seed", ColumnType::UInt32}, {"players", ColumnType::Int32},
+                                {"winner", ColumnType::Int32}, {"rolls", ColumnType::Int32},
+                                {"bankruptcies", ColumnType::Int32}};
+    for (const char* prefix : {"strategy_", "final_money_", "rent_earned_"}) {
+        for (int seat = 0; seat < seatColumns; ++seat) {
+            list.push_back({prefix + std::to_string(seat), ColumnType::Int32});
+        }
+    }
+    for (int t = 0; t < kBoardTiles; ++t) {
+        list.push_back({"tile_income_" + std::to_string(t), ColumnType::Int32});
+    }
+    return list;
+}
+
+std::string partPath(const std::string& path, long long firstGame) {
+    return firstGame == 0 ? path : path + ".part" + std::to_string(firstGame);
+}
+
+} // namespace resultStore
+
+ResultBuffer::ResultBuffer(ResultWriter& writer) : writer(writer), columns(writer.schema.size()) {
+    for (auto& column : columns) {
+        column.reserve(writer.groupRows);
+    }
+    std::lock_guard<std::mutex> guard(writer.lock);
+    writer.buffers.push_back(this);
+}
+
+ResultBuffer::~ResultBuffer() {
+    try {
+        flush();
+    } catch (...) {
+        // A failed write surfaces again in ResultWriter::close
+    }
+    std::lock_guard<std::mutex> guard(writer.lock);
+    writer.buffers.erase(std::find(writer.buffers.begin(), writer.buffers.end(), this));
+}
+
+void ResultBuffer::record(const GameSummary& summary) {
+    size_t c = 0;
+    columns[c++].push_back(static_cast<int32_t>(summary.seed));
+    columns[c++].push_back(summary.numPlayers);
+    columns[c++].push_back(summary.winner);
+    columns[c++].push_back(summary.rolls);
+    columns[c++].push_back(summary.bankruptcies);
+    int seats = writer.seatColumns;
+    for (int seat = 0; seat < seats; ++seat) columns[c++].push_back(0);
+    for (int seat = 0; seat < seats; ++seat) columns[c++].push_back(summary.finalMoney[seat]);
+    for (int seat = 0; seat < seats; ++seat) columns[c++].push_back(summary.rentEarned[seat]);
+    for (int t = 0; t < kBoardTiles; ++t) columns[c++].push_back(summary.rentCollected[t]);
+
+    if (++rows == writer.groupRows) {
+        flush();
+    }
+}
+
+void ResultBuffer::flush() {
+    if (rows == 0) return;
+    writer.writeGroup(columns, rows);
+    for (auto& column : columns) {
+        column.clear();
+    }
+    rows = 0;
+}
+
+ResultWriter::ResultWriter(const std::string& path, size_t groupRows, int seats)
+    : path(path), temporary(path + ".tmp"), groupRows(std::max<size_t>(groupRows, 1)),
+      seatColumns(std::min(std::max(seats, resultStore::kMinSeatColumns), kMaxSimPlayers)),
+      schema(resultStore::columns(seatColumns)) {
+    open();
+}
+
+void ResultWriter::open() {
+    file = std::fopen(temporary.c_str(), "wb");
+    if (!file) throw storeError("cannot write " + temporary + ": " + std::strerror(errno));
+    groups.clear();
+    rowCount = 0;
+    written = 0;
+    std::vector<uint8_t> header(resultStore::kHeaderBytes, 0);  // Filled in by finish()
+    writeBytes(header.data(), header.size());
+}
+
+ResultWriter::~ResultWriter() {
+    if (file) {
+        std::fclose(file);
+        std::remove(temporary.c_str());  // Never closed: leave no half-written file behind
+    }
+}
+
+void ResultWriter::writeBytes(const void* data, size_t bytes) {
+    if (std::fwrite(data, 1, bytes, file) != bytes) {
+        throw storeError("cannot write " + temporary + ": " + std::strerror(errno));
+    }
+    written += bytes;
+}
+
+void ResultWriter::writeGroup(const std::vector<std::vector<int32_t>>& columns, size_t rows) {
+    // Zone maps are worked out before taking the lock
+    Group group;
+    group.rows = rows;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        int64_t low = std::numeric_limits<int64_t>::max();
+        int64_t high = std::numeric_limits<int64_t>::min();
+        for (size_t r = 0; r < rows; ++r) {
+            int64_t value = schema[c].type == resultStore::ColumnType::UInt32
+                                ? static_cast<int64_t>(static_cast<uint32_t>(columns[c][r]))
+                                : columns[c][r];
+            low = std::min(low, value);
+            high = std::max(high, value);
+        }
+        group.min.push_back(low);
+        group.max.push_back(high);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (closed) throw storeError("writer is closed");
+    if (!file) open();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        group.offsets.push_back(written);
+        writeBytes(columns[c].data(), rows * sizeof(int32_t));
+    }
+    rowCount += rows;
+    totalRows += rows;
+    groups.push_back(std::move(group));
+}
+
+void ResultWriter::close() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (closed) return;
+    closed = true;
+    if (file) finish();
+}
+
+void ResultWriter::seal(const std::string& nextPath) {
+    std::vector<ResultBuffer*> pending;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (closed) throw storeError("writer is closed");
+        pending = buffers;
+    }
+    for (ResultBuffer* buffer : pending) {
+        buffer->flush();
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    if (file) finish();
+    path = nextPath;
+    temporary = nextPath + ".tmp";
+}
+
+// Footer and header of the current file, then rename it into place
+void ResultWriter::finish() {
+    uint64_t footerOffset = written;
+    std::vector<uint8_t> footer;
+    for (const Group& group : groups) {
+        putLE(footer, group.rows, 8);
+        for (size_t c = 0; c < schema.size(); ++c) {
+            putLE(footer, group.offsets[c], 8);
+            putLE(footer, static_cast<uint64_t>(group.min[c]), 8);
+            putLE(footer, static_cast<uint64_t>(group.max[c]), 8);
+        }
+    }
+    for (const auto& column : schema) {
+        putLE(footer, static_cast<uint8_t>(column.type), 1);
+        putLE(footer, column.name.size(), 1);
+        footer.insert(footer.end(), column.name.begin(), column.name.end());
+    }
+    writeBytes(footer.data(), footer.size());
+
+    std::vector<uint8_t> header;
+    putLE(header, resultStore::kMagic, 4);
+    putLE(header, resultStore::kVersion, 2);
+    putLE(header, schema.size(), 2);
+    putLE(header, rowCount, 8);
+    putLE(header, groups.size(), 8);
+    putLE(header, footerOffset, 8);
+    header.resize(resultStore::kHeaderBytes, 0);
+    bool ok = std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(header.data(), 1, header.size(), file) == header.size();
+    ok = std::fflush(file) == 0 && ok;
+    ok = ::fsync(::fileno(file)) == 0 && ok;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw storeError("cannot write " + path + ": " + std::strerror(errno));
+    }
+}
+
+ResultReader::ResultReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw storeError("cannot open " + path + ": " + std::strerror(errno));
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < resultStore::kHeaderBytes) {
+        ::close(fd);
+        throw storeError(path + " is not a result file");
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) throw storeError("cannot map " + path + ": " + std::strerror(errno));
+    mapping = static_cast<const uint8_t*>(mapped);
+
+    try {
+        if (getLE(mapping, 4) != resultStore::kMagic) throw storeError(path + " is not a result file");
+        uint64_t version = getLE(mapping + 4, 2);
+        if (version != resultStore::kVersion) throw storeError("unsupported version " + std::to_string(version));
+        size_t columnTotal = getLE(mapping + 6, 2);
+        rowCount = getLE(mapping + 8, 8);
+        uint64_t groupCount = getLE(mapping + 16, 8);
+        uint64_t footerOffset = getLE(mapping + 24, 8);
+
+        size_t groupBytes = 8 + columnTotal * 24;
+        if (footerOffset > size || groupCount > (size - footerOffset) / groupBytes) throw storeError("truncated footer");
+        const uint8_t* at = mapping + footerOffset;
+        uint64_t firstRow = 0;
+        for (uint64_t g = 0; g < groupCount; ++g) {
+            Group group;
+            group.firstRow = firstRow;
+            group.rows = getLE(at, 8);
+            at += 8;
+            for (size_t c = 0; c < columnTotal; ++c, at += 24) {
+                uint64_t offset = getLE(at, 8);
+                if (offset < resultStore::kHeaderBytes || offset > footerOffset ||
+                    group.rows > (footerOffset - offset) / sizeof(int32_t)) {
+                    throw storeError("column data out of range");
+                }
+                group.data.push_back(mapping + offset);
+                group.min.push_back(static_cast<int64_t>(getLE(at + 8, 8)));
+                group.max.push_back(static_cast<int64_t>(getLE(at + 16, 8)));
+            }
+            firstRow += group.rows;
+            groups.push_back(std::move(group));
+        }
+        if (firstRow != rowCount) throw storeError("row count does not match the groups");
+
+        const uint8_t* end = mapping + size;
+        for (size_t c = 0; c < columnTotal; ++c) {
+            if (end - at < 2 || end - at - 2 < at[1]) throw storeError("truncated schema");
+            columns.push_back({std::string(reinterpret_cast<const char*>(at + 2), at[1]),
+                               static_cast<resultStore::ColumnType>(at[0])});
+            at += 2 + at[1];
+        }
+    } catch (...) {
+        ::munmap(const_cast<uint8_t*>(mapping), size);
+        throw;
+    }
+}
+
+ResultReader::~ResultReader() {
+    ::munmap(const_cast<uint8_t*>(mapping), size);
+}
+
+int ResultReader::column(const std::string& name) const {
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (columns[c].name == name) return static_cast<int>(c);
+    }
+    return -1;
+}
+
+int64_t ResultReader::load(const Group& group, int column, uint64_t row) const {
+    int32_t value;
+    std::memcpy(&value, group.data[column] + row * sizeof(int32_t), sizeof(value));
+    return columns[column].type == resultStore::ColumnType::UInt32 ? static_cast<int64_t>(static_cast<uint32_t>(value))
+                                                                     : value;
+}
+
+std::vector<uint64_t> ResultReader::select(const std::vector<Predicate>& predicates) const {
+    for (const Predicate& predicate : predicates) {
+        if (predicate.column < 0 || predicate.column >= columnCount()) throw std::out_of_range("result store: no such column");
+    }
+
+    std::vector<uint64_t> selected;
+    std::vector<uint32_t> candidates;
+    groupsSkipped = 0;
+    // An empty range matches nothing (and would wrap the scan's unsigned span below)
+    for (const Predicate& predicate : predicates) {
+        if (predicate.low > predicate.high) {
+            groupsSkipped = groups.size();
+            return selected;
+        }
+    }
+    for (const Group& group : groups) {
+        // Zone maps: skip the group, or drop predicates that hold for all of it
+        bool skip = false;
+        std::vector<const Predicate*> pending;
+        for (const Predicate& predicate : predicates) {
+            int64_t low = group.min[predicate.column];
+            int64_t high = group.max[predicate.column];
+            if (high < predicate.low || low > predicate.high) skip = true;
+            else if (low < predicate.low || high > predicate.high) pending.push_back(&predicate);
+        }
+        if (skip) {
+            groupsSkipped++;
+            continue;
+        }
+
+        candidates.clear();
+        if (pending.empty()) {
+            for (uint32_t r = 0; r < group.rows; ++r) candidates.push_back(r);
+        } else {
+            // The first predicate scans its column; the rest only look at the rows still selected.
+            // The scan is branch-free over the raw values: an unsigned offset test covers both bounds.
+            const Predicate& first = *pending[0];
+            const int32_t* values = reinterpret_cast<const int32_t*>(group.data[first.column]);
+            bool isUnsigned = columns[first.column].type == resultStore::ColumnType::UInt32;
+            int64_t low = std::max<int64_t>(first.low, isUnsigned ? 0 : INT32_MIN);
+            uint64_t span = static_cast<uint64_t>(std::min<int64_t>(first.high, isUnsigned ? UINT32_MAX : INT32_MAX) - low);
+            candidates.resize(group.rows);
+            size_t kept = 0;
+            for (uint32_t r = 0; r < group.rows; ++r) {
+                int64_t value = isUnsigned ? static_cast<int64_t>(static_cast<uint32_t>(values[r])) : values[r];
+                candidates[kept] = r;
+                kept += static_cast<uint64_t>(value - low) <= span;
+            }
+            candidates.resize(kept);
+            for (size_t p = 1; p < pending.size() && !candidates.empty(); ++p) {
+                const Predicate& next = *pending[p];
+                size_t kept = 0;
+                for (uint32_t r : candidates) {
+                    int64_t value = load(group, next.column, r);
+                    if (value >= next.low && value <= next.high) candidates[kept++] = r;
+                }
+                candidates.resize(kept);
+            }
+        }
+        for (uint32_t r : candidates) {
+            selected.push_back(group.firstRow + r);
+        }
+    }
+    return selected;
+}
+
+std::vector<int64_t> ResultReader::gather(int column, const std::vector<uint64_t>& rows) const {
+    if (column < 0 || column >= columnCount()) throw std::out_of_range("result store: no such column");
+    std::vector<int64_t> values;
+    values.reserve(rows.size());
+    size_t g = 0;
+    for (uint64_t row : rows) {
+        while (g < groups.size() && row >= groups[g].firstRow + groups[g].rows) g++;
+        if (g == groups.size()) throw std::out_of_range("result store: row out of range");
+        values.push_back(load(groups[g], column, row - groups[g].firstRow));
+    }
+    return values;
+}
+
+int64_t ResultReader::sum(int column, const std::vector<uint64_t>& rows) const {
+    int64_t total = 0;
+    for (int64_t value : gather(column, rows)) {
+        total += value;
+    }
+    return total;
+}
@@ -0,0 +1,197 @@
+#ifndef RESULT_STORE_HPP
+#define RESULT_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "batchRunner.hpp"
+#include "simulation.hpp"
+
+// Per-game results in a columnar file. Rows are stored in row groups; within a group each column
+// is one contiguous array of 32-bit little-endian values, so a scan touches only the columns it
+// needs and reads them straight from a memory mapping. Each group records the min and max of
+// every column, so a reader skips groups a predicate rules out without touching their data.
+//
+// Layout:
+//   header, kHeaderBytes: u32 magic "MNPC" | u16 version | u16 columnCount | u64 rowCount
+//                         u64 groupCount | u64 footer offset | 32 bytes reserved
+//   row groups: columnCount arrays of rows x 32-bit values
+//   footer: groupCount x (u64 rows | columnCount x (u64 offset | i64 min | i64 max))
+//           columnCount x (u8 type | u8 name length | name)
+//
+// Columns: seed, players, winner, rolls, bankruptcies, strategy_N, final_money_N and rent_earned_N
+// for N from 0 to the writer's seat count less one (at least 0..3), and tile_income_0..39. The engines have one policy (buy whatever is affordable),
+// so every strategy id is 0 for now.
+namespace resultStore {
+
+enum class ColumnType : uint8_t { Int32, UInt32 };
+
+struct Column {
+    std::string name;
+    ColumnType type;
+};
+
+constexpr uint32_t kMagic = 0x43504E4D;  // "MNPC"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kHeaderBytes = 64;
+
+constexpr int kMinSeatColumns = 4;   // Seat columns in every file, however few players
+
+// The columns of a file with `seatColumns` columns per seat field, in file order
+std::vector<Column> columns(int seatColumns = kMinSeatColumns);
+
+// File for the rows of a campaign from game `firstGame` on: `path` itself from the start,
+// `path.partN` from game N (a resumed run, or the part after a checkpoint at game N)
+std::string partPath(const std::string& path, long long firstGame);
+
+} // namespace resultStore
+
+class ResultWriter;
+
+// One writer thread's rows. Collects whole row groups, then hands them to the writer under its lock.
+class ResultBuffer : public GameSink {
+private:
+    ResultWriter& writer;
+    std::vector<std::vector<int32_t>> columns;
+    size_t rows = 0;
+
+public:
+    explicit ResultBuffer(ResultWriter& writer);
+    ~ResultBuffer() override;
+
+    void record(const GameSummary& summary) override;
+
+    // Write the rows collected so far as a (possibly short) group
+    void flush();
+};
+
+// Writes a result file through a temporary file; close() adds the footer and renames it into place.
+// Each thread records into its own ResultBuffer; buffers must be flushed or destroyed before close().
+// seal() does the same mid-run and carries on into the next file.
+class ResultWriter {
+private:
+    struct Group {
+        uint64_t rows = 0;
+        std::vector<uint64_t> offsets;
+        std::vector<int64_t> min;
+        std::vector<int64_t> max;
+    };
+
+    std::string path;
+    std::string temporary;
+    std::FILE* file = nullptr;
+    std::mutex lock;
+    std::vector<Group> groups;
+    std::vector<ResultBuffer*> buffers;
+    uint64_t rowCount = 0;   // Rows in the current file
+    uint64_t totalRows = 0;
+    uint64_t written = 0;    // Bytes written to the current file
+    bool closed = false;
+    size_t groupRows;
+    int seatColumns;
+    std::vector<resultStore::Column> schema;
+
+    friend class ResultBuffer;
+    void writeGroup(const std::vector<std::vector<int32_t>>& columns, size_t rows);
+    void writeBytes(const void* data, size_t size);
+    void open();
+    void finish();
+
+public:
+    // Seat columns cover `seats` players, clamped to kMinSeatColumns..kMaxSimPlayers
+    explicit ResultWriter(const std::string& path, size_t groupRows = 65536, int seats = resultStore::kMinSeatColumns);
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // A buffer for one thread
+    std::unique_ptr<ResultBuffer> buffer() { return std::make_unique<ResultBuffer>(*this); }
+
+    void close();
+
+    // Flush every buffer, finish the current file as close() does and go on writing to `nextPath`.
+    // No thread may be recording meanwhile. The next file is created by its first row, so sealing
+    // right before close() leaves no empty file.
+    void seal(const std::string& nextPath);
+
+    // Rows written to every file so far
+    uint64_t getRowCount() const { return totalRows; }
+};
+
+// Seals a campaign's result part at each checkpoint and starts the next part at the checkpoint's
+// game (see resultStore::partPath). Every game a checkpoint counts as done is then in a finished
+// file, and a run killed after it loses only games the resumed run plays again.
+class ResultParts : public CheckpointObserver {
+private:
+    ResultWriter& writer;
+    std::string path;
+
+public:
+    ResultParts(ResultWriter& writer, const std::string& path) : writer(writer), path(path) {}
+
+    void beforeCheckpoint(long long completed) override { writer.seal(resultStore::partPath(path, completed)); }
+};
+
+// Memory-mapped reader with predicate pushdown
+class ResultReader {
+public:
+    // Rows whose value in `column` lies in [low, high]
+    struct Predicate {
+        int column;
+        int64_t low;
+        int64_t high;
+    };
+
+private:
+    struct Group {
+        uint64_t firstRow = 0;
+        uint64_t rows = 0;
+        std::vector<const uint8_t*> data;
+        std::vector<int64_t> min;
+        std::vector<int64_t> max;
+    };
+
+    const uint8_t* mapping = nullptr;
+    size_t size = 0;
+    uint64_t rowCount = 0;
+    std::vector<resultStore::Column> columns;
+    std::vector<Group> groups;
+    mutable uint64_t groupsSkipped = 0;
+
+    int64_t load(const Group& group, int column, uint64_t row) const;
+
+public:
+    // Throws std::runtime_error if the file is missing, truncated or of another version
+    explicit ResultReader(const std::string& path);
+    ~ResultReader();
+
+    ResultReader(const ResultReader&) = delete;
+    ResultReader& operator=(const ResultReader&) = delete;
+
+    uint64_t getRowCount() const { return rowCount; }
+    int columnCount() const { return static_cast<int>(columns.size()); }
+    const std::string& columnName(int column) const { return columns[column].name; }
+
+    // Index of a column by name, -1 if there is none
+    int column(const std::string& name) const;
+
+    // Rows matching every predicate, in file order. Groups whose min/max rule out a predicate are
+    // skipped unread, and a predicate every row of a group satisfies is not evaluated there.
+    std::vector<uint64_t> select(const std::vector<Predicate>& predicates) const;
+
+    // Values of one column at the given rows (ascending, e.g. from select)
+    std::vector<int64_t> gather(int column, const std::vector<uint64_t>& rows) const;
+
+    // Sum of one column over the given rows
+    int64_t sum(int column, const std::vector<uint64_t>& rows) const;
+
+    // Groups skipped by zone maps in the last select()
+    uint64_t getGroupsSkipped() const { return groupsSkipped; }
+};
+
+#endif // RESULT_STORE_HPP
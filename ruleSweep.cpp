@@ -0,0 +1,220 @@
+#include "ruleSweep.hpp"
+#include "board.hpp"
+#include "lockstepSim.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct ParameterInfo {
+    RuleParameter parameter;
+    const char* name;
+    int32_t HouseRules::*field;
+};
+
+const ParameterInfo kParameters[] = {
+    {RuleParameter::StartingMoney, "start", &HouseRules::startingMoney},
+    {RuleParameter::GoSalary, "go", &HouseRules::goSalary},
+    {RuleParameter::TaxPercent, "tax", &HouseRules::taxPercent},
+    {RuleParameter::JailFee, "jail", &HouseRules::jailFee},
+    {RuleParameter::RentPercent, "rent", &HouseRules::rentPercent},
+    {RuleParameter::Auctions, "auction", &HouseRules::auctions},
+    {RuleParameter::Mortgages, "mortgage", &HouseRules::mortgages},
+};
+
+constexpr long long kMaxGamesPerRun = 1 << 30;  // Games per LockstepSimulator::run call
+
+const ParameterInfo& info(RuleParameter parameter) {
+    return kParameters[static_cast<int>(parameter)];
+}
+
+// The baseline's per-game outcomes, indexed by seed - firstSeed
+struct Baseline {
+    std::vector<int32_t> rolls;
+    std::vector<int8_t> winners;
+};
+
+// One worker's share of a configuration. Fills the baseline when `filling`, compares against it otherwise.
+class PairedSink : public GameSink {
+public:
+    PairedSink(Baseline& baseline, uint32_t firstSeed, bool filling)
+        : baseline(baseline), firstSeed(firstSeed), filling(filling) {}
+
+    void record(const GameSummary& summary) override {
+        size_t game = summary.seed - firstSeed;
+        result.rolls.add(summary.rolls);
+        if (filling) {
+            baseline.rolls[game] = summary.rolls;
+            baseline.winners[game] = static_cast<int8_t>(summary.winner);
+            return;
+        }
+        result.rollDifference.add(summary.rolls - baseline.rolls[game]);
+        if (summary.winner != baseline.winners[game]) result.winnerChanged++;
+    }
+
+    SweepResult result;
+
+private:
+    Baseline& baseline;
+    uint32_t firstSeed;
+    bool filling;
+};
+
+SweepResult playConfiguration(const HouseRules& rules, const SweepConfig& config, Baseline& baseline, bool filling) {
+    int threads = std::max(1, config.threads);
+    std::vector<PairedSink> perWorker(threads, PairedSink(baseline, config.firstSeed, filling));
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        long long begin = config.games * w / threads;
+        long long end = config.games * (w + 1) / threads;
+        workers.emplace_back([&, w, begin, end] {
+            auto board = Board::create();
+            LockstepSimulator simulator(*board, config.numPlayers, config.maxRolls, rules);
+            // run() takes an int count, so a large share is played in chunks that continue the seeds
+            for (long long chunk = begin; chunk < end; chunk += kMaxGamesPerRun) {
+                int games = static_cast<int>(std::min<long long>(end - chunk, kMaxGamesPerRun));
+                perWorker[w].result.stats.merge(simulator.run(config.firstSeed + static_cast<uint32_t>(chunk), games, &perWorker[w]));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Merged in worker order, so results do not depend on thread timing
+    SweepResult merged;
+    merged.rules = rules;
+    merged.numPlayers = config.numPlayers;
+    for (const PairedSink& sink : perWorker) {
+        merged.stats.merge(sink.result.stats);
+        merged.rolls.merge(sink.result.rolls);
+        merged.rollDifference.merge(sink.result.rollDifference);
+        merged.winnerChanged += sink.result.winnerChanged;
+    }
+    return merged;
+}
+
+} // namespace
+
+double SweepResult::rollDifferenceError() const {
+    long long n = rollDifference.count();
+    return n > 1 ? rollDifference.stddev() / std::sqrt(static_cast<double>(n)) : 0.0;
+}
+
+double SweepResult::winShare(int seat) const {
+    return stats.finishedGames > 0 ? static_cast<double>(stats.wins[seat]) / stats.finishedGames : 0.0;
+}
+
+double SweepResult::seatSpread() const {
+    double low = 1.0;
+    double high = 0.0;
+    for (int seat = 0; seat < numPlayers && seat < kMaxSimPlayers; ++seat) {
+        low = std::min(low, winShare(seat));
+        high = std::max(high, winShare(seat));
+    }
+    return high > low ? high - low : 0.0;
+}
+
+namespace ruleSweep {
+
+const char* parameterName(RuleParameter parameter) {
+    return info(parameter).name;
+}
+
+int32_t get(const HouseRules& rules, RuleParameter parameter) {
+    return rules.*info(parameter).field;
+}
+
+void set(HouseRules& rules, RuleParameter parameter, int32_t value) {
+    rules.*info(parameter).field = value;
+}
+
+SweepAxis parseAxis(const std::string& text) {
+    size_t equals = text.find('=');
+    if (equals == std::string::npos) throw std::invalid_argument("sweep axis needs name=levels: " + text);
+    std::string name = text.substr(0, equals);
+    const ParameterInfo* found = nullptr;
+    for (const ParameterInfo& parameter : kParameters) {
+        if (name == parameter.name) found = &parameter;
+    }
+    if (!found) throw std::invalid_argument("unknown rule parameter: " + name);
+
+    SweepAxis axis{found->parameter, {}};
+    size_t at = equals + 1;
+    while (at <= text.size()) {
+        size_t colon = std::min(text.find(':', at), text.size());
+        std::string level = text.substr(at, colon - at);
+        char* end = nullptr;
+        long value = std::strtol(level.c_str(), &end, 10);
+        if (level.empty() || *end != '\0' || value < 0 || value > INT32_MAX) {
+            throw std::invalid_argument("bad level for " + name + ": " + level);
+        }
+        axis.levels.push_back(static_cast<int32_t>(value));
+        at = colon + 1;
+    }
+    return axis;
+}
+
+std::vector<HouseRules> gridDesign(const HouseRules& base, const std::vector<SweepAxis>& axes) {
+    std::vector<HouseRules> design = {base};
+    for (const SweepAxis& axis : axes) {
+        std::vector<HouseRules> next;
+        for (const HouseRules& rules : design) {
+            for (int32_t level : axis.levels) {
+                HouseRules variant = rules;
+                set(variant, axis.parameter, level);
+                next.push_back(variant);
+            }
+        }
+        design = std::move(next);
+    }
+    return design;
+}
+
+std::vector<HouseRules> randomDesign(const HouseRules& base, const std::vector<SweepAxis>& axes, int count, uint32_t seed) {
+    std::vector<HouseRules> design(std::max(count, 0), base);
+    std::mt19937 gen(seed);
+    for (const SweepAxis& axis : axes) {
+        if (axis.levels.empty()) continue;
+        // Each level fills an equal block of rows; shuffling pairs the blocks with the other axes at random
+        std::vector<int32_t> column;
+        for (size_t i = 0; i < design.size(); ++i) {
+            column.push_back(axis.levels[i * axis.levels.size() / design.size()]);
+        }
+        std::shuffle(column.begin(), column.end(), gen);
+        for (size_t i = 0; i < design.size(); ++i) {
+            set(design[i], axis.parameter, column[i]);
+        }
+    }
+    return design;
+}
+
+std::vector<SweepResult> run(const HouseRules& baseline, const std::vector<HouseRules>& design, const SweepConfig& config,
+                             SweepResult* baselineResult) {
+    // Baseline outcomes are indexed by seed offset, one entry per game
+    if (config.games < 0 || config.games > kMaxGames ||
+        static_cast<unsigned long long>(config.games) > Baseline().rolls.max_size()) {
+        throw std::invalid_argument("sweep: games must be 0-" + std::to_string(kMaxGames) + " per configuration");
+    }
+    Baseline outcomes;
+    outcomes.rolls.resize(static_cast<size_t>(config.games));
+    outcomes.winners.resize(outcomes.rolls.size());
+    SweepResult reference = playConfiguration(baseline, config, outcomes, true);
+    double spread = reference.rolls.stddev();
+
+    std::vector<SweepResult> results;
+    for (const HouseRules& rules : design) {
+        SweepResult result = playConfiguration(rules, config, outcomes, false);
+        result.effectSize = spread > 0.0 ? result.rollDifference.mean() / spread : 0.0;
+        results.push_back(std::move(result));
+    }
+    if (baselineResult) *baselineResult = reference;
+    return results;
+}
+
+} // namespace ruleSweep
@@ -0,0 +1,79 @@
+#ifndef RULE_SWEEP_HPP
+#define RULE_SWEEP_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "simulation.hpp"
+#include "streamStats.hpp"
+
+// House-rule parameter sweeps on the lockstep engine. Every configuration plays the same games
+// [firstSeed, firstSeed + games): a game's dice come from its seed alone, so configurations are
+// compared on common random numbers and each game is paired with its baseline twin. Paired
+// differences cancel most of the dice noise, which makes small rule effects visible with far fewer
+// games than independent runs would need.
+
+enum class RuleParameter : uint8_t { StartingMoney, GoSalary, TaxPercent, JailFee, RentPercent, Auctions, Mortgages };
+
+// One swept parameter and the levels it takes
+struct SweepAxis {
+    RuleParameter parameter;
+    std::vector<int32_t> levels;
+};
+
+struct SweepConfig {
+    uint32_t firstSeed = 1;
+    long long games = 10000;   // Games per configuration
+    int numPlayers = 2;
+    int maxRolls = 1000;
+    int threads = 1;
+};
+
+// One configuration's results, with effects measured against the baseline on the same games
+struct SweepResult {
+    HouseRules rules;
+    int numPlayers = 0;
+    SimStats stats;
+    RunningMoments rolls;
+    RunningMoments rollDifference;   // Per game: rolls here minus rolls under the baseline
+    long long winnerChanged = 0;     // Games whose winner (or lack of one) differs from the baseline
+
+    // Mean change in game length over the baseline's game-length standard deviation (Cohen's d)
+    double effectSize = 0.0;
+    // Standard error of the mean roll difference (paired)
+    double rollDifferenceError() const;
+    // Share of finished games won by `seat`
+    double winShare(int seat) const;
+    // Largest gap between two seats' win shares: 0 is a perfectly fair rule set
+    double seatSpread() const;
+};
+
+namespace ruleSweep {
+
+// Games per configuration a sweep can pair: one seed each, and one baseline entry each in memory
+constexpr long long kMaxGames = 1LL << 32;
+
+const char* parameterName(RuleParameter parameter);
+int32_t get(const HouseRules& rules, RuleParameter parameter);
+void set(HouseRules& rules, RuleParameter parameter, int32_t value);
+
+// Parse "name=a:b:c" (names as parameterName: start, go, tax, jail, rent, auction, mortgage). Throws std::invalid_argument.
+SweepAxis parseAxis(const std::string& text);
+
+// Every combination of the axes' levels (full factorial), other parameters as in `base`
+std::vector<HouseRules> gridDesign(const HouseRules& base, const std::vector<SweepAxis>& axes);
+
+// `count` configurations, each axis drawn as a Latin hypercube: every level is used equally often
+// (up to one) and levels are paired across axes at random. Reproducible from `seed`.
+std::vector<HouseRules> randomDesign(const HouseRules& base, const std::vector<SweepAxis>& axes, int count, uint32_t seed);
+
+// Play the baseline and every configuration of the design, each spread over config.threads workers.
+// Results come back in design order; the baseline's own result is not included. Throws
+// std::invalid_argument for a negative game count or one above kMaxGames.
+std::vector<SweepResult> run(const HouseRules& baseline, const std::vector<HouseRules>& design, const SweepConfig& config,
+                             SweepResult* baselineResult = nullptr);
+
+} // namespace ruleSweep
+
+#endif // RULE_SWEEP_HPP
@@ -0,0 +1,76 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "gameSave.hpp"
+#include "gameServer.hpp"
+#include "logger.hpp"
+
+namespace {
+GameServer* activeServer = nullptr;
+
+void onSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+}
+
+// Hosts game tables for bots over a local socket.
+// With --checkpoint, the open tables are restored from PATH at startup and written back on shutdown.
+// Usage: ./monopoly_server [--unix PATH] [--port N] [--max-tables N] [--checkpoint PATH]
+int main(int argc, char* argv[]) {
+    std::string unixPath;
+    std::string checkpointPath;
+    int port = -1;
+    size_t maxTables = size_t(1) << 20;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--unix") == 0) unixPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--port") == 0) port = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max-tables") == 0) maxTables = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--checkpoint") == 0) checkpointPath = argv[i + 1];
+    }
+    if (unixPath.empty() && port < 0) {
+        unixPath = "/tmp/monopoly.sock";
+    }
+
+    try {
+        GameServer server(maxTables);
+        if (!checkpointPath.empty()) {
+            std::ifstream file(checkpointPath, std::ios::binary);
+            if (file) {
+                std::vector<uint8_t> checkpoint((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                server.getTables().restoreTables(checkpoint.data(), checkpoint.size());
+                std::cout << "Restored " << server.getTables().tableCount() << " tables from " << checkpointPath << "\n";
+            }
+        }
+        if (!unixPath.empty()) {
+            server.listenUnix(unixPath);
+            std::cout << "Listening on " << unixPath << "\n";
+        }
+        if (port >= 0) {
+            std::cout << "Listening on 127.0.0.1:" << server.listenTcp(static_cast<uint16_t>(port)) << "\n";
+        }
+
+        activeServer = &server;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::signal(SIGPIPE, SIG_IGN);
+        server.run();
+        activeServer = nullptr;
+
+        std::cout << "Stopped with " << server.getTables().tableCount() << " open tables\n";
+        if (!checkpointPath.empty()) {
+            std::vector<uint8_t> checkpoint;
+            server.getTables().saveTables(checkpoint);
+            gameSave::writeFile(checkpoint, checkpointPath);
+            std::cout << "Saved them to " << checkpointPath << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "monopoly_server: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "simulation.hpp"
+#include "endgame.hpp"
+#include "game.hpp"
+#include "gameState.hpp"
+#include "tileStats.hpp"
+#include <string>
+
+namespace {
+
+GameSummary playScalarGame(uint32_t seed, int numPlayers, int maxRolls, TileHeatmap* heatmap,
+                           const EndgameCutoff* endgame) {
+    std::vector<std::shared_ptr<Player>> seats;
+    for (int i = 0; i < numPlayers; ++i) {
+        seats.push_back(std::make_shared<Player>("Player " + std::to_string(i + 1), 1500));
+        seats.back()->setRaisesCash(false);  // As the lockstep engine without HouseRules::mortgages
+    }
+
+    Game game(seats, Board::create());
+    game.seed(seed);
+
+    std::unique_ptr<EndgameSolver> solver;
+    if (endgame && endgame->afterRolls > 0) {
+        EndgameOptions options = endgame->options;
+        options.raisesCash = false;  // Like the seats above: out as soon as the cash runs short
+        solver = std::make_unique<EndgameSolver>(game.getBoard(), options);
+    }
+    int nextCheck = solver ? endgame->afterRolls : maxRolls;
+    int favourite = -1;
+
+    // Roll cap is checked between turns, the same way the lockstep engine does
+    while (game.getPlayers().size() > 1 && game.getRollCount() < maxRolls) {
+        if (game.getRollCount() >= nextCheck && game.getPlayers().size() == 2) {
+            // Rollouts rather than the model: they track exact cash and cost a fraction of it
+            EndgameEstimate estimate = solver->rollOut(GameState::capture(game));
+            int leader = estimate.win[0] >= estimate.win[1] ? 0 : 1;
+            if (estimate.valid && estimate.win[leader] * estimate.decided >= endgame->confidence) {
+                favourite = estimate.seats[leader];
+                break;
+            }
+            nextCheck = game.getRollCount() + endgame->afterRolls;
+        }
+        game.playTurn();
+    }
+
+    GameSummary summary;
+    summary.seed = seed;
+    summary.numPlayers = numPlayers;
+    summary.rolls = game.getRollCount();
+    summary.bankruptcies = numPlayers - static_cast<int>(game.getPlayers().size());
+    for (int i = 0; i < numPlayers && i < kMaxSimPlayers; ++i) {
+        summary.finalMoney[i] = seats[i]->getMoney();
+        summary.rentEarned[i] = seats[i]->getRentEarned();
+        if ((game.getPlayers().size() == 1 && game.getPlayers()[0] == seats[i]) || favourite == i) {
+            summary.winner = i;
+        }
+    }
+    const TileCounts& tiles = game.getTileCounts();
+    for (int t = 0; t < kBoardTiles; ++t) {
+        summary.landings[t] = static_cast<int>(tiles.landings[t]);
+        summary.rentCollected[t] = static_cast<int>(tiles.rentCollected[t]);
+    }
+    if (heatmap) {
+        heatmap->add(tiles);
+    }
+    return summary;
+}
+
+} // namespace
+
+void SimStats::add(const GameSummary& summary) {
+    games++;
+    totalRolls += summary.rolls;
+    if (summary.winner >= 0) {
+        finishedGames++;
+        wins[summary.winner]++;
+    }
+    for (int t = 0; t < kBoardTiles; ++t) {
+        landings[t] += summary.landings[t];
+    }
+}
+
+void SimStats::merge(const SimStats& other) {
+    games += other.games;
+    finishedGames += other.finishedGames;
+    totalRolls += other.totalRolls;
+    for (int i = 0; i < kMaxSimPlayers; ++i) {
+        wins[i] += other.wins[i];
+    }
+    for (int t = 0; t < kBoardTiles; ++t) {
+        landings[t] += other.landings[t];
+    }
+}
+
+double SimStats::meanRolls() const {
+    return games > 0 ? static_cast<double>(totalRolls) / games : 0.0;
+}
+
+double SimStats::landingFrequency(int tile) const {
+    long long total = 0;
+    for (long long count : landings) {
+        total += count;
+    }
+    return total > 0 ? static_cast<double>(landings[tile]) / total : 0.0;
+}
+
+GameSummary runScalarGame(uint32_t seed, int numPlayers, int maxRolls) {
+    QuietOutput quiet;
+    return playScalarGame(seed, numPlayers, maxRolls, nullptr, nullptr);
+}
+
+SimStats runScalarGames(uint32_t firstSeed, int numGames, int numPlayers, int maxRolls, TileHeatmap* heatmap,
+                        GameSink* sink, const EndgameCutoff* endgame) {
+    QuietOutput quiet;
+    SimStats stats;
+    for (int i = 0; i < numGames; ++i) {
+        GameSummary summary = playScalarGame(firstSeed + i, numPlayers, maxRolls, heatmap, endgame);
+        stats.add(summary);
+        if (sink) sink->record(summary);
+    }
+    return stats;
+}
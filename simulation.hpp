@@ -0,0 +1,80 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <array>
+#include <cstdint>
+#include "logger.hpp"
+
+constexpr int kBoardTiles = 40;     // Tiles on the standard board
+constexpr int kMaxSimPlayers = 16;  // Seats supported by the simulation summaries and the lockstep engine
+
+// Outcome of a single simulated game
+struct GameSummary {
+    uint32_t seed = 0;
+    int numPlayers = 0;
+    int rolls = 0;                                  // Dice rolls taken (doubles count as extra rolls)
+    int winner = -1;                                // Seat of the winner, -1 if the roll cap was hit
+    int bankruptcies = 0;                           // Seats that went bankrupt
+    std::array<int, kMaxSimPlayers> finalMoney{};   // Money per seat when the game ended
+    std::array<int, kBoardTiles> landings{};        // Landings per tile during the game
+    std::array<int, kMaxSimPlayers> rentEarned{};   // Rent collected per seat during the game
+    std::array<int, kBoardTiles> rentCollected{};   // Rent paid on each tile during the game
+};
+
+// Rule parameters the lockstep engine takes at run time, so one build can play any house-rule variant.
+// The defaults are the rules Game::playTurn plays by.
+struct HouseRules {
+    int32_t startingMoney = 1500;   // Player constructor default
+    int32_t goSalary = 200;         // Paid on passing or landing on Go (collectFromStart)
+    int32_t taxPercent = 100;       // Scales every TaxTile::taxAmount
+    int32_t jailFee = 50;           // Paid to leave jail (kJailFee)
+    int32_t rentPercent = 100;      // Scales street, railroad, utility and card rents
+    int32_t auctions = 0;           // 1: declined properties go to a sealed-bid auction (AuctionMode::Sealed)
+    int32_t mortgages = 0;          // 1: seats mortgage to pay rent and pay off with spare cash (Player::setRaisesCash)
+
+    bool operator==(const HouseRules& other) const {
+        return startingMoney == other.startingMoney && goSalary == other.goSalary && taxPercent == other.taxPercent &&
+               jailFee == other.jailFee && rentPercent == other.rentPercent && auctions == other.auctions &&
+               mortgages == other.mortgages;
+    }
+};
+
+// Receives the summary of every game an engine finishes (distribution accumulators, result files)
+class GameSink {
+public:
+    virtual ~GameSink() = default;
+    virtual void record(const GameSummary& summary) = 0;
+};
+
+// Aggregate statistics over many games, shared by the scalar and lockstep engines
+struct SimStats {
+    long long games = 0;
+    long long finishedGames = 0;
+    long long totalRolls = 0;
+    std::array<long long, kMaxSimPlayers> wins{};
+    std::array<long long, kBoardTiles> landings{};
+
+    // Fold one game into the totals
+    void add(const GameSummary& summary);
+
+    // Fold another aggregate into this one
+    void merge(const SimStats& other);
+
+    double meanRolls() const;
+    double landingFrequency(int tile) const;
+};
+
+// Play one full game with the scalar engine (Game::playTurn) on a fresh board.
+// Players buy whatever they can afford; narration is silenced while the game runs.
+GameSummary runScalarGame(uint32_t seed, int numPlayers, int maxRolls);
+
+class TileHeatmap;
+struct EndgameCutoff;
+
+// Play games [firstSeed, firstSeed + numGames) back to back with the scalar engine.
+// Each game's per-tile counters are added to `heatmap` and its summary passed to `sink` when given.
+// With an `endgame` cutoff, two-player games whose outcome is clear end early (see endgame.hpp).
+SimStats runScalarGames(uint32_t firstSeed, int numGames, int numPlayers, int maxRolls, TileHeatmap* heatmap = nullptr,
+                        GameSink* sink = nullptr, const EndgameCutoff* endgame = nullptr);
+
+#endif // SIMULATION_HPP
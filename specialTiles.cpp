@@ -0,0 +1,49 @@
+#include "specialTiles.hpp"
+#include "game.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
+
+void UtilityTile::onLand(std::shared_ptr<Player> player, Game& game) {
+    PROFILE_SCOPE("onLand:Utility");
+    if (isOccupied()) {
+        // Check if player is not the owner; a mortgaged utility charges nothing
+        if (player != owner && !mortgaged) {
+            // Player pays rent based on dice roll
+            int diceRoll = player->getLastDiceRoll();
+            int utilitiesOwned = owner->getNumberOfUtilities();
+            int rent = calculateRent(diceRoll, utilitiesOwned);
+            LOG_INFO("Player " << player->getName() << " landed on " << name << " and pays $" << rent << " to " << owner->getName());
+            if (player->payRent(*owner, rent)) {
+                game.getTileCounts().recordRent(player->getPosition(), rent);
+            }
+        }
+    } else {
+        // Offer player the option to buy the utility
+        LOG_DEBUG(player->getName() << ", do you want to buy " << getName() << "? (Price: $" << getPrice() << ")");
+        if (player->getMoney() >= getPrice()) {
+            player->buyProperty(shared_from_this());
+            game.getTileCounts().recordPurchase(player->getPosition());
+            setOwner(player);  // Set the owner after purchase
+            LOG_INFO(player->getName() << " has bought " << getName() << "!");
+        } else {
+            LOG_INFO(player->getName() << " doesn't have enough money to buy " << getName() << ".");
+            game.auctionProperty(shared_from_this(), getPrice(), player->getPosition());
+        }
+    }
+}
+
+void ChanceTile::onLand(std::shared_ptr<Player> player, Game& game) {
+    PROFILE_SCOPE("onLand:Chance");
+    game.getTileCounts().recordCardDraw(player->getPosition());
+    if (auto card = game.getChanceDeck().draw(game.getRandom())) {
+        player->handleChanceCard(*card, game);
+    }
+}
+
+void CommunityChestTile::onLand(std::shared_ptr<Player> player, Game& game) {
+    PROFILE_SCOPE("onLand:CommunityChest");
+    game.getTileCounts().recordCardDraw(player->getPosition());
+    if (auto card = game.getCommunityChestDeck().draw(game.getRandom())) {
+        player->handleCommunityChestCard(*card, game);
+    }
+}
@@ -4,8 +4,8 @@
 #include "tile.hpp"
 #include "player.hpp"
 #include "cards.hpp"
+#include "profiler.hpp"
 #include <vector>
-#include <cstdlib>
 
 // Base class for special tiles
 class SpecialTile : public Tile {
@@ -38,76 +38,27 @@ public:
     }
 
     // Overriding the onLand method
-    void onLand(std::shared_ptr<Player> player, Game& game) override {
-    if (isOccupied()) {
-        // Check if player is not the owner
-        if (player != owner) {
-            // Player pays rent based on dice roll
-            int diceRoll = player->getLastDiceRoll();
-            int utilitiesOwned = owner->getNumberOfUtilities();
-            int rent = calculateRent(diceRoll, utilitiesOwned);
-            std::cout << "Player " << player->getName() << " landed on " << name 
-                      << " and pays $" << rent << " to " << owner->getName() << std::endl;
-            player->payRent(*owner, rent);
-        }
-    } else {
-        // Offer player the option to buy the utility
-        std::cout << player->getName() << ", do you want to buy " << getName() << "? (Price: $" << getPrice() << ")\n";
-        if (player->getMoney() >= getPrice()) {
-            player->buyProperty(shared_from_this());
-            setOwner(player);  // Set the owner after purchase
-            std::cout << player->getName() << " has bought " << getName() << "!\n";
-        } else {
-            std::cout << player->getName() << " doesn't have enough money to buy " << getName() << ".\n";
-        }
-    }
-}
+    void onLand(std::shared_ptr<Player> player, Game& game) override;
 
 };
 
 
+// Draws from the game's shared Chance deck
 class ChanceTile : public SpecialTile {
-private:
-    std::vector<std::shared_ptr<Card>> chanceCards;  // Store actual cards instead of strings
-
 public:
     ChanceTile(const std::string& name)
-        : SpecialTile(name) {
-        // Initialize Chance cards
-        chanceCards.push_back(std::make_shared<AdvanceToGoCard>());
-        chanceCards.push_back(std::make_shared<GoToJailCard>());
-        chanceCards.push_back(std::make_shared<TripToReadingRailroadCard>());
-        chanceCards.push_back(std::make_shared<GeneralRepairsCard>());
-        chanceCards.push_back(std::make_shared<GetOutOfJailFreeCard>());
-        chanceCards.push_back(std::make_shared<AdvanceToNearestUtilityCard>());
-        chanceCards.push_back(std::make_shared<AdvanceToNearestRailroadCard>());
-    }
+        : SpecialTile(name) {}
 
-    void onLand(std::shared_ptr<Player> player, Game& game) override {
-        int randomIndex = std::rand() % chanceCards.size();
-        player->handleChanceCard(chanceCards[randomIndex], game);
-    }
+    void onLand(std::shared_ptr<Player> player, Game& game) override;
 };
 
+// Draws from the game's shared Community Chest deck
 class CommunityChestTile : public SpecialTile {
-private:
-    std::vector<std::shared_ptr<Card>> communityChestCards;
-
 public:
     CommunityChestTile(const std::string& name)
-        : SpecialTile(name) {
-        // Initialize Community Chest cards
-        communityChestCards.push_back(std::make_shared<AdvanceToGoCard>());
-        communityChestCards.push_back(std::make_shared<GeneralRepairsCard>());
-        communityChestCards.push_back(std::make_shared<GetOutOfJailFreeCard>());
-        communityChestCards.push_back(std::make_shared<GeneralRepairsCard>());
-        communityChestCards.push_back(std::make_shared<GeneralRepairsCard>());
-    }
+        : SpecialTile(name) {}
 
-    void onLand(std::shared_ptr<Player> player, Game& game) override {
-        int randomIndex = std::rand() % communityChestCards.size();
-        player->handleCommunityChestCard(communityChestCards[randomIndex], game);
-    }
+    void onLand(std::shared_ptr<Player> player, Game& game) override;
 };
 
 
@@ -120,7 +71,10 @@ public:
     TaxTile(const std::string& name)
         : SpecialTile(name) {}
 
+    int getTaxAmount() const { return taxAmount; }
+
     void onLand(std::shared_ptr<Player> player, Game& game) override {
+        PROFILE_SCOPE("onLand:Tax");
         player->payTax(taxAmount);  // Assuming this method exists in Player
     }
 };
@@ -132,6 +86,7 @@ public:
         : SpecialTile(name) {}
 
     void onLand(std::shared_ptr<Player> player, Game& game) override {
+        PROFILE_SCOPE("onLand:FreeParking");
         // Nothing happens, player just rests here
     }
 };
@@ -143,6 +98,7 @@ public:
         : SpecialTile(name) {}
 
     void onLand(std::shared_ptr<Player> player, Game& game) override {
+        PROFILE_SCOPE("onLand:GoToJail");
         player->goToJail();  // Assuming this method exists in Player
     }
 };
@@ -154,6 +110,7 @@ public:
         : SpecialTile(name) {}
 
     void onLand(std::shared_ptr<Player> player, Game& game) override {
+        PROFILE_SCOPE("onLand:Go");
         player->collectFromStart(200);  // Assuming this method exists in Player
     }
 };
@@ -164,12 +121,9 @@ public:
     JailTile(const std::string& name)
         : SpecialTile(name) {}
 
+    // Jailed players never land here (their turn is played by Game::playTurn), so this is just visiting
     void onLand(std::shared_ptr<Player> player, Game& game) override {
-        if (player->isInJail()) {
-            player->handleJailTurn();  // Assuming this method exists in Player
-        } else {
-            // Just visiting, no action required
-        }
+        PROFILE_SCOPE("onLand:Jail");
     }
 };
 
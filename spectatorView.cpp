@@ -0,0 +1,73 @@
+#include "spectatorView.hpp"
+#include "game.hpp"
+
+SpectatorView::SpectatorView() : layout(Board::create()) {
+    hasBackground = background.loadFromFile("monopoly.jpg");  // Loaded once, not per frame
+}
+
+bool SpectatorView::apply(const uint8_t* data, size_t size) {
+    if (!mirror.apply(data, size)) return false;
+    dirty = true;
+    return true;
+}
+
+void SpectatorView::draw(sf::RenderWindow& window) {
+    const GameState& state = mirror.state();
+
+    if (hasBackground) {
+        sf::Sprite image;
+        image.setTexture(background);
+        image.setScale(800.0f / background.getSize().x, 800.0f / background.getSize().y);
+        window.draw(image);
+    }
+
+    // Owner marker and buildings on each tile
+    for (int t = 0; t < kBoardTiles && t < layout->getTileCount(); ++t) {
+        const TileState& tile = state.tiles[t];
+        if (tile.owner < 0) continue;
+        sf::Vector2f position = layout->getTilePosition(t);
+
+        sf::CircleShape star(8, 5);
+        star.setFillColor(Game::seatColor(tile.owner));
+        star.setPosition(position.x - 8, position.y - 30);
+        if (tile.mortgaged) {
+            star.setOutlineThickness(2);
+            star.setOutlineColor(sf::Color(90, 90, 90));  // Grey ring: mortgaged, no rent
+        }
+        window.draw(star);
+
+        int buildings = tile.hotel ? 1 : tile.houses;
+        for (int b = 0; b < buildings; ++b) {
+            sf::RectangleShape building(sf::Vector2f(6, 6));
+            building.setFillColor(tile.hotel ? sf::Color::Red : sf::Color::Green);
+            building.setPosition(position.x - 14 + 8 * b, position.y + 16);
+            window.draw(building);
+        }
+    }
+
+    // Player tokens, packed into a grid on tiles they share
+    int onTile[kBoardTiles] = {};
+    for (int seat = 0; seat < state.seatCount; ++seat) {
+        const SeatState& player = state.seats[seat];
+        if (!(player.flags & SeatState::Bankrupt)) onTile[player.position % kBoardTiles]++;
+    }
+    int drawn[kBoardTiles] = {};
+    for (int seat = 0; seat < state.seatCount; ++seat) {
+        const SeatState& player = state.seats[seat];
+        if (player.flags & SeatState::Bankrupt) continue;
+        int tile = player.position % kBoardTiles;
+        sf::Vector2f position = layout->getTilePosition(tile);
+        Game::TokenSlot slot = Game::tokenSlot(drawn[tile]++, onTile[tile]);
+
+        sf::CircleShape token(slot.radius);
+        token.setFillColor(Game::seatColor(seat));
+        if (seat == state.currentSeat) {
+            token.setOutlineColor(sf::Color::Black);
+            token.setOutlineThickness(2);
+        }
+        // A lone token is centred 5px right of and below the tile position, as in Game::drawPlayers
+        token.setPosition(position.x + 5 + slot.offset.x - slot.radius, position.y + 5 + slot.offset.y - slot.radius);
+        window.draw(token);
+    }
+    dirty = false;
+}
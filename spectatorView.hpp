@@ -0,0 +1,36 @@
+#ifndef SPECTATOR_VIEW_HPP
+#define SPECTATOR_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <SFML/Graphics.hpp>
+#include "board.hpp"
+#include "stateSync.hpp"
+
+// Draws a table for a spectator from state updates (stateSync.hpp) instead of a live Game.
+// The window only needs redrawing after an update has been applied. Seats get Game's token colours
+// (Game::seatColor) and share a tile the way Game packs them (Game::tokenSlot).
+class SpectatorView {
+private:
+    StateMirror mirror;
+    std::unique_ptr<Board> layout;  // Tile positions only; ownership comes from the mirror
+    sf::Texture background;
+    bool hasBackground = false;
+    bool dirty = true;
+
+public:
+    SpectatorView();
+
+    // Apply one update from the table; false if it was rejected (ask the table for a keyframe)
+    bool apply(const uint8_t* data, size_t size);
+
+    bool needsRedraw() const { return dirty; }
+
+    // Board, owners, buildings and player tokens as of the last update
+    void draw(sf::RenderWindow& window);
+
+    const StateMirror& getMirror() const { return mirror; }
+};
+
+#endif // SPECTATOR_VIEW_HPP
@@ -0,0 +1,159 @@
+#include "stateSync.hpp"
+
+namespace {
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Bounds-checked reads over one update
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool ok = true;
+
+    uint8_t byte() {
+        if (offset >= size) {
+            ok = false;
+            return 0;
+        }
+        return data[offset++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+};
+
+enum SeatField : uint8_t { Money = 1, Position = 2, Flags = 4 };
+
+} // namespace
+
+namespace stateSync {
+
+void encodeUpdate(const GameState& from, const GameState& to, uint32_t sequence, bool keyframe, std::vector<uint8_t>& out) {
+    const GameState empty;
+    const GameState& base = keyframe ? empty : from;
+
+    uint8_t flags = keyframe ? Keyframe : 0;
+    if (to.rolls != base.rolls) flags |= Rolls;
+    if (to.currentSeat != base.currentSeat) flags |= CurrentSeat;
+    out.push_back(flags);
+    putVarint(out, sequence);
+    if (keyframe) out.push_back(to.seatCount);
+    if (flags & Rolls) putVarint(out, to.rolls);
+    if (flags & CurrentSeat) out.push_back(static_cast<uint8_t>(to.currentSeat + 1));
+
+    // Seats: count first, patched once the records are written
+    size_t countAt = out.size();
+    out.push_back(0);
+    for (int i = 0; i < to.seatCount; ++i) {
+        const SeatState& before = base.seats[i];
+        const SeatState& after = to.seats[i];
+        uint8_t fields = (after.money != before.money ? Money : 0) |
+                         (after.position != before.position ? Position : 0) |
+                         (after.flags != before.flags ? Flags : 0);
+        if (fields == 0) continue;
+        out[countAt]++;
+        out.push_back(static_cast<uint8_t>(i << 3 | fields));
+        if (fields & Money) putVarint(out, zigzag(static_cast<int64_t>(after.money) - before.money));
+        if (fields & Position) out.push_back(after.position);
+        if (fields & Flags) out.push_back(after.flags);
+    }
+
+    countAt = out.size();
+    out.push_back(0);
+    for (int t = 0; t < kBoardTiles; ++t) {
+        const TileState& after = to.tiles[t];
+        if (after == base.tiles[t]) continue;
+        out[countAt]++;
+        out.push_back(static_cast<uint8_t>(t));
+        out.push_back(static_cast<uint8_t>(after.owner + 1));
+        out.push_back(static_cast<uint8_t>(after.houses | (after.mortgaged ? 0x40 : 0) | (after.hotel ? 0x80 : 0)));
+    }
+}
+
+} // namespace stateSync
+
+bool StateEncoder::encodeTurn(const Game& game, std::vector<uint8_t>& out) {
+    GameState now = GameState::capture(game);
+    if (started && now == last) {
+        return false;
+    }
+    stateSync::encodeUpdate(last, now, ++sequence, !started, out);
+    last = now;
+    started = true;
+    return true;
+}
+
+void StateEncoder::encodeKeyframe(std::vector<uint8_t>& out) const {
+    stateSync::encodeUpdate(last, last, sequence, true, out);
+}
+
+bool StateMirror::apply(const uint8_t* data, size_t size) {
+    Reader in{data, size};
+    uint8_t flags = in.byte();
+    uint32_t updateSequence = static_cast<uint32_t>(in.varint());
+    if (!in.ok) return false;
+
+    bool keyframe = flags & stateSync::Keyframe;
+    if (!keyframe && (!synced || updateSequence != sequence + 1)) return false;
+
+    GameState next = keyframe ? GameState() : current;
+    if (keyframe) {
+        next.seatCount = in.byte();
+        if (next.seatCount > GameState::kMaxSeats) return false;
+    }
+    if (flags & stateSync::Rolls) next.rolls = static_cast<uint32_t>(in.varint());
+    if (flags & stateSync::CurrentSeat) next.currentSeat = static_cast<int8_t>(in.byte() - 1);
+
+    int seatRecords = in.byte();
+    for (int r = 0; r < seatRecords && in.ok; ++r) {
+        uint8_t header = in.byte();
+        int seat = header >> 3;
+        if (seat >= next.seatCount) return false;
+        SeatState& entry = next.seats[seat];
+        if (header & Money) entry.money = static_cast<int32_t>(entry.money + unzigzag(in.varint()));
+        if (header & Position) entry.position = in.byte();
+        if (header & Flags) entry.flags = in.byte();
+    }
+
+    int tileRecords = in.byte();
+    for (int r = 0; r < tileRecords && in.ok; ++r) {
+        int tile = in.byte();
+        uint8_t owner = in.byte();
+        uint8_t buildings = in.byte();
+        if (tile >= kBoardTiles) return false;
+        TileState& entry = next.tiles[tile];
+        entry.owner = static_cast<int8_t>(owner - 1);
+        entry.houses = buildings & 0x3F;
+        entry.mortgaged = buildings & 0x40;
+        entry.hotel = buildings & 0x80;
+    }
+    if (!in.ok || in.offset != size) return false;
+
+    current = next;
+    sequence = updateSequence;
+    synced = true;
+    return true;
+}
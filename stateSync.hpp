@@ -0,0 +1,63 @@
+#ifndef STATE_SYNC_HPP
+#define STATE_SYNC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gameState.hpp"
+
+// Turn-by-turn state updates for spectators. After each turn the table sends only what changed
+// since the previous update; a spectator applies the updates in order to its own copy.
+//
+// Update format (varints are LEB128, money is a zigzag varint of the change):
+//   u8 flags (Keyframe, Rolls, CurrentSeat) | varint sequence
+//   [u8 seatCount]        keyframe only; a keyframe starts from an empty GameState
+//   [varint rolls]        if Rolls
+//   [u8 currentSeat + 1]  if CurrentSeat
+//   u8 count, count x seat record: u8 seat << 3 | fields (1 money, 2 position, 4 flags), then the fields
+//   u8 count, count x tile record: u8 tile | u8 owner + 1 | u8 houses | mortgaged << 6 | hotel << 7
+namespace stateSync {
+
+enum UpdateFlag : uint8_t { Keyframe = 1, Rolls = 2, CurrentSeat = 4 };
+
+// Append the changes from `from` to `to`. A keyframe encodes `to` in full.
+void encodeUpdate(const GameState& from, const GameState& to, uint32_t sequence, bool keyframe, std::vector<uint8_t>& out);
+
+} // namespace stateSync
+
+// Table side: remembers what spectators last saw
+class StateEncoder {
+private:
+    GameState last;
+    uint32_t sequence = 0;
+    bool started = false;
+
+public:
+    // Append the update for the game's current state; false (nothing appended) if nothing changed.
+    // The first update is a keyframe.
+    bool encodeTurn(const Game& game, std::vector<uint8_t>& out);
+
+    // The current state in full, for a spectator who joins late or missed an update
+    void encodeKeyframe(std::vector<uint8_t>& out) const;
+
+    uint32_t getSequence() const { return sequence; }
+};
+
+// Spectator side: a local copy of the table's state
+class StateMirror {
+private:
+    GameState current;
+    uint32_t sequence = 0;
+    bool synced = false;
+
+public:
+    // Apply one update. False if it is malformed, or does not follow the last one applied (the
+    // mirror then waits for a keyframe); the state is left unchanged in both cases.
+    bool apply(const uint8_t* data, size_t size);
+
+    const GameState& state() const { return current; }
+    uint32_t getSequence() const { return sequence; }
+    bool isSynced() const { return synced; }
+};
+
+#endif // STATE_SYNC_HPP
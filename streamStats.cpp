@@ -0,0 +1,230 @@
+#include "streamStats.hpp"
+#include "board.hpp"
+#include "lockstepSim.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+void RunningMoments::add(double value) {
+    n++;
+    if (n == 1) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    double delta = value - mean_;
+    mean_ += delta / n;
+    m2 += delta * (value - mean_);
+}
+
+void RunningMoments::merge(const RunningMoments& other) {
+    if (other.n == 0) return;
+    if (n == 0) {
+        *this = other;
+        return;
+    }
+    long long total = n + other.n;
+    double delta = other.mean_ - mean_;
+    mean_ += delta * other.n / total;
+    m2 += other.m2 + delta * delta * (static_cast<double>(n) * other.n / total);
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    n = total;
+}
+
+double RunningMoments::stddev() const {
+    return std::sqrt(variance());
+}
+
+QuantileSketch::QuantileSketch(int k, uint32_t seed) : k(std::max(k, 8)), coin(seed ? seed : 1) {}
+
+// Lower levels get geometrically smaller buffers (2/3 per level below the top)
+int QuantileSketch::capacity(int level) const {
+    int depth = static_cast<int>(levels.size()) - 1 - level;
+    return std::max(2, static_cast<int>(k * std::pow(2.0 / 3.0, depth)));
+}
+
+bool QuantileSketch::flip() {
+    coin ^= coin << 13;
+    coin ^= coin >> 17;
+    coin ^= coin << 5;
+    return coin & 1;
+}
+
+void QuantileSketch::compress() {
+    for (size_t h = 0; h < levels.size(); ++h) {
+        if (static_cast<int>(levels[h].size()) < capacity(static_cast<int>(h))) continue;
+        if (h + 1 == levels.size()) levels.emplace_back();
+
+        std::vector<double>& level = levels[h];
+        std::sort(level.begin(), level.end());
+        // An odd item out stays behind at this level, so the total weight is unchanged
+        double leftover = 0.0;
+        bool odd = level.size() % 2 == 1;
+        if (odd) {
+            leftover = level.back();
+            level.pop_back();
+        }
+        for (size_t i = flip() ? 1 : 0; i < level.size(); i += 2) {
+            levels[h + 1].push_back(level[i]);
+        }
+        level.clear();
+        if (odd) level.push_back(leftover);
+    }
+}
+
+void QuantileSketch::add(double value) {
+    if (levels.empty()) levels.emplace_back();
+    if (n == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    n++;
+    levels[0].push_back(value);
+    if (static_cast<int>(levels[0].size()) >= capacity(0)) compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.n == 0) return;
+    if (n == 0) {
+        min_ = other.min_;
+        max_ = other.max_;
+    } else {
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+    n += other.n;
+    if (levels.size() < other.levels.size()) levels.resize(other.levels.size());
+    for (size_t h = 0; h < other.levels.size(); ++h) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    }
+    compress();
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (n == 0) return 0.0;
+    if (q <= 0.0) return min_;
+    if (q >= 1.0) return max_;
+
+    std::vector<std::pair<double, long long>> weighted;
+    weighted.reserve(retained());
+    for (size_t h = 0; h < levels.size(); ++h) {
+        for (double value : levels[h]) {
+            weighted.push_back({value, 1LL << h});
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    double target = q * n;
+    long long seen = 0;
+    for (const auto& item : weighted) {
+        seen += item.second;
+        if (seen >= target) return item.first;
+    }
+    return max_;
+}
+
+size_t QuantileSketch::retained() const {
+    size_t items = 0;
+    for (const auto& level : levels) {
+        items += level.size();
+    }
+    return items;
+}
+
+Histogram::Histogram(double low, double high, int binCount) : low(low), high(high), bins(std::max(binCount, 1), 0) {
+    if (!(high > low)) throw std::invalid_argument("histogram: empty range");
+}
+
+void Histogram::add(double value) {
+    if (value < low) {
+        underflow++;
+    } else if (value >= high) {
+        overflow++;
+    } else {
+        size_t index = static_cast<size_t>((value - low) / (high - low) * bins.size());
+        bins[std::min(index, bins.size() - 1)]++;
+    }
+}
+
+void Histogram::merge(const Histogram& other) {
+    if (other.low != low || other.high != high || other.bins.size() != bins.size()) {
+        throw std::invalid_argument("histogram: merging different bin layouts");
+    }
+    for (size_t i = 0; i < bins.size(); ++i) {
+        bins[i] += other.bins[i];
+    }
+    underflow += other.underflow;
+    overflow += other.overflow;
+}
+
+long long Histogram::total() const {
+    long long sum = underflow + overflow;
+    for (long long count : bins) {
+        sum += count;
+    }
+    return sum;
+}
+
+GameDistributions::GameDistributions(int maxRolls) : gameLengthHistogram(0.0, std::max(maxRolls, 1) + 1.0, 50) {}
+
+void GameDistributions::record(const GameSummary& summary) {
+    gameLength.add(summary.rolls);
+    gameLengthQuantiles.add(summary.rolls);
+    gameLengthHistogram.add(summary.rolls);
+    for (int seat = 0; seat < summary.numPlayers && seat < kMaxSimPlayers; ++seat) {
+        finalMoney.add(summary.finalMoney[seat]);
+        finalMoneyQuantiles.add(summary.finalMoney[seat]);
+        rentEarned[seat].add(summary.rentEarned[seat]);
+        rentEarnedQuantiles[seat].add(summary.rentEarned[seat]);
+    }
+}
+
+void GameDistributions::merge(const GameDistributions& other) {
+    gameLength.merge(other.gameLength);
+    gameLengthQuantiles.merge(other.gameLengthQuantiles);
+    gameLengthHistogram.merge(other.gameLengthHistogram);
+    finalMoney.merge(other.finalMoney);
+    finalMoneyQuantiles.merge(other.finalMoneyQuantiles);
+    for (int seat = 0; seat < kMaxSimPlayers; ++seat) {
+        rentEarned[seat].merge(other.rentEarned[seat]);
+        rentEarnedQuantiles[seat].merge(other.rentEarnedQuantiles[seat]);
+    }
+}
+
+namespace {
+constexpr long long kMaxGamesPerRun = 1 << 30;  // Games per LockstepSimulator::run call
+} // namespace
+
+GameDistributions collectDistributions(uint32_t firstSeed, long long numGames, int numPlayers, int maxRolls, int threads) {
+    threads = std::max(1, threads);
+    std::vector<GameDistributions> perWorker(threads, GameDistributions(maxRolls));
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        long long begin = numGames * w / threads;
+        long long end = numGames * (w + 1) / threads;
+        workers.emplace_back([&, w, begin, end] {
+            auto board = Board::create();
+            LockstepSimulator simulator(*board, numPlayers, maxRolls);
+            // run() takes an int count, so a large share is played in chunks that continue the seeds
+            for (long long chunk = begin; chunk < end; chunk += kMaxGamesPerRun) {
+                int games = static_cast<int>(std::min<long long>(end - chunk, kMaxGamesPerRun));
+                simulator.run(firstSeed + static_cast<uint32_t>(chunk), games, &perWorker[w]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    GameDistributions merged(maxRolls);
+    for (const auto& distributions : perWorker) {
+        merged.merge(distributions);
+    }
+    return merged;
+}
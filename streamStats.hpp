@@ -0,0 +1,109 @@
+#ifndef STREAM_STATS_HPP
+#define STREAM_STATS_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "simulation.hpp"
+
+// Accumulators that see each value once, keep a fixed amount of memory, and merge: each worker
+// fills its own and the results are merged at the end.
+
+// Count, mean, variance, min and max (Welford's update, Chan's merge)
+class RunningMoments {
+private:
+    long long n = 0;
+    double mean_ = 0.0;
+    double m2 = 0.0;   // Sum of squared differences from the mean
+    double min_ = 0.0;
+    double max_ = 0.0;
+
+public:
+    void add(double value);
+    void merge(const RunningMoments& other);
+
+    long long count() const { return n; }
+    double mean() const { return mean_; }
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }  // Sample variance
+    double stddev() const;
+    double min() const { return min_; }
+    double max() const { return max_; }
+};
+
+// KLL quantile sketch. Values are kept in levels; level h holds items that each stand for 2^h
+// values. A full level is sorted and every other item (odd or even, by coin flip) moves up, so the
+// sketch stays at about 3k items. Rank error is around 1.7 / k (about 1% at the default k).
+class QuantileSketch {
+private:
+    int k;
+    std::vector<std::vector<double>> levels;
+    long long n = 0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+    uint32_t coin;   // xorshift state for the compaction coin flips; fixed, so results are reproducible
+
+    int capacity(int level) const;
+    void compress();
+    bool flip();
+
+public:
+    explicit QuantileSketch(int k = 256, uint32_t seed = 0x2545F491u);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    // Value at quantile q in [0, 1] (0 and 1 give the exact min and max); 0 if empty
+    double quantile(double q) const;
+
+    long long count() const { return n; }
+    size_t retained() const;   // Items kept, for memory checks
+};
+
+// Fixed-width bins over [low, high) plus underflow and overflow counts
+class Histogram {
+private:
+    double low;
+    double high;
+    std::vector<long long> bins;
+    long long underflow = 0;
+    long long overflow = 0;
+
+public:
+    Histogram(double low, double high, int binCount);
+
+    void add(double value);
+
+    // Add another histogram with the same range and bins (std::invalid_argument otherwise)
+    void merge(const Histogram& other);
+
+    int binCount() const { return static_cast<int>(bins.size()); }
+    long long bin(int index) const { return bins[index]; }
+    double binLow(int index) const { return low + (high - low) * index / bins.size(); }
+    long long getUnderflow() const { return underflow; }
+    long long getOverflow() const { return overflow; }
+    long long total() const;
+};
+
+// Distributions of game length, final money and rent earned per seat, fed one GameSummary at a time
+class GameDistributions : public GameSink {
+public:
+    RunningMoments gameLength;        // Dice rolls per game
+    QuantileSketch gameLengthQuantiles;
+    Histogram gameLengthHistogram;    // 50 bins up to the roll cap
+    RunningMoments finalMoney;        // Every seat of every game
+    QuantileSketch finalMoneyQuantiles;
+    std::array<RunningMoments, kMaxSimPlayers> rentEarned;
+    std::array<QuantileSketch, kMaxSimPlayers> rentEarnedQuantiles;
+
+    explicit GameDistributions(int maxRolls = 1000);
+
+    void record(const GameSummary& summary) override;
+    void merge(const GameDistributions& other);
+};
+
+// Play games [firstSeed, firstSeed + numGames) with the lockstep engine on `threads` workers.
+// Each worker fills its own GameDistributions; they are merged in worker order, so the result
+// does not depend on scheduling. Any count fits; seeds wrap around after 2^32 games.
+GameDistributions collectDistributions(uint32_t firstSeed, long long numGames, int numPlayers, int maxRolls, int threads);
+
+#endif // STREAM_STATS_HPP
@@ -1,28 +1,102 @@
 #include "streetTile.hpp"
 #include "player.hpp"
-#include <iostream>
+#include "game.hpp"
+#include "profiler.hpp"
+#include "logger.hpp"
 
 void StreetTile::onLand(std::shared_ptr<Player> player, Game& game) {
+    PROFILE_SCOPE("onLand:Street");
     if (owner == nullptr) {
         // Player can buy the property
-        std::cout << player->getName() << ", do you want to buy " << getName() << "? (Price: $" << basePrice << ")\n";
+        LOG_DEBUG(player->getName() << ", do you want to buy " << getName() << "? (Price: $" << basePrice << ")");
         if (player->getMoney() >= basePrice) {
             player->buyProperty(shared_from_this());  // Player buys the property
+            game.getTileCounts().recordPurchase(player->getPosition());
             setOwner(player);  // Set the current player as the owner
-            std::cout << player->getName() << " has bought " << getName() << "!\n";
+            LOG_INFO(player->getName() << " has bought " << getName() << "!");
         } else {
-            std::cout << player->getName() << " doesn't have enough money to buy " << getName() << ".\n";
+            LOG_INFO(player->getName() << " doesn't have enough money to buy " << getName() << ".");
+            game.auctionProperty(shared_from_this(), basePrice, player->getPosition());
         }
     } else if (owner == player) {
         // Player landed on their own property
-        std::cout << player->getName() << " landed on their own property.\n";
+        LOG_INFO(player->getName() << " landed on their own property.");
+    } else if (mortgaged) {
+        LOG_INFO(getName() << " is mortgaged; no rent is due.");
     } else {
         // Player landed on another player's property, pay rent
         int rent = calculateRent();
-        std::cout << player->getName() << " landed on " << owner->getName() << "'s property and must pay $" << rent << " in rent.\n";
-        player->payRent(*owner, rent);  // Player pays rent to the owner
+        LOG_INFO(player->getName() << " landed on " << owner->getName() << "'s property and must pay $" << rent << " in rent.");
+        if (player->payRent(*owner, rent)) {  // Player pays rent to the owner
+            game.getTileCounts().recordRent(player->getPosition(), rent);
+        }
+    }
+}
+
+namespace {
+
+// No building on a group while any of its streets is mortgaged
+bool anyMortgaged(const std::vector<StreetTile*>& colorGroupTiles) {
+    return std::any_of(colorGroupTiles.begin(), colorGroupTiles.end(), [](StreetTile* tile) { return tile->isMortgaged(); });
+}
+
+} // namespace
+
+bool StreetTile::buildHouse(const std::vector<StreetTile*>& colorGroupTiles) {
+    if (houses >= 4 || hasHotel || anyMortgaged(colorGroupTiles)) {
+        return false;
+    }
+
+    // If this street already has more houses than the others, it cannot build another house
+    for (StreetTile* tile : colorGroupTiles) {
+        if (tile->buildingLevel() < houses) return false;
     }
+
+    if (bank && !bank->takeHouses(1)) {
+        return false;  // Housing shortage
+    }
+    houses++;
+    if (owner) owner->recordBuildings(1, 0, houseCost());  // Keep the owner's asset totals current
+    return true;
 }
 
+bool StreetTile::buildHotel(const std::vector<StreetTile*>& colorGroupTiles) {
+    bool allHaveMaxHouses = std::all_of(colorGroupTiles.begin(), colorGroupTiles.end(), [](StreetTile* tile) {
+        return tile->buildingLevel() >= 4;
+    });
+
+    if (!allHaveMaxHouses || houses != 4 || anyMortgaged(colorGroupTiles)) {
+        return false;
+    }
+    if (bank) {
+        if (!bank->takeHotel()) return false;
+        bank->restock(4, 0);
+    }
+
+    hasHotel = true;
+    houses = 0; // Reset houses since the hotel takes over
+    if (owner) owner->recordBuildings(-4, 1, hotelCost() - 4 * houseCost());  // The four houses become a hotel
+    return true;
+}
 
+int StreetTile::sellBuilding(const std::vector<StreetTile*>& colorGroupTiles) {
+    int level = buildingLevel();
+    if (level == 0) return 0;
+    for (StreetTile* tile : colorGroupTiles) {
+        if (tile->buildingLevel() > level) return 0;  // Sell evenly: the most built-up street goes first
+    }
 
+    if (hasHotel) {
+        int kept = bank ? bank->takeHousesUpTo(4) : 4;
+        if (bank) bank->restock(0, 1);
+        int sold = hotelCost() - kept * houseCost();  // The hotel, less the houses it turns back into
+        hasHotel = false;
+        houses = kept;
+        if (owner) owner->recordBuildings(kept, -1, -sold);
+        return sold / 2;
+    }
+    houses--;
+    if (bank) bank->restock(1, 0);
+    if (owner) owner->recordBuildings(-1, 0, -houseCost());
+    return houseCost() / 2;
+}
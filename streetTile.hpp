@@ -7,6 +7,7 @@
 #include <string>
 #include <memory>
 #include "tile.hpp"
+#include "bankInventory.hpp"
 
 // Forward declare Player to avoid circular dependency
 class Player;
@@ -18,6 +19,7 @@ private:
     int baseRent;            // Base rent for the street without any houses or hotels
     int houses;              // Number of houses built (0 to 4)
     bool hasHotel;           // Whether the street has a hotel
+    BankInventory* bank = nullptr;  // Where buildings come from; set by the board, unlimited when null
 
 public:
     // Constructor
@@ -35,50 +37,33 @@ public:
     // Check if a hotel is built
     bool isHotelBuilt() const { return hasHotel; }
 
-    // Calculate the current rent dynamically based on houses or hotel
-    int calculateRent() const {
-          if (hasHotel) {
-        return baseRent * std::pow(2, 5);  // Rent for hotel
-        } else if (houses > 0) {
-         return baseRent * std::pow(2, houses);  // Rent for houses
-        }
-        return baseRent;  // Rent for no houses or hotel
-        
+    // Houses, or 5 for a hotel: what even building and selling compare across a color group
+    int buildingLevel() const { return hasHotel ? 5 : houses; }
+
+    void setBank(BankInventory* inventory) { bank = inventory; }
+
+    // Rent at a building level (houses, or 5 for a hotel): the base rent doubles with each building
+    int rentAt(int level) const {
+        return baseRent * std::pow(2, level);
     }
 
-    // Method to build a house (adds 1 house if possible and all color group streets have the same or fewer houses)
-    bool buildHouse(const std::vector<StreetTile*>& colorGroupTiles) {
-        int minHouses = (*std::min_element(colorGroupTiles.begin(), colorGroupTiles.end(),
-                            [](StreetTile* a, StreetTile* b) {
-                                return a->getHouseCount() < b->getHouseCount();
-                            }))->getHouseCount();
-
-        // If this street already has more houses than the others, it cannot build another house
-        if (houses > minHouses) {
-            return false; // Cannot build a house, as other streets in the group don't have enough houses
-        }
-
-        if (houses < 4 && !hasHotel) {
-            houses++;
-            return true;
-        }
-        return false;
+    // Calculate the current rent dynamically based on houses or hotel
+    int calculateRent() const {
+        return rentAt(buildingLevel());
     }
 
-    // Method to build a hotel (only if all streets in the color group have 4 houses)
-    bool buildHotel(const std::vector<StreetTile*>& colorGroupTiles) {
-        bool allHaveMaxHouses = std::all_of(colorGroupTiles.begin(), colorGroupTiles.end(), [](StreetTile* tile) {
-            return tile->getHouseCount() == 4;
-        });
+    // Method to build a house (adds 1 house if possible and all color group streets have the same or more
+    // houses). Fails when the bank has no house left.
+    bool buildHouse(const std::vector<StreetTile*>& colorGroupTiles);
 
-        if (!allHaveMaxHouses || hasHotel) {
-            return false;
-        }
+    // Method to build a hotel (only if all streets in the color group have 4 houses or a hotel). The four
+    // houses go back to the bank; fails when the bank has no hotel left.
+    bool buildHotel(const std::vector<StreetTile*>& colorGroupTiles);
 
-        hasHotel = true;
-        houses = 0; // Reset houses since the hotel takes over
-        return true;
-    }
+    // Sell one building back to the bank at half its cost, only from the most built-up street of the group.
+    // A hotel goes back to four houses, or as many as the bank has left with the rest sold too.
+    // Returns the cash raised, 0 if there is nothing to sell here.
+    int sellBuilding(const std::vector<StreetTile*>& colorGroupTiles);
 
     // Calculate the cost of a house
     int houseCost() const {
@@ -90,6 +75,23 @@ public:
         return (basePrice * 4) + 100; // Hotel cost: base price * 4 + 100
     }
 
+    // Put back the buildings of a saved game (no cost, no group checks, no bank shortage)
+    void restoreBuildings(int houseCount, bool hotel) {
+        if (bank) bank->restock(houses - houseCount, (hasHotel ? 1 : 0) - (hotel ? 1 : 0));
+        houses = houseCount;
+        hasHotel = hotel;
+    }
+
+    // Cost of the buildings standing at a building level
+    int buildingValueAt(int level) const {
+        return level >= 5 ? hotelCost() : level * houseCost();
+    }
+
+    // Cost of the buildings currently standing on the street
+    int buildingValue() const {
+        return buildingValueAt(buildingLevel());
+    }
+
     // Define what happens when a player lands on this street
     void onLand(std::shared_ptr<Player> player, Game& game) override;
 };
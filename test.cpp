@@ -8,6 +8,33 @@
 #include "game.hpp"
 #include "dice.hpp"
 #include "cards.hpp"
+#include "simulation.hpp"
+#include "lockstepSim.hpp"
+#include "profiler.hpp"
+#include "tileStats.hpp"
+#include "cardDeck.hpp"
+#include "logger.hpp"
+#include "protocol.hpp"
+#include "gameServer.hpp"
+#include "stateSync.hpp"
+#include "spectatorView.hpp"
+#include "gameSave.hpp"
+#include "batchRunner.hpp"
+#include "streamStats.hpp"
+#include "resultStore.hpp"
+#include "ruleSweep.hpp"
+#include "auction.hpp"
+#include "trade.hpp"
+#include "cashRaising.hpp"
+#include "jail.hpp"
+#include "propertyRoi.hpp"
+#include "endgame.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
 #include <SFML/System.hpp>
 
 // Test cases for Player class
@@ -401,6 +428,1881 @@ TEST_CASE("Community Chest Cards: Go to Jail") {
 
 
 
+TEST_CASE("Card purchases give the tile to the drawing player") {
+    auto player = std::make_shared<Player>("Player 1", 1500);
+    auto other = std::make_shared<Player>("Player 2", 1500);
+    Game game({player, other}, Board::create());
+
+    player->setPosition(36);
+    auto card = std::make_shared<AdvanceToNearestRailroadCard>();
+    player->handleChanceCard(card, game);
+
+    CHECK(player->getPosition() == 5);
+    CHECK(game.getTile(5)->getOwner() == player);  // Not a detached copy of the player
+}
+
+TEST_CASE("Lockstep engine matches the scalar engine") {
+    auto board = Board::create();
+    LockstepSimulator simulator(*board, 2, 1000);
+    SimStats lockstep = simulator.run(1, 800);
+    SimStats scalar = runScalarGames(1, 400, 2, 1000);
+
+    CHECK(lockstep.games == 800);
+    CHECK(scalar.games == 400);
+    CHECK(lockstep.wins[0] + lockstep.wins[1] == lockstep.finishedGames);
+
+    // Same rules, so the same landing distribution and game length up to sampling noise
+    for (int tile = 0; tile < kBoardTiles; ++tile) {
+        CHECK(std::abs(lockstep.landingFrequency(tile) - scalar.landingFrequency(tile)) < 0.004);
+    }
+    CHECK(std::abs(lockstep.meanRolls() - scalar.meanRolls()) < 0.1 * scalar.meanRolls());
+}
+
+TEST_CASE("Lockstep engine is reproducible") {
+    auto board = Board::create();
+    LockstepSimulator first(*board, 3, 500);
+    LockstepSimulator second(*board, 3, 500);
+    SimStats a = first.run(42, 100);
+    SimStats b = second.run(42, 100);
+
+    CHECK(a.totalRolls == b.totalRolls);
+    CHECK(a.landings == b.landings);
+    CHECK(a.wins == b.wins);
+}
+
+TEST_CASE("Player asset totals follow purchases, builds and transfers") {
+    auto alice = std::make_shared<Player>("Alice", 1500);
+    auto bob = std::make_shared<Player>("Bob", 1500);
+    Game game({alice, bob}, Board::create());
+    Board& board = game.getBoard();
+
+    auto orange = board.getColorGroupProperties("Orange");
+    for (StreetTile* street : orange) {
+        alice->buyProperty(board.findPropertyByName(street->getName()));
+    }
+    alice->buyProperty(board.getTile(5));  // Reading Railroad
+    CHECK(alice->getPropertyValue() == 180 + 180 + 200 + 200);
+    CHECK(alice->getNetWorth() == 1500);
+
+    for (int round = 0; round < 4; ++round) {
+        for (StreetTile* street : orange) street->buildHouse(orange);
+    }
+    orange[0]->buildHotel(orange);
+    CHECK(alice->getHouseCount() == 8);
+    CHECK(alice->getHotelCount() == 1);
+    CHECK(alice->getPropertyValue() == 760 + orange[0]->hotelCost() + 4 * (180 + 200));
+
+    GeneralRepairsCard repairs;
+    int before = alice->getMoney();
+    repairs.execute(alice, game);
+    CHECK(before - alice->getMoney() == 8 * 25 + 100);
+
+    // Bankruptcy hands the properties, buildings included, to the creditor
+    int value = alice->getPropertyValue();
+    alice->declareBankruptcy(*bob);
+    CHECK(alice->getPropertyValue() == 0);
+    CHECK(alice->getHouseCount() == 0);
+    CHECK(bob->getPropertyValue() == value);
+    CHECK(bob->getHouseCount() == 8);
+    CHECK(bob->getHotelCount() == 1);
+    CHECK(bob->getProperties().size() == 4);
+    CHECK(board.getTile(5)->getOwner() == bob);
+}
+
+TEST_CASE("Card decks draw every card once per shuffle") {
+    RandomStream rng(7);
+    CardDeck deck = CardDeck::standardChance();
+    deck.shuffle(rng);
+
+    // One full pass sees each card exactly once; the jail card is then held out
+    std::vector<int> seen(deck.size(), 0);
+    for (int i = 0; i < deck.size(); ++i) {
+        auto card = deck.draw(rng);
+        for (int c = 0; c < deck.size(); ++c) {
+            if (&deck.getCard(c) == card) seen[c]++;
+        }
+    }
+    CHECK(std::count(seen.begin(), seen.end(), 1) == deck.size());
+    CHECK(deck.heldCount() == 1);
+
+    for (int i = 0; i < 3 * deck.size(); ++i) {
+        CHECK(deck.draw(rng)->isKeepable() == false);
+    }
+
+    // Forking a deck replays the same draws
+    CardDeck fork = deck;
+    RandomStream forkRng = rng;
+    for (int i = 0; i < 10; ++i) {
+        CHECK(deck.draw(rng)->name == fork.draw(forkRng)->name);
+    }
+
+    CHECK(deck.returnHeldCard());
+    CHECK(deck.heldCount() == 0);
+    CHECK_FALSE(deck.returnHeldCard());
+}
+
+TEST_CASE("Get Out of Jail Free cards go back to the deck they came from") {
+    QuietOutput quiet;
+    auto alice = std::make_shared<Player>("Alice", 1500);
+    auto bob = std::make_shared<Player>("Bob", 1500);
+    Game game({alice, bob}, Board::create());
+    game.seed(5);
+
+    // Draw until each deck's jail card comes up; both end up with Alice
+    auto drawJailCard = [&](CardDeck& deck) {
+        while (true) {
+            const CardSpec* card = deck.draw(game.getRandom());
+            if (card->isKeepable()) return card;
+        }
+    };
+    alice->handleCommunityChestCard(*drawJailCard(game.getCommunityChestDeck()), game);
+    alice->handleChanceCard(*drawJailCard(game.getChanceDeck()), game);
+    CHECK(alice->getOutOfJailCardCount() == 2);
+    CHECK(alice->getOutOfJailCardCount(DeckKind::Chance) == 1);
+    CHECK(alice->getOutOfJailCardCount(DeckKind::CommunityChest) == 1);
+    CHECK(game.getChanceDeck().heldCount() == 1);
+    CHECK(game.getCommunityChestDeck().heldCount() == 1);
+
+    // Both cards survive a save
+    std::vector<uint8_t> saved;
+    gameSave::save(game, saved);
+    auto loaded = gameSave::load(saved.data(), saved.size());
+    CHECK(loaded->getSeats()[0]->getJailCards() == alice->getJailCards());
+
+    // Each card is played once and rejoins its own deck
+    CHECK(game.useGetOutOfJailCard(alice));
+    CHECK(alice->getOutOfJailCardCount() == 1);
+    CHECK(game.getChanceDeck().heldCount() == 0);
+    CHECK(game.getCommunityChestDeck().heldCount() == 1);
+    CHECK(game.useGetOutOfJailCard(alice));
+    CHECK_FALSE(alice->hasGetOutOfJailFreeCard());
+    CHECK(game.getCommunityChestDeck().heldCount() == 0);
+    CHECK_FALSE(game.useGetOutOfJailCard(alice));
+}
+
+TEST_CASE("Card descriptors run through one interpreter") {
+    auto player = std::make_shared<Player>("Player 1", 1500);
+    auto other = std::make_shared<Player>("Player 2", 1500);
+    Game game({player, other}, Board::create());
+
+    const CardSpec bankError = {CardAction::Collect, 0, 150, 0, 0, "card:BankError", "Bank error in your favour"};
+    const CardSpec doctorsFee = {CardAction::Pay, 0, 50, 0, 0, "card:DoctorsFee", "Doctor's fee"};
+    executeCard(bankError, player, game);
+    executeCard(doctorsFee, player, game);
+    CHECK(player->getMoney() == 1600);
+
+    // Advancing past Go pays salary when the card says so
+    const CardSpec boardwalk = {CardAction::AdvanceTo, 39, 0, 0, CollectPassingGo, "card:Boardwalk", "Advance to Boardwalk"};
+    player->setPosition(7);
+    executeCard(boardwalk, player, game);
+    CHECK(player->getPosition() == 39);
+    CHECK(game.getTile(39)->getOwner() == player);
+    CHECK(player->getMoney() == 1200);  // No salary (39 is ahead of 7), $400 for Boardwalk
+}
+
+TEST_CASE("Game log writes leveled messages in the background") {
+    Logger& log = Logger::instance();
+    std::ostringstream captured;
+    log.setSink(&captured);
+
+    LOG_INFO("Alice paid $" << 50 << " in rent");
+    LOG_WARN("Bob is bankrupt");
+    LOG_DEBUG("compiled out at the default level");
+    {
+        QuietOutput quiet;
+        LOG_INFO("silenced");
+    }
+    log.flush();
+    CHECK(captured.str() == "Alice paid $50 in rent\n[warn] Bob is bankrupt\n");
+
+    // Runtime threshold
+    captured.str("");
+    log.setLevel(LogLevel::Warn);
+    LOG_INFO("below the threshold");
+    LOG_ERROR("shown");
+    log.flush();
+    log.setLevel(LogLevel::Info);
+    CHECK(captured.str() == "[error] shown\n");
+
+    // Producers on several threads; every message arrives whole
+    captured.str("");
+    uint64_t droppedBefore = log.dropped();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 200; ++i) {
+                LOG_INFO("thread " << t << " message " << i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    log.flush();
+    log.setSink(&std::cout);
+
+    int lines = 0;
+    int notices = 0;
+    std::istringstream in(captured.str());
+    for (std::string line; std::getline(in, line);) {
+        if (line.rfind("[warn] ", 0) == 0 && line.find(" log messages dropped") != std::string::npos) {
+            notices++;
+            continue;
+        }
+        CHECK(line.rfind("thread ", 0) == 0);
+        lines++;
+    }
+    CHECK(lines + static_cast<int>(log.dropped() - droppedBefore) == 800);
+    CHECK((notices > 0) == (log.dropped() != droppedBefore));
+
+    // Long messages span several slots and arrive whole; a blocking log drops nothing
+    captured.str("");
+    log.setSink(&captured);
+    std::string longText(3 * Logger::kMessageBytes + 17, 'x');
+    log.setBlocking(true);
+    droppedBefore = log.dropped();
+    threads.clear();
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&longText] {
+            for (int i = 0; i < 500; ++i) {
+                LOG_INFO(longText);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    log.flush();
+    log.setBlocking(false);
+    log.setSink(&std::cout);
+    CHECK(log.dropped() == droppedBefore);
+    lines = 0;
+    std::istringstream longIn(captured.str());
+    for (std::string line; std::getline(longIn, line); ++lines) {
+        CHECK(line == longText);
+    }
+    CHECK(lines == 2000);
+}
+
+TEST_CASE("Table host applies protocol requests") {
+    using namespace protocol;
+    TableHost host(2);
+
+    // Requests survive the wire format
+    Request create;
+    create.op = Op::CreateTable;
+    create.seat = 3;
+    create.arg = 42;
+    std::vector<uint8_t> bytes;
+    encode(create, bytes);
+    REQUIRE(bytes.size() == kRequestBytes);
+    Request decoded;
+    CHECK(decode(bytes.data(), bytes.size() - 1, decoded) == 0);
+    REQUIRE(decode(bytes.data(), bytes.size(), decoded) == kRequestBytes);
+    CHECK(decoded.seat == 3);
+    CHECK(decoded.arg == 42);
+
+    Response created = host.handle(decoded);
+    REQUIRE(created.status == ReplyStatus::Ok);
+    CHECK(created.seatCount == 3);
+    CHECK(created.seats[0].money == 1500);
+    CHECK(host.tableCount() == 1);
+
+    Request roll;
+    roll.op = Op::Roll;
+    roll.table = created.table;
+    Response rolled = host.handle(roll);
+    CHECK(rolled.status == ReplyStatus::Ok);
+    CHECK(rolled.rolls >= 1);
+
+    // Responses survive the wire format too
+    bytes.clear();
+    encode(rolled, bytes);
+    CHECK(bytes.size() == kResponseHeaderBytes + 3 * kSeatBytes);
+    Response echoed;
+    REQUIRE(decode(bytes.data(), bytes.size(), echoed) == bytes.size());
+    CHECK(echoed.rolls == rolled.rolls);
+    CHECK(echoed.seats[2].position == rolled.seats[2].position);
+
+    // Rule and addressing errors
+    Request buy;
+    buy.op = Op::Buy;
+    buy.table = created.table;
+    buy.seat = 2;  // Hasn't moved yet: standing on Go
+    CHECK(host.handle(buy).status == ReplyStatus::NotAllowed);
+    buy.seat = 9;
+    CHECK(host.handle(buy).status == ReplyStatus::BadRequest);
+
+    Request build;
+    build.op = Op::Build;
+    build.table = created.table;
+    build.tile = 39;  // Boardwalk, not owned
+    CHECK(host.handle(build).status == ReplyStatus::NotAllowed);
+
+    Request unknown = roll;
+    unknown.table = created.table + 7;
+    CHECK(host.handle(unknown).status == ReplyStatus::UnknownTable);
+
+    create.seat = 1;
+    CHECK(host.handle(create).status == ReplyStatus::BadRequest);
+    create.seat = 2;
+    Response second = host.handle(create);
+    CHECK(second.status == ReplyStatus::Ok);
+    CHECK(host.handle(create).status == ReplyStatus::ServerFull);
+
+    // A closed table's id stays dead after its slot is reused
+    Request close;
+    close.op = Op::CloseTable;
+    close.table = created.table;
+    CHECK(host.handle(close).status == ReplyStatus::Ok);
+    Response reused = host.handle(create);
+    CHECK(reused.status == ReplyStatus::Ok);
+    CHECK(reused.table != created.table);
+    CHECK(host.handle(roll).status == ReplyStatus::UnknownTable);
+    CHECK(host.tableCount() == 2);
+}
+
+TEST_CASE("Game server answers pipelined requests over a Unix socket") {
+    using namespace protocol;
+    std::string path = "/tmp/monopoly_test_" + std::to_string(::getpid()) + ".sock";
+    GameServer server;
+    server.listenUnix(path);
+    std::thread loop([&server] { server.run(); });
+
+    {
+        Client client;
+        client.connectUnix(path);
+
+        Request create;
+        create.op = Op::CreateTable;
+        create.seat = 2;
+        create.arg = 7;
+        Response created = client.call(create);
+        REQUIRE(created.status == ReplyStatus::Ok);
+
+        Request roll;
+        roll.op = Op::Roll;
+        roll.table = created.table;
+        for (int i = 0; i < 10; ++i) client.send(roll);
+        uint32_t rolls = 0;
+        for (int i = 0; i < 10; ++i) {
+            Response reply = client.receive();
+            CHECK(reply.op == Op::Roll);
+            CHECK(reply.rolls > rolls);  // Replies come back in request order
+            rolls = reply.rolls;
+        }
+
+        Request status;
+        status.op = Op::Status;
+        status.table = created.table;
+        Response state = client.call(status);
+        CHECK(state.rolls == rolls);
+        CHECK(state.seatCount == 2);
+    }
+
+    server.stop();
+    loop.join();
+    CHECK(server.getTables().tableCount() == 1);
+}
+
+TEST_CASE("Spectator mirrors follow turn-by-turn state updates") {
+    QuietOutput quiet;
+    std::vector<std::shared_ptr<Player>> seats = {
+        std::make_shared<Player>("Alice", 1500), std::make_shared<Player>("Bob", 1500), std::make_shared<Player>("Carol", 1500)};
+    Game game(seats, Board::create());
+    game.seed(11);
+
+    StateEncoder encoder;
+    SpectatorView view;
+    std::vector<uint8_t> update;
+    REQUIRE(encoder.encodeTurn(game, update));  // Keyframe
+    REQUIRE(view.apply(update.data(), update.size()));
+    CHECK(view.getMirror().state() == GameState::capture(game));
+
+    update.clear();
+    CHECK_FALSE(encoder.encodeTurn(game, update));  // Nothing changed, nothing sent
+    CHECK(update.empty());
+
+    size_t deltaBytes = 0;
+    int turns = 0;
+    for (; turns < 200 && game.getPlayers().size() > 1; ++turns) {
+        game.playTurn();
+        update.clear();
+        if (!encoder.encodeTurn(game, update)) continue;
+        deltaBytes += update.size();
+        REQUIRE(view.apply(update.data(), update.size()));
+        REQUIRE(view.getMirror().state() == GameState::capture(game));
+    }
+    update.clear();
+    encoder.encodeKeyframe(update);
+    CHECK(deltaBytes / turns < update.size() / 2);  // Only changed fields travel
+
+    sf::RenderWindow window(sf::VideoMode(800, 800), "Spectator");
+    CHECK(view.needsRedraw());
+    view.draw(window);
+    CHECK_FALSE(view.needsRedraw());
+
+    // A missed update is refused until a keyframe arrives
+    StateMirror late;
+    game.playTurn();
+    update.clear();
+    if (encoder.encodeTurn(game, update)) {
+        CHECK_FALSE(late.apply(update.data(), update.size()));
+    }
+    update.clear();
+    encoder.encodeKeyframe(update);
+    REQUIRE(late.apply(update.data(), update.size()));
+    CHECK(late.state() == GameState::capture(game));
+    CHECK(late.getSequence() == encoder.getSequence());
+
+    // A truncated update is rejected and leaves the mirror as it was
+    CHECK_FALSE(late.apply(update.data(), update.size() - 1));
+    CHECK(late.state() == GameState::capture(game));
+}
+
+TEST_CASE("Game server streams each table's updates to its spectators") {
+    using namespace protocol;
+    std::string path = "/tmp/monopoly_spectate_" + std::to_string(::getpid()) + ".sock";
+    GameServer server;
+    server.listenUnix(path);
+    std::thread loop([&server] { server.run(); });
+
+    {
+        Client player;
+        player.connectUnix(path);
+        Request create;
+        create.op = Op::CreateTable;
+        create.seat = 3;
+        create.arg = 5;
+        Response created = player.call(create);
+        REQUIRE(created.status == ReplyStatus::Ok);
+
+        Request subscribe;
+        subscribe.op = Op::Subscribe;
+        subscribe.table = created.table;
+        Client spectator;
+        spectator.connectUnix(path);
+        REQUIRE(spectator.call(subscribe).status == ReplyStatus::Ok);
+
+        StateMirror mirror;
+        Update keyframe = spectator.receiveUpdate();  // Sent ahead of the reply
+        CHECK(keyframe.table == created.table);
+        REQUIRE(mirror.apply(keyframe.data.data(), keyframe.data.size()));
+
+        auto matches = [&mirror](const Response& reply) {
+            const GameState& state = mirror.state();
+            bool same = state.rolls == reply.rolls && state.seatCount == reply.seatCount;
+            for (int i = 0; i < reply.seatCount; ++i) {
+                same = same && state.seats[i].money == reply.seats[i].money &&
+                       state.seats[i].position == reply.seats[i].position;
+            }
+            return same;
+        };
+        CHECK(matches(created));
+
+        Request roll;
+        roll.op = Op::Roll;
+        roll.table = created.table;
+        Response reply;
+        for (int i = 0; i < 30; ++i) {
+            reply = player.call(roll);
+            Update update = spectator.receiveUpdate();  // Every roll changes the table
+            REQUIRE(mirror.apply(update.data.data(), update.data.size()));
+            CHECK(matches(reply));
+        }
+
+        // A late spectator starts from a keyframe of the same state
+        Client late;
+        late.connectUnix(path);
+        REQUIRE(late.call(subscribe).status == ReplyStatus::Ok);
+        StateMirror lateMirror;
+        Update lateKeyframe = late.receiveUpdate();
+        REQUIRE(lateMirror.apply(lateKeyframe.data.data(), lateKeyframe.data.size()));
+        CHECK(lateMirror.state() == mirror.state());
+
+        // Unsubscribed and disconnected spectators get nothing more; the player is unaffected
+        Request unsubscribe = subscribe;
+        unsubscribe.op = Op::Unsubscribe;
+        CHECK(spectator.call(unsubscribe).status == ReplyStatus::Ok);
+        late.close();
+        reply = player.call(roll);
+        CHECK(reply.status == ReplyStatus::Ok);
+        Request status;
+        status.op = Op::Status;
+        status.table = created.table;
+        CHECK(spectator.call(status).rolls == reply.rolls);
+        CHECK_FALSE(spectator.hasUpdate());
+    }
+
+    server.stop();
+    loop.join();
+}
+TEST_CASE("Saved games load and play on identically") {
+    QuietOutput quiet;
+    std::vector<std::shared_ptr<Player>> seats = {
+        std::make_shared<Player>("Alice", 1500), std::make_shared<Player>("Bob", 1500), std::make_shared<Player>("Carol", 1500)};
+    Game game(seats, Board::create());
+    game.seed(23);
+    for (int turn = 0; turn < 60 && game.getPlayers().size() > 1; ++turn) {
+        game.playTurn();
+    }
+
+    // A house on an owned street travels with the save
+    for (int t = 0; t < kBoardTiles; ++t) {
+        auto street = std::dynamic_pointer_cast<StreetTile>(game.getTile(t));
+        if (street && street->getOwner()) {
+            street->restoreBuildings(2, false);
+            street->getOwner()->recordBuildings(2, 0, 2 * street->houseCost());
+            break;
+        }
+    }
+
+    std::vector<uint8_t> saved;
+    gameSave::save(game, saved);
+    CHECK(saved.size() == gameSave::savedSize(3, kBoardTiles));
+    auto loaded = gameSave::load(saved.data(), saved.size());
+    REQUIRE(loaded);
+    CHECK(GameState::capture(*loaded) == GameState::capture(game));
+    for (int i = 0; i < 3; ++i) {
+        const Player& original = *game.getSeats()[i];
+        const Player& copy = *loaded->getSeats()[i];
+        CHECK(copy.getName() == original.getName());
+        CHECK(copy.getNetWorth() == original.getNetWorth());
+        CHECK(copy.getHouseCount() == original.getHouseCount());
+        CHECK(copy.getProperties().size() == original.getProperties().size());
+    }
+
+    // Same dice, same cards, same decisions from here on
+    for (int turn = 0; turn < 200 && game.getPlayers().size() > 1; ++turn) {
+        game.playTurn();
+        loaded->playTurn();
+        REQUIRE(GameState::capture(*loaded) == GameState::capture(game));
+    }
+    CHECK(loaded->getChanceDeck().state().cursor == game.getChanceDeck().state().cursor);
+
+    // Files go through a rename and load from a mapping
+    std::string path = "/tmp/monopoly_save_test_" + std::to_string(::getpid()) + ".bin";
+    gameSave::saveFile(game, path);
+    auto fromFile = gameSave::loadFile(path);
+    CHECK(GameState::capture(*fromFile) == GameState::capture(game));
+    ::unlink(path.c_str());
+
+    // Truncated saves and other versions are refused
+    CHECK_THROWS_AS(gameSave::load(saved.data(), saved.size() - 1), std::runtime_error);
+    std::vector<uint8_t> future = saved;
+    future[4] = 99;
+    CHECK_THROWS_AS(gameSave::load(future.data(), future.size()), std::runtime_error);
+
+    // A server's tables checkpoint and restore under the same ids
+    TableHost host;
+    protocol::Request create;
+    create.op = protocol::Op::CreateTable;
+    create.seat = 2;
+    create.arg = 5;
+    uint32_t first = host.handle(create).table;
+    uint32_t second = host.handle(create).table;
+    protocol::Request close;
+    close.op = protocol::Op::CloseTable;
+    close.table = first;
+    host.handle(close);
+    protocol::Request roll;
+    roll.op = protocol::Op::Roll;
+    roll.table = second;
+    for (int i = 0; i < 10; ++i) host.handle(roll);
+
+    std::vector<uint8_t> checkpoint;
+    host.saveTables(checkpoint);
+    TableHost restarted;
+    restarted.restoreTables(checkpoint.data(), checkpoint.size());
+    CHECK(restarted.tableCount() == 1);
+    protocol::Request status;
+    status.op = protocol::Op::Status;
+    status.table = first;
+    CHECK(restarted.handle(status).status == protocol::ReplyStatus::UnknownTable);
+    for (int i = 0; i < 10; ++i) {
+        protocol::Response before = host.handle(roll);
+        protocol::Response after = restarted.handle(roll);
+        REQUIRE(after.status == before.status);
+        CHECK(after.rolls == before.rolls);
+        CHECK(after.seats[0].money == before.seats[0].money);
+        CHECK(after.seats[1].position == before.seats[1].position);
+    }
+    CHECK(restarted.handle(create).table != first);  // The closed table's id is not handed out again
+    CHECK_THROWS_AS(restarted.restoreTables(checkpoint.data(), checkpoint.size() - 3), std::runtime_error);
+    CHECK(restarted.tableCount() == 2);
+}
+
+TEST_CASE("Batch runs resume from a checkpoint with identical statistics") {
+    for (SimEngine engine : {SimEngine::Lockstep, SimEngine::Scalar}) {
+        BatchConfig config;
+        config.engine = engine;
+        config.numPlayers = 3;
+        config.maxRolls = 300;
+        config.totalGames = engine == SimEngine::Lockstep ? 200 : 24;
+        config.gamesPerChunk = engine == SimEngine::Lockstep ? 48 : 5;
+
+        BatchRunner uninterrupted(config);
+        CHECK_FALSE(uninterrupted.resume());  // No checkpoint path, nothing to resume
+        REQUIRE(uninterrupted.run());
+
+        config.checkpointPath = "/tmp/monopoly_batch_test_" + std::to_string(::getpid()) + ".bin";
+        config.checkpointSeconds = 0;
+        {
+            BatchRunner killed(config);
+            CHECK_FALSE(killed.resume());
+            CHECK_FALSE(killed.run(config.totalGames / 2));  // Dies halfway through
+            CHECK(killed.getCompleted() == config.totalGames / 2);
+        }
+
+        BatchRunner resumed(config);
+        REQUIRE(resumed.resume());
+        CHECK(resumed.getCompleted() == config.totalGames / 2);
+        REQUIRE(resumed.run());
+
+        const SimStats& a = uninterrupted.getStats();
+        const SimStats& b = resumed.getStats();
+        CHECK(b.games == config.totalGames);
+        CHECK(b.games == a.games);
+        CHECK(b.finishedGames == a.finishedGames);
+        CHECK(b.totalRolls == a.totalRolls);
+        CHECK(b.wins == a.wins);
+        CHECK(b.landings == a.landings);
+        CHECK(resumed.getTileCounts().rentCollected == uninterrupted.getTileCounts().rentCollected);
+
+        // A checkpoint from another campaign is refused
+        BatchConfig other = config;
+        other.numPlayers = 2;
+        BatchRunner mismatched(other);
+        CHECK_THROWS_AS(mismatched.resume(), std::runtime_error);
+        ::unlink(config.checkpointPath.c_str());
+    }
+}
+
+TEST_CASE("Streaming accumulators merge to the single-pass result") {
+    // Moments: two halves merged match one pass over everything
+    RunningMoments all, left, right;
+    for (int i = 1; i <= 1000; ++i) {
+        all.add(i);
+        (i <= 300 ? left : right).add(i);
+    }
+    left.merge(right);
+    CHECK(left.count() == 1000);
+    CHECK(left.mean() == doctest::Approx(500.5));
+    CHECK(left.variance() == doctest::Approx(all.variance()));
+    CHECK(left.variance() == doctest::Approx(83416.6667));
+    CHECK(left.min() == 1);
+    CHECK(left.max() == 1000);
+
+    // Quantiles of 0..99999 spread over four merged sketches stay within 2% in rank
+    std::array<QuantileSketch, 4> parts;
+    for (int i = 0; i < 100000; ++i) {
+        parts[(i * 7) % 4].add((i * 7919) % 100000);
+    }
+    QuantileSketch sketch;
+    for (const auto& part : parts) sketch.merge(part);
+    CHECK(sketch.count() == 100000);
+    CHECK(sketch.retained() < 2000);
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+        CHECK(std::abs(sketch.quantile(q) - q * 100000) < 2000);
+    }
+    CHECK(sketch.quantile(0) == 0);
+    CHECK(sketch.quantile(1) == 99999);
+
+    Histogram histogram(0, 10, 5);
+    for (double v : {-1.0, 0.0, 1.9, 2.0, 9.99, 10.0}) histogram.add(v);
+    Histogram other(0, 10, 5);
+    other.add(5);
+    histogram.merge(other);
+    CHECK(histogram.bin(0) == 2);
+    CHECK(histogram.bin(1) == 1);
+    CHECK(histogram.bin(2) == 1);
+    CHECK(histogram.bin(4) == 1);
+    CHECK(histogram.getUnderflow() == 1);
+    CHECK(histogram.getOverflow() == 1);
+    CHECK(histogram.total() == 7);
+    CHECK_THROWS_AS(histogram.merge(Histogram(0, 20, 5)), std::invalid_argument);
+
+    // Game summaries from worker threads merge to the same distributions as one thread
+    GameDistributions single = collectDistributions(1, 400, 3, 500, 1);
+    GameDistributions threaded = collectDistributions(1, 400, 3, 500, 4);
+    CHECK(threaded.gameLength.count() == 400);
+    CHECK(threaded.gameLength.mean() == doctest::Approx(single.gameLength.mean()));
+    CHECK(threaded.gameLength.variance() == doctest::Approx(single.gameLength.variance()));
+    CHECK(threaded.finalMoney.count() == 1200);
+    CHECK(threaded.gameLengthHistogram.total() == 400);
+    CHECK(threaded.rentEarned[0].mean() == doctest::Approx(single.rentEarned[0].mean()));
+    CHECK(threaded.rentEarned[0].mean() > 0);
+    CHECK(threaded.gameLengthQuantiles.quantile(0.5) <= threaded.gameLength.max());
+
+    // The scalar engine reports rent per seat: it adds up to the rent recorded on the tiles
+    struct Collect : GameSink {
+        long long rent = 0;
+        void record(const GameSummary& summary) override {
+            for (int seat = 0; seat < summary.numPlayers; ++seat) rent += summary.rentEarned[seat];
+        }
+    } collect;
+    TileHeatmap heatmap;
+    runScalarGames(1, 5, 3, 300, &heatmap, &collect);
+    TileCounts counts = heatmap.snapshot();
+    long long tileRent = 0;
+    for (long long rent : counts.rentCollected) tileRent += rent;
+    CHECK(collect.rent == tileRent);
+}
+
+TEST_CASE("Columnar result files from threaded batch runs") {
+    BatchConfig config;
+    config.numPlayers = 3;
+    config.maxRolls = 400;
+    config.totalGames = 3000;
+    config.gamesPerChunk = 1000;
+    config.threads = 3;
+    BatchRunner runner(config);
+
+    std::string path = "/tmp/monopoly_results_test_" + std::to_string(::getpid()) + ".bin";
+    {
+        ResultWriter writer(path, 256);
+        std::vector<std::unique_ptr<ResultBuffer>> buffers;
+        std::vector<GameSink*> sinks;
+        for (int w = 0; w < config.threads; ++w) {
+            buffers.push_back(writer.buffer());
+            sinks.push_back(buffers.back().get());
+        }
+        CHECK_THROWS_AS(runner.setSinks({sinks[0]}), std::invalid_argument);
+        runner.setSinks(sinks);
+        REQUIRE(runner.run());
+        buffers.clear();  // Flushes the short last groups
+        writer.close();
+        CHECK(writer.getRowCount() == 3000);
+    }
+
+    ResultReader reader(path);
+    const SimStats& stats = runner.getStats();
+    REQUIRE(reader.getRowCount() == 3000);
+    CHECK(reader.columnCount() == static_cast<int>(resultStore::columns().size()));
+    CHECK(reader.column("no_such_column") == -1);
+    int seed = reader.column("seed");
+    int winner = reader.column("winner");
+    int rolls = reader.column("rolls");
+    REQUIRE(seed >= 0);
+
+    std::vector<uint64_t> all = reader.select({});
+    CHECK(all.size() == 3000);
+    CHECK(reader.sum(rolls, all) == stats.totalRolls);
+    std::vector<int64_t> seeds = reader.gather(seed, all);
+    std::sort(seeds.begin(), seeds.end());
+    CHECK(seeds.front() == 1);
+    CHECK(seeds.back() == 3000);
+    CHECK(std::adjacent_find(seeds.begin(), seeds.end()) == seeds.end());
+
+    // Predicates agree with the aggregate statistics
+    CHECK(static_cast<long long>(reader.select({{winner, 0, 0}}).size()) == stats.wins[0]);
+    CHECK(static_cast<long long>(reader.select({{winner, -1, -1}}).size()) == stats.games - stats.finishedGames);
+    std::vector<uint64_t> longWins = reader.select({{winner, 0, 2}, {rolls, 200, 400}});
+    for (int64_t value : reader.gather(rolls, longWins)) {
+        CHECK(value >= 200);
+    }
+
+    // A narrow seed range reads only the groups that can hold it
+    std::vector<uint64_t> early = reader.select({{seed, 1, 100}});
+    CHECK(early.size() == 100);
+    CHECK(reader.getGroupsSkipped() > 0);
+
+    // An empty range selects nothing, even in groups its bounds overlap
+    CHECK(reader.select({{seed, 100, 1}}).empty());
+    CHECK(reader.select({{winner, 0, 2}, {rolls, 400, 200}}).empty());
+
+    // Rent on tiles adds up to rent earned by seats
+    long long tileIncome = 0;
+    long long seatIncome = 0;
+    for (int t = 0; t < kBoardTiles; ++t) tileIncome += reader.sum(reader.column("tile_income_" + std::to_string(t)), all);
+    for (int s = 0; s < 3; ++s) seatIncome += reader.sum(reader.column("rent_earned_" + std::to_string(s)), all);
+    CHECK(tileIncome == seatIncome);
+    CHECK(tileIncome > 0);
+    ::unlink(path.c_str());
+
+    CHECK_THROWS_AS(ResultReader("/tmp/monopoly_no_such_results.bin"), std::runtime_error);
+}
+
+TEST_CASE("Result parts are sealed at every checkpoint, so a killed run loses no counted game") {
+    BatchConfig config;
+    config.numPlayers = 2;
+    config.maxRolls = 300;
+    config.totalGames = 400;
+    config.gamesPerChunk = 100;
+    config.checkpointPath = "/tmp/monopoly_resume_results_" + std::to_string(::getpid()) + ".ckpt";
+    config.checkpointSeconds = 0;
+    std::string path = "/tmp/monopoly_resume_results_" + std::to_string(::getpid()) + ".bin";
+    CHECK(resultStore::partPath(path, 0) == path);
+    CHECK(resultStore::partPath(path, 200) == path + ".part200");
+
+    // Each run, as monopoly_batch does it: resume, then write the games it plays
+    auto playRun = [&](long long maxGames, bool killed) {
+        BatchRunner runner(config);
+        runner.resume();
+        ResultWriter writer(resultStore::partPath(path, runner.getCompleted()), 64, config.numPlayers);
+        ResultParts parts(writer, path);
+        auto buffer = writer.buffer();
+        runner.setSinks({buffer.get()});
+        runner.setCheckpointObserver(&parts);
+        bool done = runner.run(maxGames);
+        if (killed) {
+            // Games after the last checkpoint reach the file, then the process dies before close()
+            GameSummary lost;
+            lost.seed = 100000;
+            for (int i = 0; i < 10; ++i) buffer->record(lost);
+            buffer->flush();
+            return done;
+        }
+        buffer.reset();
+        writer.close();
+        return done;
+    };
+    CHECK_FALSE(playRun(250, true));
+    CHECK(playRun(1000, false));
+
+    // A part per checkpoint, holding every game exactly once
+    std::vector<std::string> parts = {path, path + ".part100", path + ".part200", path + ".part250", path + ".part350"};
+    std::vector<int64_t> seeds;
+    for (const std::string& part : parts) {
+        ResultReader reader(part);
+        std::vector<int64_t> partSeeds = reader.gather(reader.column("seed"), reader.select({}));
+        seeds.insert(seeds.end(), partSeeds.begin(), partSeeds.end());
+        ::unlink(part.c_str());
+    }
+    CHECK(::access((path + ".part400").c_str(), F_OK) != 0);  // Sealing at the end leaves no empty part
+    std::sort(seeds.begin(), seeds.end());
+    CHECK(seeds.size() == 400);
+    CHECK(seeds.front() == 1);
+    CHECK(seeds.back() == 400);
+    CHECK(std::adjacent_find(seeds.begin(), seeds.end()) == seeds.end());
+    ::unlink(config.checkpointPath.c_str());
+}
+
+TEST_CASE("House-rule sweeps pair every configuration with the baseline games") {
+    HouseRules standard;
+    SweepAxis go = ruleSweep::parseAxis("go=100:200:400");
+    SweepAxis rent = ruleSweep::parseAxis("rent=50:150");
+    CHECK(go.parameter == RuleParameter::GoSalary);
+    CHECK(go.levels == std::vector<int32_t>{100, 200, 400});
+    CHECK_THROWS_AS(ruleSweep::parseAxis("bail=10"), std::invalid_argument);
+    CHECK_THROWS_AS(ruleSweep::parseAxis("jail=10:x"), std::invalid_argument);
+
+    std::vector<HouseRules> grid = ruleSweep::gridDesign(standard, {go, rent});
+    CHECK(grid.size() == 6);
+    CHECK(grid[5].goSalary == 400);
+    CHECK(grid[5].rentPercent == 150);
+    CHECK(grid[5].jailFee == standard.jailFee);
+
+    // A Latin hypercube uses every level equally often
+    std::vector<HouseRules> random = ruleSweep::randomDesign(standard, {go}, 9, 7);
+    for (int32_t level : go.levels) {
+        CHECK(std::count_if(random.begin(), random.end(), [&](const HouseRules& r) { return r.goSalary == level; }) == 3);
+    }
+
+    // The standard rules match the engine's defaults
+    auto board = Board::create();
+    LockstepSimulator plain(*board, 2, 300);
+    SweepConfig config;
+    config.games = 400;
+    config.maxRolls = 300;
+    config.threads = 3;
+    SweepResult reference;
+    HouseRules richer = standard;
+    richer.goSalary = 400;
+    std::vector<SweepResult> results = ruleSweep::run(standard, {standard, richer}, config, &reference);
+    SimStats expected = plain.run(config.firstSeed, 400);
+    CHECK(reference.stats.totalRolls == expected.totalRolls);
+    CHECK(reference.stats.wins == expected.wins);
+
+    // The baseline paired with itself differs nowhere
+    REQUIRE(results.size() == 2);
+    CHECK(results[0].rollDifference.mean() == 0.0);
+    CHECK(results[0].rollDifference.stddev() == 0.0);
+    CHECK(results[0].winnerChanged == 0);
+    CHECK(results[0].effectSize == 0.0);
+
+    // A bigger Go salary keeps players solvent for longer
+    CHECK(results[1].rollDifference.mean() > 0.0);
+    CHECK(results[1].effectSize > 0.0);
+    CHECK(results[1].rollDifferenceError() > 0.0);
+
+    // Thread count does not change the results
+    config.threads = 1;
+    std::vector<SweepResult> single = ruleSweep::run(standard, {richer}, config);
+    CHECK(single[0].stats.totalRolls == results[1].stats.totalRolls);
+    CHECK(single[0].winnerChanged == results[1].winnerChanged);
+    CHECK(single[0].rollDifference.mean() == doctest::Approx(results[1].rollDifference.mean()));
+
+    // Game counts the baseline cannot pair by seed are refused before anything is allocated
+    config.games = ruleSweep::kMaxGames + 1;
+    CHECK_THROWS_AS(ruleSweep::run(standard, {richer}, config), std::invalid_argument);
+    config.games = -1;
+    CHECK_THROWS_AS(ruleSweep::run(standard, {richer}, config), std::invalid_argument);
+}
+
+TEST_CASE("Auctions for declined properties") {
+    Player rich("Rich", 1000);
+    Player thrifty("Thrifty", 1000);
+    Player broke("Broke", 25);
+    ListPriceBidder list;
+    FractionBidder half(50);
+    PassBidder pass;
+    std::string name = "Boardwalk";
+    AuctionLot lot{name, 400};
+
+    SUBCASE("Sealed bids: highest wins at the runner-up's bid plus one increment") {
+        AuctionEntrant entrants[] = {{&broke, &list}, {&thrifty, &half}, {&rich, &list}};
+        AuctionResult result = auction::sealed(entrants, 3, lot);
+        CHECK(result.winner == 2);
+        CHECK(result.price == 200 + kAuctionIncrement);
+
+        // Open bidding between the same strategies ends within one increment of the sealed price
+        AuctionResult open = auction::ascending(entrants, 3, lot);
+        CHECK(open.winner == 2);
+        CHECK(open.price >= 200);
+        CHECK(open.price <= 200 + kAuctionIncrement);
+    }
+
+    SUBCASE("A lone bidder pays the opening bid, ties go to the earlier entrant") {
+        AuctionEntrant lone[] = {{&broke, &pass}, {&thrifty, &half}};
+        AuctionResult result = auction::sealed(lone, 2, lot);
+        CHECK(result.winner == 1);
+        CHECK(result.price == kAuctionIncrement);
+        CHECK(auction::ascending(lone, 2, lot).price == kAuctionIncrement);
+
+        AuctionEntrant tied[] = {{&thrifty, &list}, {&rich, &list}};
+        result = auction::sealed(tied, 2, lot);
+        CHECK(result.winner == 0);
+        CHECK(result.price == 400);
+    }
+
+    SUBCASE("Bids are capped by cash and nobody bidding leaves the lot unsold") {
+        AuctionEntrant entrants[] = {{&broke, &list}, {&rich, &pass}};
+        AuctionResult result = auction::sealed(entrants, 2, lot);
+        CHECK(result.winner == 0);
+        CHECK(result.price == kAuctionIncrement);
+
+        AuctionEntrant nobody[] = {{&broke, &pass}, {&rich, &pass}};
+        CHECK(auction::sealed(nobody, 2, lot).winner == -1);
+        CHECK(auction::ascending(nobody, 2, lot).winner == -1);
+    }
+
+    SUBCASE("A reserve price is the opening bid, and bids below it do not count") {
+        AuctionLot reserved{name, 400, 250};
+        AuctionEntrant lone[] = {{&broke, &list}, {&rich, &list}, {&thrifty, &half}};
+        AuctionResult result = auction::sealed(lone + 1, 2, reserved);  // Thrifty's $200 is below the reserve
+        CHECK(result.winner == 0);
+        CHECK(result.price == 250);
+        CHECK(auction::ascending(lone + 1, 2, reserved).price == 250);
+        CHECK(auction::sealed(lone, 1, reserved).winner == -1);  // Broke can't reach it
+        CHECK(auction::ascending(lone, 1, reserved).winner == -1);
+    }
+
+    SUBCASE("Games auction the streets a player cannot afford") {
+        auto bob = std::make_shared<Player>("Bob", 40);
+        auto alice = std::make_shared<Player>("Alice", 1500);
+        Game game({bob, alice}, Board::create());
+        bob->setPosition(1);  // Mediterranean Avenue, $60
+
+        game.getTile(1)->onLand(bob, game);
+        CHECK(game.getTile(1)->getOwner() == nullptr);  // Auctions are off by default
+
+        game.setAuctionMode(AuctionMode::Sealed);
+        game.getTile(1)->onLand(bob, game);
+        CHECK(game.getTile(1)->getOwner() == alice);
+        CHECK(alice->getMoney() == 1500 - 50);
+        CHECK(bob->getMoney() == 40);
+        CHECK(game.getTileCounts().purchases[1] == 1);
+
+        // Open bidding against a person at the console
+        std::istringstream answers("y\ny\n");
+        std::ostringstream prompts;
+        ConsoleBidder console(answers, prompts);
+        game.setBidder(1, &console);
+        game.setAuctionMode(AuctionMode::Ascending);
+        bob->setPosition(3);  // Baltic Avenue, $60
+        game.getTile(3)->onLand(bob, game);
+        CHECK(game.getTile(3)->getOwner() == alice);
+        CHECK(alice->getMoney() == 1500 - 50 - 40);
+        CHECK(prompts.str().find("bid $40 for Baltic") != std::string::npos);
+    }
+
+    SUBCASE("The lockstep engine auctions under the house rules") {
+        auto board = Board::create();
+        HouseRules rules;
+        rules.auctions = 1;
+        LockstepSimulator plain(*board, 2, 2000);
+        LockstepSimulator auctioned(*board, 2, 2000, rules);
+        SimStats without = plain.run(1, 200);
+        SimStats with = auctioned.run(1, 200);
+        CHECK(with.games == 200);
+        CHECK(with.totalRolls < without.totalRolls);  // Properties find owners sooner, so rent bites sooner
+        CHECK(ruleSweep::parseAxis("auction=0:1").parameter == RuleParameter::Auctions);
+    }
+}
+
+TEST_CASE("Trades between players") {
+    auto alice = std::make_shared<Player>("Alice", 1000);
+    auto bob = std::make_shared<Player>("Bob", 1000);
+    Game game({alice, bob}, Board::create());
+    auto mediterranean = game.getTile(1);
+    auto baltic = std::dynamic_pointer_cast<StreetTile>(game.getTile(3));
+    auto electric = game.getTile(12);
+    auto water = game.getTile(28);
+    alice->buyProperty(mediterranean);
+    alice->buyProperty(electric);
+    bob->buyProperty(baltic);
+    bob->buyProperty(water);
+
+    SUBCASE("Offers are validated before anything moves") {
+        TradeOffer offer;
+        offer.fromSeat = 0;
+        offer.toSeat = 1;
+        CHECK(trade::validate(game, offer) == TradeError::Empty);
+        offer.giveTiles = 1ULL << 1;
+        offer.takeTiles = 1ULL << 5;  // Reading Railroad, still the bank's
+        CHECK(trade::apply(game, offer) == TradeError::NotOwned);
+        offer.takeTiles = 1ULL << 3;
+        offer.giveCash = 5000;
+        CHECK(trade::apply(game, offer) == TradeError::NotEnoughCash);
+        offer.giveCash = 0;
+        offer.takeJailCard = true;
+        CHECK(trade::apply(game, offer) == TradeError::NoJailCard);
+        offer.takeJailCard = false;
+        offer.toSeat = 0;
+        CHECK(trade::apply(game, offer) == TradeError::BadSeat);
+        offer.toSeat = 1;
+        baltic->restoreBuildings(1, false);
+        CHECK(trade::apply(game, offer) == TradeError::HasBuildings);
+        baltic->restoreBuildings(0, false);
+
+        // An empty street of a colour group with a house elsewhere stays put too
+        offer.giveTiles = 1ULL << 12;
+        std::static_pointer_cast<StreetTile>(mediterranean)->restoreBuildings(1, false);
+        CHECK(trade::apply(game, offer) == TradeError::HasBuildings);
+        LandingModel model(game.getBoard(), game.getChanceDeck(), game.getCommunityChestDeck());
+        TradeEvaluator evaluator(model);
+        evaluator.load(game);
+        CHECK((evaluator.bestOffer(0, 1, 50).takeTiles & (1ULL << 3)) == 0);  // Trade search leaves Baltic out too
+        CHECK((evaluator.bestOffer(1, 0, 50).giveTiles & (1ULL << 3)) == 0);
+        std::static_pointer_cast<StreetTile>(mediterranean)->restoreBuildings(0, false);
+        offer.giveTiles = 1ULL << 1;
+
+        // None of the failed offers changed anything
+        CHECK(mediterranean->getOwner() == alice);
+        CHECK(baltic->getOwner() == bob);
+        CHECK(alice->getMoney() == 1000 - 60 - 150);
+        CHECK(alice->getProperties().size() == 2);
+    }
+
+    SUBCASE("A valid offer moves properties, cash and cards together") {
+        bob->receiveGetOutOfJailCard();
+        TradeOffer offer;
+        offer.fromSeat = 0;
+        offer.toSeat = 1;
+        offer.giveTiles = (1ULL << 1) | (1ULL << 12);
+        offer.takeTiles = 1ULL << 3;
+        offer.takeCash = 100;
+        offer.takeJailCard = true;
+        REQUIRE(trade::apply(game, offer) == TradeError::None);
+        CHECK(mediterranean->getOwner() == bob);
+        CHECK(electric->getOwner() == bob);
+        CHECK(baltic->getOwner() == alice);
+        CHECK(alice->getProperties().size() == 1);
+        CHECK(bob->getProperties().size() == 3);
+        CHECK(alice->getNumberOfUtilities() == 0);
+        CHECK(bob->getNumberOfUtilities() == 2);
+        CHECK(alice->getMoney() == 1000 - 60 - 150 + 100);
+        CHECK(bob->getMoney() == 1000 - 60 - 150 - 100);
+        CHECK(alice->hasGetOutOfJailFreeCard());
+        CHECK_FALSE(bob->hasGetOutOfJailFreeCard());
+        CHECK(alice->getPropertyValue() == 60);
+    }
+
+    SUBCASE("Jail cards can be swapped") {
+        alice->receiveGetOutOfJailCard(DeckKind::Chance);
+        bob->receiveGetOutOfJailCard(DeckKind::CommunityChest);
+        TradeOffer offer;
+        offer.fromSeat = 0;
+        offer.toSeat = 1;
+        offer.giveJailCard = true;
+        offer.takeJailCard = true;
+        REQUIRE(trade::apply(game, offer) == TradeError::None);
+        CHECK(alice->getOutOfJailCardCount() == 1);
+        CHECK(alice->getOutOfJailCardCount(DeckKind::CommunityChest) == 1);
+        CHECK(bob->getOutOfJailCardCount() == 1);
+        CHECK(bob->getOutOfJailCardCount(DeckKind::Chance) == 1);
+    }
+
+    SUBCASE("Landing probabilities and trade scores") {
+        LandingModel model(game.getBoard(), game.getChanceDeck(), game.getCommunityChestDeck());
+        double total = 0.0;
+        for (int t = 0; t < kBoardTiles; ++t) {
+            total += model.probability(t);
+        }
+        CHECK(total == doctest::Approx(1.0));
+        CHECK(model.probability(30) == doctest::Approx(0.0));      // Go To Jail sends the token on
+        CHECK(model.probability(10) > 2.0 / kBoardTiles);         // ... to the Jail tile
+        CHECK(model.probability(7) < model.probability(6));       // Chance moves some tokens away
+
+        TradeEvaluator evaluator(model);
+        evaluator.load(game);
+        CHECK(evaluator.seatIncome(0) > 0.0);
+
+        // Both utilities together charge 10x instead of 4x, so Alice wants Water Works
+        TradeOffer offer = evaluator.bestOffer(0, 1, 50);
+        REQUIRE_FALSE(offer.isEmpty());
+        CHECK(offer.takeTiles == 1ULL << 28);
+        TradeScore score = evaluator.score(offer);
+        CHECK(score.incomeChange[0] > 0.0);
+        CHECK(score.net(0, 50) > 0.0);
+        CHECK(score.net(1, 50) >= 0.0);  // Bob is paid enough to come out even
+        CHECK(trade::apply(game, offer) == TradeError::None);
+        CHECK(alice->getNumberOfUtilities() == 2);
+    }
+}
+
+TEST_CASE("Mortgages and raising cash") {
+    QuietOutput quiet;
+    auto alice = std::make_shared<Player>("Alice", 1000);
+    auto bob = std::make_shared<Player>("Bob", 1000);
+    Game game({alice, bob}, Board::create());
+    auto mediterranean = game.getTile(1);
+    auto baltic = std::dynamic_pointer_cast<StreetTile>(game.getTile(3));
+    auto reading = game.getTile(5);
+    alice->buyProperty(mediterranean);
+    alice->buyProperty(baltic);
+    alice->buyProperty(reading);
+    CHECK(alice->getMoney() == 680);
+    CHECK(alice->getLiquidAssets() == 680 + 30 + 30 + 100);
+
+    SUBCASE("A mortgage pays half the price and stops the rent") {
+        REQUIRE(alice->mortgage(reading));
+        CHECK(reading->isMortgaged());
+        CHECK(alice->getMoney() == 780);
+        CHECK(alice->getLiquidAssets() == 840);
+        CHECK_FALSE(alice->mortgage(reading));
+        CHECK_FALSE(bob->mortgage(mediterranean));
+
+        reading->onLand(bob, game);
+        CHECK(bob->getMoney() == 1000);
+
+        REQUIRE(alice->unmortgage(reading));
+        CHECK_FALSE(reading->isMortgaged());
+        CHECK(alice->getMoney() == 780 - 110);
+        CHECK(alice->getLiquidAssets() == 670 + 160);
+        reading->onLand(bob, game);
+        CHECK(bob->getMoney() < 1000);
+    }
+
+    SUBCASE("No houses go up on a group with a mortgaged street") {
+        auto brown = game.getBoard().getColorGroupProperties("Brown");
+        REQUIRE(alice->mortgage(baltic));
+        CHECK_FALSE(static_cast<StreetTile&>(*mediterranean).buildHouse(brown));
+        REQUIRE(alice->unmortgage(baltic));
+        CHECK(static_cast<StreetTile&>(*mediterranean).buildHouse(brown));
+        CHECK_FALSE(alice->mortgage(mediterranean));  // The house has to be sold first
+    }
+
+    SUBCASE("Buildings are sold before anything is mortgaged") {
+        baltic->restoreBuildings(2, false);
+        alice->recordBuildings(2, 0, 2 * baltic->houseCost());
+        CHECK(alice->getLiquidAssets() == 680 + 160 + 60);
+
+        REQUIRE(alice->raiseCash(alice->getMoney() + 50));
+        CHECK(baltic->getHouseCount() == 0);
+        CHECK(alice->getMoney() == 740);
+        CHECK_FALSE(reading->isMortgaged());
+
+        // Mediterranean and Baltic together give up less rent than Reading Railroad alone
+        REQUIRE(alice->raiseCash(800));
+        CHECK(mediterranean->isMortgaged());
+        CHECK(baltic->isMortgaged());
+        CHECK_FALSE(reading->isMortgaged());
+        CHECK(alice->getMoney() == 800);
+
+        CHECK_FALSE(alice->raiseCash(2000));
+        CHECK_FALSE(reading->isMortgaged());
+        CHECK(alice->getMoney() == 800);
+    }
+
+    SUBCASE("Cheapest mortgages cover the need") {
+        const int values[] = {30, 30, 100};
+        const int rents[] = {2, 4, 25};
+        CHECK(cheapestMortgages(values, rents, 3, 50) == 0b011u);
+        CHECK(cheapestMortgages(values, rents, 3, 61) == 0b100u);
+        CHECK(cheapestMortgages(values, rents, 3, 130) == 0b101u);
+        CHECK(cheapestMortgages(values, rents, 3, 161) == 0u);
+        CHECK(cheapestMortgages(values, rents, 3, 0) == 0u);
+    }
+
+    SUBCASE("Rent is raised from property before bankruptcy") {
+        alice->adjustMoney(10 - alice->getMoney());
+        CHECK(alice->payRent(*bob, 50));
+        CHECK(alice->getMoney() == 20);
+        CHECK(bob->getMoney() == 1050);
+        CHECK(mediterranean->isMortgaged());
+        CHECK(baltic->isMortgaged());
+        CHECK_FALSE(alice->isBankrupt());
+
+        CHECK_FALSE(alice->payRent(*bob, 500));
+        CHECK(reading->getOwner() == bob);
+        CHECK(mediterranean->isMortgaged());  // Mortgages pass to the creditor
+    }
+
+    SUBCASE("Mortgages travel with a saved game") {
+        REQUIRE(alice->mortgage(reading));
+        std::vector<uint8_t> saved;
+        gameSave::save(game, saved);
+        auto loaded = gameSave::load(saved.data(), saved.size());
+        REQUIRE(loaded);
+        CHECK(loaded->getTile(5)->isMortgaged());
+        CHECK_FALSE(loaded->getTile(1)->isMortgaged());
+        CHECK(GameState::capture(*loaded) == GameState::capture(game));
+        CHECK(loaded->getSeats()[0]->getLiquidAssets() == alice->getLiquidAssets());
+
+        // Version 1 saves still load
+        REQUIRE(alice->unmortgage(reading));
+        gameSave::save(game, saved);
+        saved[4] = 1;
+        CHECK(gameSave::load(saved.data(), saved.size()));
+    }
+
+    SUBCASE("The lockstep engine mortgages under the house rules") {
+        auto board = Board::create();
+        HouseRules rules;
+        rules.mortgages = 1;
+        LockstepSimulator without(*board, 2, 1000);
+        LockstepSimulator with(*board, 2, 1000, rules);
+        SimStats plain = without.run(1, 128);
+        SimStats mortgaged = with.run(1, 128);
+        CHECK(mortgaged.games == 128);
+        CHECK(mortgaged.finishedGames < plain.finishedGames);  // Rent is raised instead of ending the game
+        CHECK(mortgaged.totalRolls > plain.totalRolls);
+    }
+}
+
+TEST_CASE("The bank's houses and hotels run out") {
+    QuietOutput quiet;
+    auto alice = std::make_shared<Player>("Alice", 100000);
+    auto bob = std::make_shared<Player>("Bob", 100000);
+    Game game({alice, bob}, Board::create());
+    Board& board = game.getBoard();
+    BankInventory& bank = board.getBank();
+    CHECK(bank.housesLeft() == BankInventory::kHouses);
+    CHECK(bank.hotelsLeft() == BankInventory::kHotels);
+
+    const std::string aliceGroups[] = {"Orange", "Red", "Yellow"};
+    for (const std::string& color : aliceGroups) {
+        for (StreetTile* street : board.getColorGroupProperties(color)) {
+            alice->buyProperty(board.findPropertyByName(street->getName()));
+        }
+    }
+    for (StreetTile* street : board.getColorGroupProperties("Brown")) {
+        bob->buyProperty(board.findPropertyByName(street->getName()));
+    }
+    auto orange = board.getColorGroupProperties("Orange");
+
+    SUBCASE("Building and selling stay even across the group") {
+        int money = alice->getMoney();
+        REQUIRE(game.buildHouse(*orange[0]));
+        CHECK(alice->getMoney() == money - 180);
+        CHECK_FALSE(game.buildHouse(*orange[0]));   // The rest of the group is behind
+        CHECK_FALSE(game.buildHouse(*board.getColorGroupProperties("Green")[0]));  // Not Alice's group
+        REQUIRE(game.buildHouse(*orange[1]));
+        CHECK(orange[2]->sellBuilding(orange) == 0);  // Nothing to sell
+        REQUIRE(game.buildHouse(*orange[2]));
+        REQUIRE(game.buildHouse(*orange[0]));
+        CHECK(orange[1]->sellBuilding(orange) == 0);  // St. James Place has more, so it sells first
+        CHECK(orange[0]->sellBuilding(orange) == 90);
+        CHECK(bank.housesLeft() == BankInventory::kHouses - 3);
+    }
+
+    SUBCASE("Builds stop when the houses run out, and hotels hand theirs back") {
+        const std::string colors[] = {"Orange", "Red", "Yellow"};
+        int built = 0;
+        for (int round = 0; round < 4; ++round) {
+            for (const std::string& color : colors) {
+                for (StreetTile* street : board.getColorGroupProperties(color)) {
+                    built += game.buildHouse(*street) ? 1 : 0;
+                }
+            }
+        }
+        CHECK(built == BankInventory::kHouses);
+        CHECK(bank.housesLeft() == 0);
+        CHECK(alice->getHouseCount() == BankInventory::kHouses);
+
+        // Orange got its four houses each in the first rounds; a hotel returns four to the bank
+        REQUIRE(game.buildHotel(*orange[0]));
+        CHECK(bank.housesLeft() == 4);
+        CHECK(bank.hotelsLeft() == BankInventory::kHotels - 1);
+
+        // Breaking a hotel back down takes four houses; with two left it turns into two
+        bank.reset(2, bank.hotelsLeft());
+        int raised = orange[0]->sellBuilding(orange);
+        CHECK(raised == (orange[0]->hotelCost() - 2 * orange[0]->houseCost()) / 2);
+        CHECK(orange[0]->getHouseCount() == 2);
+        CHECK(bank.housesLeft() == 0);
+        CHECK(bank.hotelsLeft() == BankInventory::kHotels);
+    }
+
+    SUBCASE("The last houses go to auction when more players want them") {
+        bank.reset(1, BankInventory::kHotels);
+        auto brown = board.getColorGroupProperties("Brown");
+        PassBidder pass;
+        game.setBidder(0, &pass);
+        int aliceMoney = alice->getMoney();
+        int bobMoney = bob->getMoney();
+        CHECK(game.buildHouse(*orange[0]) == brown[0]);  // Bob outbid Alice and built on his own street
+        CHECK(orange[0]->getHouseCount() == 0);
+        CHECK(brown[0]->getHouseCount() == 1);
+        CHECK(alice->getMoney() == aliceMoney);
+        CHECK(bob->getMoney() == bobMoney - orange[0]->houseCost());  // Alone, at the reserve: never below cost
+        CHECK(bank.housesLeft() == 0);
+        CHECK_FALSE(game.buildHouse(*orange[0]));
+    }
+
+    SUBCASE("So do the last hotels") {
+        auto brown = board.getColorGroupProperties("Brown");
+        for (int round = 0; round < 4; ++round) {
+            for (StreetTile* street : orange) REQUIRE(game.buildHouse(*street) == street);
+            for (StreetTile* street : brown) REQUIRE(game.buildHouse(*street) == street);
+        }
+        bank.reset(bank.housesLeft(), 1);
+        PassBidder pass;
+        game.setBidder(0, &pass);
+        int aliceMoney = alice->getMoney();
+        int bobMoney = bob->getMoney();
+        CHECK(game.buildHotel(*orange[0]) == brown[0]);
+        CHECK_FALSE(orange[0]->isHotelBuilt());
+        CHECK(brown[0]->isHotelBuilt());
+        CHECK(alice->getMoney() == aliceMoney);
+        CHECK(bob->getMoney() == bobMoney - (brown[0]->hotelCost() - 4 * brown[0]->houseCost()));  // At the reserve
+        CHECK(bank.hotelsLeft() == 0);
+        CHECK_FALSE(game.buildHotel(*orange[1]));
+    }
+
+    SUBCASE("Threads never take the stock below zero") {
+        BankInventory shared;
+        std::atomic<int> taken{0};
+        std::vector<std::thread> workers;
+        for (int w = 0; w < 4; ++w) {
+            workers.emplace_back([&] {
+                for (int i = 0; i < 20; ++i) {
+                    if (shared.takeHouses(1)) taken++;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        CHECK(taken == BankInventory::kHouses);
+        CHECK(shared.housesLeft() == 0);
+        CHECK(shared.takeHousesUpTo(4) == 0);
+    }
+}
+
+TEST_CASE("Bankruptcy settles with the creditor or the bank") {
+    QuietOutput quiet;
+    auto alice = std::make_shared<Player>("Alice", 100000);
+    auto bob = std::make_shared<Player>("Bob", 1500);
+    auto carol = std::make_shared<Player>("Carol", 1500);
+    Game game({alice, bob, carol}, Board::create());
+    Board& board = game.getBoard();
+
+    SUBCASE("Owing the bank returns properties unmortgaged and buildings to its stock") {
+        for (StreetTile* street : board.getColorGroupProperties("Orange")) {
+            alice->buyProperty(board.findPropertyByName(street->getName()));
+        }
+        for (StreetTile* street : board.getColorGroupProperties("Orange")) {
+            REQUIRE(game.buildHouse(*street));
+        }
+        auto reading = board.getTile(5);
+        alice->buyProperty(reading);
+        REQUIRE(alice->mortgage(reading));
+        CHECK(board.getBank().housesLeft() == BankInventory::kHouses - 3);
+
+        alice->adjustMoney(-alice->getMoney());
+        alice->setRaisesCash(false);
+        CHECK_FALSE(alice->payTax(100));
+        CHECK(alice->isBankrupt());
+        CHECK(alice->getProperties().empty());
+        CHECK(alice->getHouseCount() == 0);
+        CHECK(board.getBank().housesLeft() == BankInventory::kHouses);
+        CHECK(reading->getOwner() == nullptr);
+        CHECK_FALSE(reading->isMortgaged());
+        for (StreetTile* street : board.getColorGroupProperties("Orange")) {
+            CHECK(street->getOwner() == nullptr);
+            CHECK(street->getHouseCount() == 0);
+        }
+    }
+
+    SUBCASE("The creditor takes the cash that is left") {
+        alice->adjustMoney(30 - alice->getMoney());
+        alice->setRaisesCash(false);
+        CHECK_FALSE(alice->payRent(*bob, 50));
+        CHECK(bob->getMoney() == 1530);
+        CHECK(alice->getMoney() == 0);
+        CHECK(alice->isBankrupt());
+    }
+
+    SUBCASE("Jail cards go to the creditor, or back to their decks") {
+        auto drawJailCard = [&](CardDeck& deck) {
+            while (true) {
+                const CardSpec* card = deck.draw(game.getRandom());
+                if (card->isKeepable()) return card;
+            }
+        };
+        alice->handleChanceCard(*drawJailCard(game.getChanceDeck()), game);
+        carol->handleCommunityChestCard(*drawJailCard(game.getCommunityChestDeck()), game);
+        alice->adjustMoney(-alice->getMoney());
+        alice->setRaisesCash(false);
+        carol->adjustMoney(-carol->getMoney());
+        carol->setRaisesCash(false);
+
+        CHECK_FALSE(alice->payRent(*bob, 50));
+        CHECK_FALSE(alice->hasGetOutOfJailFreeCard());
+        CHECK(bob->getOutOfJailCardCount(DeckKind::Chance) == 1);
+        CHECK_FALSE(carol->payTax(100));
+        game.checkBankruptcy();
+        CHECK(game.getPlayers().size() == 1);
+        CHECK_FALSE(carol->hasGetOutOfJailFreeCard());
+        CHECK(game.getChanceDeck().heldCount() == 1);  // Bob's now
+        CHECK(game.getCommunityChestDeck().heldCount() == 0);
+    }
+
+    SUBCASE("Going bankrupt on doubles ends the turn without skipping the next seat") {
+        alice->buyProperty(board.getTile(1));  // Mediterranean Avenue mortgages for $30
+        alice->adjustMoney(50 - alice->getMoney());
+        game.setDice(std::make_shared<MockDice>(2, 2));  // Income Tax, $100
+        game.playTurn();
+        CHECK(alice->isBankrupt());
+        CHECK(board.getTile(1)->getOwner() == nullptr);
+        CHECK(game.getPlayers().size() == 2);
+        CHECK(game.getCurrentPlayer() == bob);
+        CHECK(game.getDoubleCount() == 0);
+
+        game.setDice(std::make_shared<MockDice>(1, 2));
+        game.playTurn();
+        CHECK(game.getCurrentPlayer() == carol);
+        game.setDice(std::make_shared<MockDice>(1, 2));
+        game.playTurn();
+        CHECK(game.getCurrentPlayer() == bob);  // Alice's seat is out of the ring
+    }
+
+    SUBCASE("Long games leave no bankrupt player in the turn order") {
+        for (uint32_t seed = 1; seed <= 10; ++seed) {
+            std::vector<std::shared_ptr<Player>> seats;
+            for (int i = 0; i < 4; ++i) seats.push_back(std::make_shared<Player>("Player " + std::to_string(i + 1), 500));
+            Game longGame(seats, Board::create());
+            longGame.seed(seed);
+            while (longGame.getPlayers().size() > 1 && longGame.getRollCount() < 3000) {
+                longGame.playTurn();
+                for (const auto& player : longGame.getPlayers()) CHECK_FALSE(player->isBankrupt());
+                CHECK_FALSE(longGame.getCurrentPlayer()->isBankrupt());
+            }
+        }
+    }
+}
+
+TEST_CASE("Jail is a phase of the turn") {
+    QuietOutput quiet;
+    auto alice = std::make_shared<Player>("Alice", 1500);
+    auto bob = std::make_shared<Player>("Bob", 1500);
+    Game game({alice, bob}, Board::create());
+    alice->goToJail();
+
+    SUBCASE("The shared table") {
+        CHECK_FALSE(jail::step(JailAction::Roll, 0, false).leaves);
+        CHECK(jail::step(JailAction::Roll, 1, true).moves);
+        CHECK_FALSE(jail::step(JailAction::Roll, 1, true).rollsAgain);
+        CHECK(jail::step(JailAction::Roll, kJailAttempts - 1, false).paysFee);
+        CHECK(jail::step(JailAction::Pay, 0, true).rollsAgain);
+        CHECK(jail::step(JailAction::UseCard, 0, false).usesCard);
+    }
+
+    SUBCASE("Misses stay put, and the third one pays and moves") {
+        for (int miss = 1; miss < kJailAttempts; ++miss) {
+            game.setDice(std::make_shared<MockDice>(1, 2));
+            game.playTurn();
+            CHECK(alice->isInJail());
+            CHECK(alice->getPosition() == 10);
+            CHECK(alice->getJailTurns() == miss);
+            CHECK(game.getCurrentPlayer() == bob);
+            game.setDice(std::make_shared<MockDice>(1, 3));
+            game.playTurn();
+        }
+        game.setDice(std::make_shared<MockDice>(1, 2));
+        game.playTurn();
+        CHECK_FALSE(alice->isInJail());
+        CHECK(alice->getPosition() == 13);
+        CHECK(alice->getMoney() == 1500 - kJailFee - 140);  // Fee, then States Avenue
+    }
+
+    SUBCASE("Doubles get out without another turn") {
+        game.setDice(std::make_shared<MockDice>(2, 2));
+        game.playTurn();
+        CHECK_FALSE(alice->isInJail());
+        CHECK(alice->getPosition() == 14);
+        CHECK(game.getCurrentPlayer() == bob);
+        CHECK(game.getDoubleCount() == 0);
+    }
+
+    SUBCASE("A held card is played first") {
+        alice->receiveGetOutOfJailCard();
+        game.setDice(std::make_shared<MockDice>(1, 2));
+        game.playTurn();
+        CHECK_FALSE(alice->isInJail());
+        CHECK_FALSE(alice->hasGetOutOfJailFreeCard());
+        CHECK(alice->getPosition() == 13);
+    }
+
+    SUBCASE("Policies are per seat") {
+        PayPolicy pay;
+        game.setJailPolicy(0, &pay);
+        game.setDice(std::make_shared<MockDice>(1, 2));
+        game.playTurn();
+        CHECK_FALSE(alice->isInJail());
+        CHECK(alice->getPosition() == 13);
+        CHECK(alice->getMoney() == 1500 - kJailFee - 140);
+    }
+
+    SUBCASE("Going to jail on doubles ends the turn") {
+        alice->releaseFromJail();
+        alice->setPosition(26);
+        game.setDice(std::make_shared<MockDice>(2, 2));
+        game.playTurn();
+        CHECK(alice->isInJail());
+        CHECK(game.getCurrentPlayer() == bob);
+    }
+
+    SUBCASE("The landing model follows the same table") {
+        LandingModel rolling(game.getBoard(), game.getChanceDeck(), game.getCommunityChestDeck());
+        LandingModel paying(game.getBoard(), game.getChanceDeck(), game.getCommunityChestDeck(), JailAction::Pay);
+        CHECK(rolling.inJail() > paying.inJail());
+        CHECK(paying.inJail() > 0.0);  // Sent there, then straight out
+        CHECK(rolling.probability(10) > paying.probability(10));
+    }
+}
+
+TEST_CASE("Property payback from landing probabilities") {
+    auto alice = std::make_shared<Player>("Alice", 1500);
+    auto bob = std::make_shared<Player>("Bob", 1500);
+    Game game({alice, bob}, Board::create());
+    LandingModel model(game.getBoard(), game.getChanceDeck(), game.getCommunityChestDeck());
+    PropertyRoi roi(game.getBoard(), model);
+
+    const StreetRoi& bare = roi.at(39, 0);  // Boardwalk: $400, $50 rent
+    CHECK(bare.income == doctest::Approx(model.probability(39) * 50));
+    CHECK(bare.invested == 400);
+    CHECK(bare.breakEven == doctest::Approx(400 / bare.income));
+    CHECK(roi.at(39, 5).income == doctest::Approx(32 * bare.income));
+    CHECK(roi.at(39, 5).invested == 400 + 4 * 400 + 100);
+    CHECK(roi.at(39, 5).stepBreakEven == doctest::Approx(100 / (roi.at(39, 5).income - roi.at(39, 4).income)));
+    for (int level = 1; level < kBuildLevels; ++level) {
+        CHECK(roi.at(39, level).breakEven <= roi.at(39, level - 1).breakEven);  // Rent doubles, the outlay grows slower
+    }
+
+    CHECK(std::isinf(roi.at(0, 0).breakEven));   // Go is not a street
+    CHECK(std::isinf(roi.nextBuildRounds(39, 5, 3)));
+    CHECK(roi.nextBuildRounds(39, 0, 3) == doctest::Approx(roi.at(39, 1).stepBreakEven / 3));
+    CHECK(roi.breakEvenRounds(39, 2, 2) == doctest::Approx(roi.at(39, 2).breakEven / 2));
+
+    // Cached per game
+    const PropertyRoi& cached = game.getPropertyRoi();
+    CHECK(&cached == &game.getPropertyRoi());
+    CHECK(cached.at(39, 3).income == doctest::Approx(roi.at(39, 3).income));
+}
+
+TEST_CASE("Endgame solver for two players") {
+    auto board = Board::create();
+    EndgameOptions options;
+    options.cashBuckets = 4;
+    options.horizon = 12;
+    options.rollouts = 200;
+    options.rolloutRounds = 500;
+    EndgameSolver solver(*board, options);
+
+    // Seat 0 has hotels on the oranges, seat 1 is nearly broke
+    GameState state;
+    state.seatCount = 2;
+    state.currentSeat = 1;
+    state.seats[0].money = 1500;
+    state.seats[1].money = 300;
+    for (int tile : {16, 18, 19}) {
+        state.tiles[tile].owner = 0;
+        state.tiles[tile].hotel = true;
+    }
+
+    EndgameEstimate model = solver.solveModel(state);
+    REQUIRE(model.valid);
+    CHECK(model.seats[0] == 0);
+    CHECK(model.seats[1] == 1);
+    CHECK_FALSE(model.rolledOut);
+    CHECK(model.decided > 0.0);
+    CHECK(model.win[0] > 0.95);
+    CHECK(model.win[0] + model.win[1] == doctest::Approx(1.0));
+
+    EndgameEstimate rollouts = solver.rollOut(state);
+    CHECK(rollouts.rolledOut);
+    CHECK(rollouts.win[0] == doctest::Approx(model.win[0]).epsilon(0.05));
+
+    // Rollouts are seeded one by one, so the thread count does not change them
+    EndgameOptions threaded = options;
+    threaded.threads = 3;
+    EndgameEstimate split = EndgameSolver(*board, threaded).rollOut(state);
+    CHECK(split.win[0] == rollouts.win[0]);
+    CHECK(split.decided == rollouts.decided);
+
+    // The same position with the seats swapped favours seat 1
+    GameState swapped = state;
+    std::swap(swapped.seats[0], swapped.seats[1]);
+    for (int tile : {16, 18, 19}) swapped.tiles[tile].owner = 1;
+    swapped.currentSeat = 0;
+    CHECK(solver.solveModel(swapped).win[1] == doctest::Approx(model.win[0]).epsilon(1e-3));
+
+    // Nothing owned: no way to go broke, so the estimate falls back to the cash split
+    GameState even;
+    even.seatCount = 2;
+    even.seats[0].money = 1500;
+    even.seats[1].money = 1500;
+    EndgameEstimate undecided = solver.analyze(even);
+    CHECK(undecided.decided == doctest::Approx(0.0));
+    CHECK(undecided.win[0] == doctest::Approx(0.5));
+
+    // Only two seats in play
+    GameState three = even;
+    three.seatCount = 3;
+    three.seats[2].money = 1500;
+    CHECK_FALSE(solver.analyze(three).valid);
+    three.seats[1].flags = SeatState::Bankrupt;
+    CHECK(solver.analyze(three).seats[1] == 2);
+
+    // Jail follows jail::kSteps: short of the fee, seat 1 is out on the third miss unless a double
+    // gets them out first, (5/6)^3 of the time
+    GameState jailed;
+    jailed.seatCount = 2;
+    jailed.currentSeat = 1;
+    jailed.seats[0].money = 100000;
+    jailed.seats[1].money = 40;
+    jailed.seats[1].position = 10;
+    jailed.seats[1].flags = SeatState::InJail;
+    jailed.tiles[39].owner = 1;  // Boardwalk: mortgaging it would raise $200, enough for the fee
+    EndgameOptions cashOnly = options;
+    cashOnly.raisesCash = false;
+    EndgameSolver cashSolver(*board, cashOnly);
+    EndgameEstimate stuck = cashSolver.solveModel(jailed);
+    CHECK(stuck.win[0] == doctest::Approx(1.0));
+    CHECK(stuck.decided > 0.57);
+    EndgameEstimate stuckRollouts = cashSolver.rollOut(jailed);
+    CHECK(stuckRollouts.win[0] == doctest::Approx(1.0));
+    CHECK(stuckRollouts.decided == doctest::Approx(stuck.decided).epsilon(0.15));
+
+    // Counting what Boardwalk would raise, the fee gets paid and the game goes on longer
+    EndgameEstimate raising = solver.rollOut(jailed);
+    CHECK(raising.decided < stuckRollouts.decided - 0.3);
+
+    // Batch early termination: with no confidence needed, every game reaching the check ends there,
+    // credited to the favourite
+    EndgameCutoff cutoff;
+    cutoff.afterRolls = 60;
+    cutoff.confidence = 0.0;
+    cutoff.options.rolloutRounds = 200;
+    SimStats full = runScalarGames(1, 6, 2, 1000);
+    SimStats cut = runScalarGames(1, 6, 2, 1000, nullptr, nullptr, &cutoff);
+    CHECK(cut.finishedGames == 6);
+    CHECK(cut.meanRolls() < full.meanRolls());
+    CHECK(cut.meanRolls() <= 60 + 3);
+
+    BatchConfig config;
+    config.totalGames = 3;
+    config.endgame = cutoff;
+    CHECK_THROWS_AS(BatchRunner{config}, std::invalid_argument);  // Lockstep engine
+    config.engine = SimEngine::Scalar;
+    BatchRunner runner(config);
+    CHECK(runner.run());
+    CHECK(runner.getStats().games == 3);
+}
+
+TEST_CASE("Tables of up to sixteen players") {
+    std::vector<std::shared_ptr<Player>> seats;
+    for (int i = 0; i < kMaxSimPlayers; ++i) seats.push_back(std::make_shared<Player>("Seat " + std::to_string(i + 1), 1500));
+    Game game(seats, Board::create());
+
+    // The classic four colours first, then every seat its own
+    CHECK(seats[0]->color == sf::Color::Red);
+    CHECK(seats[3]->color == sf::Color::Yellow);
+    for (int i = 0; i < kMaxSimPlayers; ++i) {
+        for (int j = 0; j < i; ++j) {
+            CHECK(seats[i]->color != seats[j]->color);
+        }
+    }
+
+    // A lone token keeps its place; a full table packs into the tile without overlaps
+    Game::TokenSlot lone = Game::tokenSlot(0, 1);
+    CHECK(lone.offset.x == 0.0f);
+    CHECK(lone.offset.y == 0.0f);
+    CHECK(lone.radius == 10.0f);
+    for (int i = 0; i < kMaxSimPlayers; ++i) {
+        Game::TokenSlot a = Game::tokenSlot(i, kMaxSimPlayers);
+        CHECK(std::abs(a.offset.x) + a.radius <= 22.0f);
+        CHECK(std::abs(a.offset.y) + a.radius <= 22.0f);
+        for (int j = 0; j < i; ++j) {
+            Game::TokenSlot b = Game::tokenSlot(j, kMaxSimPlayers);
+            CHECK(std::hypot(a.offset.x - b.offset.x, a.offset.y - b.offset.y) >= a.radius + b.radius);
+        }
+    }
+
+    // The full table plays, and its state reaches spectators and the server
+    QuietOutput quiet;
+    game.seed(5);
+    for (int turn = 0; turn < 200; ++turn) game.playTurn();
+    GameState state = GameState::capture(game);
+    CHECK(state.seatCount == kMaxSimPlayers);
+    StateMirror mirror;
+    std::vector<uint8_t> update;
+    StateEncoder encoder;
+    encoder.encodeTurn(game, update);
+    REQUIRE(mirror.apply(update.data(), update.size()));
+    CHECK(mirror.state() == state);
+
+    TableHost host(1);
+    protocol::Request create;
+    create.op = protocol::Op::CreateTable;
+    create.seat = protocol::kMaxSeats;
+    protocol::Response created = host.handle(create);
+    REQUIRE(created.status == protocol::ReplyStatus::Ok);
+    std::vector<uint8_t> bytes;
+    protocol::encode(created, bytes);
+    protocol::Response decoded;
+    REQUIRE(protocol::decode(bytes.data(), bytes.size(), decoded) == bytes.size());
+    CHECK(decoded.seatCount == protocol::kMaxSeats);
+    CHECK(decoded.seats[protocol::kMaxSeats - 1].money == 1500);
+
+    // Past four seats the lockstep engine reads seats by index; it still plays by the scalar rules
+    auto board = Board::create();
+    LockstepSimulator simulator(*board, 8, 400);
+    SimStats lockstep = simulator.run(1, 320);
+    SimStats scalar = runScalarGames(1, 80, 8, 400);
+    long long wins = 0;
+    for (long long seatWins : lockstep.wins) wins += seatWins;
+    CHECK(wins == lockstep.finishedGames);
+    for (int tile = 0; tile < kBoardTiles; ++tile) {
+        CHECK(std::abs(lockstep.landingFrequency(tile) - scalar.landingFrequency(tile)) < 0.005);
+    }
+    CHECK(std::abs(lockstep.meanRolls() - scalar.meanRolls()) < 0.1 * scalar.meanRolls());
+}
+
+TEST_CASE("Board nearest-tile tables") {
+    auto board = Board::create();
+
+    CHECK(board->getTileKind(0) == TileKind::Go);
+    CHECK(board->getTileKind(12) == TileKind::Utility);
+    CHECK(board->getTileKind(36) == TileKind::Chance);
+
+    const NextTile& railroad = board->nextTile(36, TileKind::Railroad);
+    CHECK(railroad.index == 5);
+    CHECK(railroad.distance == 9);
+    CHECK(railroad.passesGo);
+
+    const NextTile& utility = board->nextTile(12, TileKind::Utility);
+    CHECK(utility.index == 28);
+    CHECK(utility.distance == 16);
+    CHECK_FALSE(utility.passesGo);
+
+    CHECK(board->nextTile(7, TileKind::Jail).index == 10);
+    CHECK(board->nextTile(29, TileKind::Utility).index == 12);
+
+    // Tables follow changes to the board
+    board->removeTile(12);
+    CHECK(board->nextTile(7, TileKind::Utility).index == 27);  // Water Works moved down one place
+}
+
+TEST_CASE("Chance tiles share one deck per game") {
+    auto player = std::make_shared<Player>("Player 1", 1500);
+    auto other = std::make_shared<Player>("Player 2", 1500);
+    Game game({player, other}, Board::create());
+    game.seed(3);
+
+    // Drawing from all three Chance tiles walks a single deck
+    DeckState before = game.getChanceDeck().state();
+    for (int tile : {7, 22, 36}) {
+        player->setPosition(tile);
+        game.getTile(tile)->onLand(player, game);
+    }
+    CHECK(game.getChanceDeck().state().cursor == before.cursor + 3);
+
+    // A seeded game replays exactly
+    SimStats first = runScalarGames(5, 20, 2, 300);
+    SimStats second = runScalarGames(5, 20, 2, 300);
+    CHECK(first.landings == second.landings);
+    CHECK(first.totalRolls == second.totalRolls);
+}
+
+TEST_CASE("Tile counters record landings, purchases, rent and card draws") {
+    auto player1 = std::make_shared<Player>("Alice", 1500);
+    auto player2 = std::make_shared<Player>("Bob", 1500);
+    Game game({player1, player2}, Board::create());
+
+    game.setDice(std::make_shared<MockDice>(2, 3));  // Alice buys Reading Railroad
+    game.playTurn();
+    game.setDice(std::make_shared<MockDice>(2, 3));  // Bob pays her rent
+    game.playTurn();
+
+    const TileCounts& counts = game.getTileCounts();
+    CHECK(counts.landings[5] == 2);
+    CHECK(counts.purchases[5] == 1);
+    CHECK(counts.rentCollected[5] == 50);
+    CHECK(counts.maxValue(TileMetric::Landings) == 2);
+
+    player1->setPosition(7);  // Alice draws a Chance card
+    game.getTile(7)->onLand(player1, game);
+    CHECK(counts.cardDraws[7] == 1);
+}
+
+TEST_CASE("Tile heatmap aggregates games across threads") {
+    TileCounts game;
+    game.recordLanding(12);
+    game.recordPurchase(12);
+    game.recordRent(12, 40);
+    game.recordCardDraw(36);
+
+    TileHeatmap heatmap;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) heatmap.add(game);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    TileCounts total = heatmap.snapshot();
+    CHECK(total.landings[12] == 4000);
+    CHECK(total.purchases[12] == 4000);
+    CHECK(total.rentCollected[12] == 160000);
+    CHECK(total.cardDraws[36] == 4000);
+    CHECK(total.landings[0] == 0);
+
+    // Simulated games feed the same landings into the heatmap as into their summaries
+    heatmap.reset();
+    SimStats stats = runScalarGames(1, 50, 2, 500, &heatmap);
+    total = heatmap.snapshot();
+    for (int tile = 0; tile < kBoardTiles; ++tile) {
+        CHECK(total.landings[tile] == stats.landings[tile]);
+    }
+    CHECK(total.maxValue(TileMetric::RentCollected) > 0);
+}
+
+#ifdef MONOPOLY_PROFILE
+TEST_CASE("Profiler records turn phases as folded stacks") {
+    auto player1 = std::make_shared<Player>("Alice", 1500);
+    auto player2 = std::make_shared<Player>("Bob", 1500);
+    Game game({player1, player2}, Board::create());
+
+    game.setDice(std::make_shared<MockDice>(2, 3));  // Lands on Reading Railroad
+    game.playTurn();
+
+    std::ostringstream folded;
+    profiler::writeFoldedStacks(folded);
+    CHECK(folded.str().find("playTurn;rollDice ") != std::string::npos);
+    CHECK(folded.str().find("playTurn;onLand:Railroad ") != std::string::npos);
+}
+#endif
+
 // Test cases for Board class
 TEST_CASE("Board class tests") {    
     Board& board = Board::getInstance();
@@ -3,6 +3,13 @@
 
 #include <string>
 #include <memory>
+#include <cstdint>
+
+// What a tile does, for table lookups (Board::getTileKind, Board::nextTile)
+enum class TileKind : int8_t {
+    Go, Street, Railroad, Utility, Tax, Chance, CommunityChest, Jail, GoToJail, FreeParking, Other
+};
+constexpr int kTileKindCount = 11;
 
 // Forward declare Player to avoid circular dependency
 class Player;
@@ -13,17 +20,22 @@ protected:
     std::string name;
     std::string tileType;
     std::shared_ptr<Player> owner;
+    bool mortgaged = false;   // Properties only: a mortgaged tile charges no rent
 
 public:
     Tile(const std::string& name, const std::string& type) : name(name), tileType(type), owner(nullptr) {}
 
-    std::string getName() const { return name; }
+    const std::string& getName() const { return name; }
     std::string getTileType() const { return tileType; }
 
     bool isOccupied() const { return owner != nullptr; }
     void setOwner(std::shared_ptr<Player> newOwner) { owner = newOwner; }
     std::shared_ptr<Player> getOwner() const {return owner; }
 
+    // Set through Player::mortgage and Player::unmortgage, which keep the owner's accounts
+    bool isMortgaged() const { return mortgaged; }
+    void setMortgaged(bool value) { mortgaged = value; }
+
     virtual void onLand(std::shared_ptr<Player> player, Game& game) = 0; // Pure virtual function
 
     virtual ~Tile() = default; //Destructor
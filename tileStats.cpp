@@ -0,0 +1,70 @@
+#include "tileStats.hpp"
+#include <algorithm>
+
+long long TileCounts::value(TileMetric metric, int tile) const {
+    if (!inRange(tile)) return 0;
+    switch (metric) {
+        case TileMetric::Landings: return landings[tile];
+        case TileMetric::Purchases: return purchases[tile];
+        case TileMetric::RentCollected: return rentCollected[tile];
+        case TileMetric::CardDraws: return cardDraws[tile];
+    }
+    return 0;
+}
+
+long long TileCounts::maxValue(TileMetric metric) const {
+    long long highest = 0;
+    for (int t = 0; t < kBoardTiles; ++t) {
+        highest = std::max(highest, value(metric, t));
+    }
+    return highest;
+}
+
+void TileCounts::merge(const TileCounts& other) {
+    for (int t = 0; t < kBoardTiles; ++t) {
+        landings[t] += other.landings[t];
+        purchases[t] += other.purchases[t];
+        rentCollected[t] += other.rentCollected[t];
+        cardDraws[t] += other.cardDraws[t];
+    }
+}
+
+void TileHeatmap::add(const TileCounts& counts) {
+    for (int t = 0; t < kBoardTiles; ++t) {
+        // Zero rows are common (most tiles never see a card draw); skip their atomics
+        if (counts.landings[t]) rows[t].landings.fetch_add(counts.landings[t], std::memory_order_relaxed);
+        if (counts.purchases[t]) rows[t].purchases.fetch_add(counts.purchases[t], std::memory_order_relaxed);
+        if (counts.rentCollected[t]) rows[t].rentCollected.fetch_add(counts.rentCollected[t], std::memory_order_relaxed);
+        if (counts.cardDraws[t]) rows[t].cardDraws.fetch_add(counts.cardDraws[t], std::memory_order_relaxed);
+    }
+}
+
+TileCounts TileHeatmap::snapshot() const {
+    TileCounts counts;
+    for (int t = 0; t < kBoardTiles; ++t) {
+        counts.landings[t] = rows[t].landings.load(std::memory_order_relaxed);
+        counts.purchases[t] = rows[t].purchases.load(std::memory_order_relaxed);
+        counts.rentCollected[t] = rows[t].rentCollected.load(std::memory_order_relaxed);
+        counts.cardDraws[t] = rows[t].cardDraws.load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+void TileHeatmap::reset() {
+    for (auto& row : rows) {
+        row.landings.store(0, std::memory_order_relaxed);
+        row.purchases.store(0, std::memory_order_relaxed);
+        row.rentCollected.store(0, std::memory_order_relaxed);
+        row.cardDraws.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* tileMetricName(TileMetric metric) {
+    switch (metric) {
+        case TileMetric::Landings: return "landings";
+        case TileMetric::Purchases: return "purchases";
+        case TileMetric::RentCollected: return "rent collected";
+        case TileMetric::CardDraws: return "card draws";
+    }
+    return "";
+}
@@ -0,0 +1,58 @@
+#ifndef TILE_STATS_HPP
+#define TILE_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include "simulation.hpp"
+
+// Per-tile quantities the heatmap can show
+enum class TileMetric { Landings, Purchases, RentCollected, CardDraws };
+
+// Per-tile counters of one game. A game runs on one thread, so recording is a plain add.
+struct TileCounts {
+    std::array<long long, kBoardTiles> landings{};
+    std::array<long long, kBoardTiles> purchases{};
+    std::array<long long, kBoardTiles> rentCollected{};  // Dollars of rent paid on the tile
+    std::array<long long, kBoardTiles> cardDraws{};      // Chance / Community Chest cards drawn on the tile
+
+    void recordLanding(int tile) { if (inRange(tile)) landings[tile]++; }
+    void recordPurchase(int tile) { if (inRange(tile)) purchases[tile]++; }
+    void recordRent(int tile, int amount) { if (inRange(tile)) rentCollected[tile] += amount; }
+    void recordCardDraw(int tile) { if (inRange(tile)) cardDraws[tile]++; }
+
+    long long value(TileMetric metric, int tile) const;
+
+    // Largest value of a metric over the board (heatmap scale)
+    long long maxValue(TileMetric metric) const;
+
+    void merge(const TileCounts& other);
+
+private:
+    static bool inRange(int tile) { return tile >= 0 && tile < kBoardTiles; }
+};
+
+// Totals over any number of games and threads. Games fold their counts in once when they end,
+// with relaxed atomic adds, so writers never wait on each other and turns never touch shared memory.
+class TileHeatmap {
+private:
+    // One cache line per tile so threads adding different tiles don't contend
+    struct alignas(64) Row {
+        std::atomic<long long> landings{0};
+        std::atomic<long long> purchases{0};
+        std::atomic<long long> rentCollected{0};
+        std::atomic<long long> cardDraws{0};
+    };
+    std::array<Row, kBoardTiles> rows;
+
+public:
+    void add(const TileCounts& counts);
+
+    // Current totals; exact once all writers have finished
+    TileCounts snapshot() const;
+
+    void reset();
+};
+
+const char* tileMetricName(TileMetric metric);
+
+#endif // TILE_STATS_HPP
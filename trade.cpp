@@ -0,0 +1,240 @@
+#include "trade.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool isProperty(TileKind kind) {
+    return kind == TileKind::Street || kind == TileKind::Railroad || kind == TileKind::Utility;
+}
+
+bool inPlay(const Game& game, int seat) {
+    const auto& seats = game.getSeats();
+    if (seat < 0 || seat >= static_cast<int>(seats.size())) return false;
+    const auto& players = game.getPlayers();
+    return std::find(players.begin(), players.end(), seats[seat]) != players.end();
+}
+
+// Every tile of `tiles` is a property owned by `seat`, and no street of a traded street's colour group
+// has buildings (they would be left standing on a group the owner no longer holds)
+TradeError checkTiles(const Game& game, int seat, uint64_t tiles) {
+    const Board& board = game.getBoard();
+    const Player* player = game.getSeats()[seat].get();
+    for (int t = 0; t < 64; ++t) {
+        if (!(tiles & (1ULL << t))) continue;
+        if (t >= board.getTileCount() || !isProperty(board.getTileKind(t))) return TradeError::NotOwned;
+        auto tile = board.getTile(t);
+        if (tile->getOwner().get() != player) return TradeError::NotOwned;
+        if (auto street = std::dynamic_pointer_cast<StreetTile>(tile)) {
+            for (const StreetTile* member : board.getColorGroupProperties(street->getColorGroup())) {
+                if (member->getHouseCount() > 0 || member->isHotelBuilt()) return TradeError::HasBuildings;
+            }
+        }
+    }
+    return TradeError::None;
+}
+
+void moveTiles(Game& game, uint64_t tiles, const std::shared_ptr<Player>& from, const std::shared_ptr<Player>& to) {
+    const Board& board = game.getBoard();
+    for (int t = 0; t < board.getTileCount() && t < 64; ++t) {
+        if (!(tiles & (1ULL << t))) continue;
+        auto tile = board.getTile(t);
+        from->releaseProperty(tile);
+        to->acquireProperty(tile);
+        tile->setOwner(to);
+    }
+}
+
+int roundUp(double amount) {
+    return static_cast<int>(std::ceil(amount / kAuctionIncrement)) * kAuctionIncrement;
+}
+
+int roundDown(double amount) {
+    return static_cast<int>(std::floor(amount / kAuctionIncrement)) * kAuctionIncrement;
+}
+
+} // namespace
+
+namespace trade {
+
+const char* describe(TradeError error) {
+    switch (error) {
+        case TradeError::None: return "ok";
+        case TradeError::Empty: return "nothing changes hands";
+        case TradeError::BadSeat: return "both seats must be different players still in the game";
+        case TradeError::NotOwned: return "a property is not owned by the player giving it";
+        case TradeError::HasBuildings: return "streets of a colour group with buildings cannot be traded";
+        case TradeError::NotEnoughCash: return "a player does not have that much cash";
+        case TradeError::NoJailCard: return "a player has no Get Out of Jail Free card";
+    }
+    return "unknown";
+}
+
+TradeError validate(const Game& game, const TradeOffer& offer) {
+    if (offer.isEmpty()) return TradeError::Empty;
+    if (offer.fromSeat == offer.toSeat || !inPlay(game, offer.fromSeat) || !inPlay(game, offer.toSeat)) {
+        return TradeError::BadSeat;
+    }
+    const Player& from = *game.getSeats()[offer.fromSeat];
+    const Player& to = *game.getSeats()[offer.toSeat];
+    if (offer.giveCash < 0 || offer.takeCash < 0 || offer.giveCash > from.getMoney() || offer.takeCash > to.getMoney()) {
+        return TradeError::NotEnoughCash;
+    }
+    if ((offer.giveJailCard && !from.hasGetOutOfJailFreeCard()) || (offer.takeJailCard && !to.hasGetOutOfJailFreeCard())) {
+        return TradeError::NoJailCard;
+    }
+    TradeError error = checkTiles(game, offer.fromSeat, offer.giveTiles);
+    return error != TradeError::None ? error : checkTiles(game, offer.toSeat, offer.takeTiles);
+}
+
+TradeError apply(Game& game, const TradeOffer& offer) {
+    TradeError error = validate(game, offer);
+    if (error != TradeError::None) return error;
+
+    // Nothing below can fail
+    const auto& from = game.getSeats()[offer.fromSeat];
+    const auto& to = game.getSeats()[offer.toSeat];
+    moveTiles(game, offer.giveTiles, from, to);
+    moveTiles(game, offer.takeTiles, to, from);
+    from->adjustMoney(offer.takeCash - offer.giveCash);
+    to->adjustMoney(offer.giveCash - offer.takeCash);
+    // Both cards leave their holders before either is handed over, so a swap keeps one each
+    DeckKind given = offer.giveJailCard ? from->useGetOutOfJailCard() : DeckKind::Chance;
+    DeckKind taken = offer.takeJailCard ? to->useGetOutOfJailCard() : DeckKind::Chance;
+    if (offer.giveJailCard) to->receiveGetOutOfJailCard(given);
+    if (offer.takeJailCard) from->receiveGetOutOfJailCard(taken);
+    LOG_INFO(from->getName() << " and " << to->getName() << " complete a trade.");
+    return TradeError::None;
+}
+
+} // namespace trade
+
+TradeEvaluator::TradeEvaluator(const LandingModel& model) {
+    for (int t = 0; t < kBoardTiles; ++t) {
+        landing[t] = model.probability(t);
+    }
+}
+
+void TradeEvaluator::load(const Game& game) {
+    const Board& board = game.getBoard();
+    const auto& seats = game.getSeats();
+    rent.fill(0.0);
+    owned.fill(0);
+    cash.fill(0);
+    playing.fill(false);
+    utilities = 0;
+    tradable = 0;
+    mortgaged = 0;
+    std::vector<std::string> builtGroups;  // Colour groups with buildings: none of their streets trade
+
+    for (int t = 0; t < board.getTileCount() && t < kBoardTiles; ++t) {
+        TileKind kind = board.getTileKind(t);
+        if (!isProperty(kind)) continue;
+        auto tile = board.getTile(t);
+        uint64_t bit = 1ULL << t;
+        tradable |= bit;
+        if (tile->isMortgaged()) mortgaged |= bit;
+        if (kind == TileKind::Utility) {
+            utilities |= bit;
+        } else if (auto street = std::dynamic_pointer_cast<StreetTile>(tile)) {
+            rent[t] = street->calculateRent();
+            if (street->getHouseCount() > 0 || street->isHotelBuilt()) builtGroups.push_back(street->getColorGroup());
+        } else if (auto railroad = std::dynamic_pointer_cast<RailroadTile>(tile)) {
+            rent[t] = railroad->calculateRent();
+        }
+        for (size_t seat = 0; seat < seats.size() && seat < kMaxSeats; ++seat) {
+            if (tile->getOwner() == seats[seat]) owned[seat] |= bit;
+        }
+    }
+    for (int t = 0; t < board.getTileCount() && t < kBoardTiles && !builtGroups.empty(); ++t) {
+        if (board.getTileKind(t) != TileKind::Street) continue;
+        const auto& street = static_cast<const StreetTile&>(*board.getTile(t));
+        if (std::find(builtGroups.begin(), builtGroups.end(), street.getColorGroup()) != builtGroups.end()) {
+            tradable &= ~(1ULL << t);
+        }
+    }
+    for (size_t seat = 0; seat < seats.size() && seat < kMaxSeats; ++seat) {
+        cash[seat] = seats[seat]->getMoney();
+        playing[seat] = inPlay(game, static_cast<int>(seat));
+    }
+    opponents = std::max(0, static_cast<int>(game.getPlayers().size()) - 1);
+}
+
+double TradeEvaluator::income(uint64_t tiles) const {
+    double expected = 0.0;
+    for (uint64_t rest = tiles & ~utilities & ~mortgaged; rest; rest &= rest - 1) {
+        int t = __builtin_ctzll(rest);
+        expected += landing[t] * rent[t];
+    }
+    uint64_t ownedUtilities = tiles & utilities;
+    if (ownedUtilities) {
+        int multiplier = __builtin_popcountll(ownedUtilities) >= 2 ? 10 : 4;
+        for (uint64_t rest = ownedUtilities & ~mortgaged; rest; rest &= rest - 1) {
+            expected += landing[__builtin_ctzll(rest)] * multiplier * 7.0;
+        }
+    }
+    return expected * opponents;
+}
+
+double TradeEvaluator::seatIncome(int seat) const {
+    return seat >= 0 && seat < kMaxSeats ? income(owned[seat]) : 0.0;
+}
+
+TradeScore TradeEvaluator::score(const TradeOffer& offer) const {
+    TradeScore result;
+    if (offer.fromSeat < 0 || offer.fromSeat >= kMaxSeats || offer.toSeat < 0 || offer.toSeat >= kMaxSeats) return result;
+    uint64_t from = owned[offer.fromSeat];
+    uint64_t to = owned[offer.toSeat];
+    uint64_t fromAfter = (from & ~offer.giveTiles) | offer.takeTiles;
+    uint64_t toAfter = (to & ~offer.takeTiles) | offer.giveTiles;
+    result.incomeChange[0] = income(fromAfter) - income(from);
+    result.incomeChange[1] = income(toAfter) - income(to);
+
+    int cards = (offer.takeJailCard ? kJailCardValue : 0) - (offer.giveJailCard ? kJailCardValue : 0);
+    result.cashChange[0] = offer.takeCash - offer.giveCash + cards;
+    result.cashChange[1] = -result.cashChange[0];
+    return result;
+}
+
+TradeOffer TradeEvaluator::bestOffer(int fromSeat, int toSeat, double rounds) const {
+    TradeOffer best;
+    if (fromSeat < 0 || fromSeat >= kMaxSeats || toSeat < 0 || toSeat >= kMaxSeats || fromSeat == toSeat ||
+        !playing[fromSeat] || !playing[toSeat]) {
+        return best;
+    }
+    double bestGain = 0.0;
+    uint64_t mine = owned[fromSeat] & tradable;
+    uint64_t theirs = owned[toSeat] & tradable;
+
+    TradeOffer offer;
+    offer.fromSeat = fromSeat;
+    offer.toSeat = toSeat;
+    for (uint64_t wanted = theirs; wanted; wanted &= wanted - 1) {
+        offer.takeTiles = wanted & (~wanted + 1);
+        // Each of fromSeat's properties in turn, then none at all (a cash purchase)
+        for (uint64_t offered = mine;; offered &= offered - 1) {
+            offer.giveTiles = offered & (~offered + 1);
+            offer.giveCash = 0;
+            offer.takeCash = 0;
+            TradeScore score = this->score(offer);
+
+            // Settle in cash, in bidding steps, so toSeat at least breaks even
+            double theirNet = score.net(1, rounds);
+            if (theirNet < 0) {
+                offer.giveCash = roundUp(-theirNet);
+            } else {
+                offer.takeCash = std::min(roundDown(theirNet), cash[toSeat]);
+            }
+            double gain = score.net(0, rounds) + offer.takeCash - offer.giveCash;
+            if (offer.giveCash <= cash[fromSeat] && gain > bestGain) {
+                bestGain = gain;
+                best = offer;
+            }
+            if (!offered) break;
+        }
+    }
+    return best;
+}
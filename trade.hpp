@@ -0,0 +1,100 @@
+#ifndef TRADE_HPP
+#define TRADE_HPP
+
+#include <array>
+#include <cstdint>
+#include "landingModel.hpp"
+#include "simulation.hpp"
+
+class Game;
+
+// A trade between two seats. Properties are bit masks over board positions (bit t = tile t), so an
+// offer is plain data that bots can build and score by the thousand without allocating.
+struct TradeOffer {
+    int fromSeat = -1;
+    int toSeat = -1;
+    uint64_t giveTiles = 0;     // fromSeat's properties that go to toSeat
+    uint64_t takeTiles = 0;     // toSeat's properties that go to fromSeat
+    int giveCash = 0;           // Paid by fromSeat to toSeat
+    int takeCash = 0;           // Paid by toSeat to fromSeat
+    bool giveJailCard = false;  // fromSeat hands over a Get Out of Jail Free card
+    bool takeJailCard = false;
+
+    bool isEmpty() const {
+        return giveTiles == 0 && takeTiles == 0 && giveCash == 0 && takeCash == 0 && !giveJailCard && !takeJailCard;
+    }
+};
+
+enum class TradeError : uint8_t {
+    None,
+    Empty,           // Nothing changes hands
+    BadSeat,         // A seat is out of range, bankrupt, or both seats are the same
+    NotOwned,        // A property is not owned by the seat giving it (or is not a property)
+    HasBuildings,    // Streets cannot be traded while their colour group has houses or a hotel
+    NotEnoughCash,   // Negative amounts, or more than a seat holds
+    NoJailCard       // A Get Out of Jail Free card the seat does not hold
+};
+
+namespace trade {
+
+const char* describe(TradeError error);
+
+// Check an offer against the game without changing anything
+TradeError validate(const Game& game, const TradeOffer& offer);
+
+// Validate, then move every property, card and dollar of the offer. Everything is checked before
+// anything changes, so an offer is applied completely or not at all.
+TradeError apply(Game& game, const TradeOffer& offer);
+
+} // namespace trade
+
+// The effect of an offer on the two seats: expected rent income per round (one roll by every
+// opponent) and cash, with a held Get Out of Jail Free card counted at the jail fee it saves
+struct TradeScore {
+    std::array<double, 2> incomeChange{};   // [0] fromSeat, [1] toSeat
+    std::array<int, 2> cashChange{};
+
+    // Net gain over `rounds` rounds of play
+    double net(int side, double rounds) const { return incomeChange[side] * rounds + cashChange[side]; }
+};
+
+// Scores offers from a snapshot of the game. Expected income of a seat is, over the tiles it owns,
+// landing probability x rent x number of opponents, with utilities charged at their 4x/10x multiplier
+// on an average roll of 7. After load() scoring is arithmetic on bit masks: no game access and no
+// allocation, so a bot can search thousands of candidate trades per decision.
+class TradeEvaluator {
+private:
+    static constexpr int kMaxSeats = 16;
+
+    std::array<double, kBoardTiles> landing{};
+    std::array<double, kBoardTiles> rent{};   // Current rent of each street and railroad
+    uint64_t utilities = 0;                   // Utility positions
+    uint64_t tradable = 0;                    // Properties outside colour groups with buildings
+    uint64_t mortgaged = 0;                   // Properties that charge no rent
+    std::array<uint64_t, kMaxSeats> owned{};
+    std::array<int, kMaxSeats> cash{};
+    std::array<bool, kMaxSeats> playing{};
+    int opponents = 0;
+
+    double income(uint64_t tiles) const;
+
+public:
+    static constexpr int kJailCardValue = 50;   // The fee a held card saves
+
+    explicit TradeEvaluator(const LandingModel& model);
+
+    // Snapshot ownership, rents and cash; call again after the game moves on
+    void load(const Game& game);
+
+    TradeScore score(const TradeOffer& offer) const;
+
+    // Expected rent income per round of a seat's current properties
+    double seatIncome(int seat) const;
+
+    // The best one-for-one (or cash-for-one) property deal fromSeat can offer toSeat: cash is set so
+    // that toSeat comes out at least even over `rounds`, and fromSeat's own gain is maximised.
+    // An empty offer when no deal leaves fromSeat better off.
+    TradeOffer bestOffer(int fromSeat, int toSeat, double rounds) const;
+};
+
+#endif // TRADE_HPP